@@ -0,0 +1,195 @@
+#!python3
+# Time the scripts in bench/ with a release build of the working tree, and optionally with a second
+# build to compare against:
+#
+#   python3 bench/bench.py [--scalar | --against REVISION] [--repeat N] [NAME ...]
+#
+# --scalar   Compare against the working tree built with UNE_NO_SIMD.
+# --against  Compare against the tree at a git revision.
+# --repeat   Keep the best of N timings (default 5).
+# NAME       Only run the benchmarks whose name starts with NAME.
+#
+# Every script is run with 'runs = 0' and with 'runs = <count>' in front of it. The difference
+# between the two, divided by the count, is reported per run, so building the input is not counted.
+# Scripts that load a file get its path in 'path'. The files are generated in bench/_build on first
+# use, and the rate at which they are loaded is reported too.
+import io
+import os
+import shutil
+import subprocess
+import tarfile
+import time
+from sys import argv, platform
+
+
+def is_win():
+    return platform == 'win32' or platform == 'cygwin' or platform == 'msys'
+
+
+class Bench:
+    def __init__(self, name: str, script: str, preamble: str, runs: int, data: str = None):
+        self.name = name
+        self.script = script
+        self.preamble = preamble
+        self.runs = runs
+        self.data = data
+
+
+# Options
+DIR_BENCH = os.path.dirname(os.path.abspath(__file__))
+DIR_SOURCE = os.path.dirname(DIR_BENCH)
+DIR_BUILD = os.path.join(DIR_BENCH, '_build')
+FILE_SCRIPT = os.path.join(DIR_BUILD, 'bench.une')
+UNE = 'une.exe' if is_win() else 'une'
+REPEAT = 5
+DATA_SIZE = 64 * 1024 * 1024
+
+# Inputs
+WORDS = 'words = "the quick brown fox jumps over the lazy dog "'
+WORDS_WIDE = 'words = "the quick brown fox jumps over the lazy dog € "'
+data = {  # Generated files, made of a line repeated to DATA_SIZE bytes.
+    'ascii.txt': 'the quick brown fox jumps over the lazy dog\n',
+    'latin1.txt': 'the quick brown fox jumps över the lazy dog\n',
+    'mixed.txt': 'the quick brown fox jumps over the lazy dog €\n',
+    'module.une': '\t# the quick brown fox jumps over the lazy dog\r\n',
+}
+
+benches = [
+    Bench('find', 'str_find.une', WORDS, 200),
+    Bench('find wide', 'str_find.une', WORDS_WIDE, 200),
+    Bench('contains', 'str_contains.une', WORDS, 200),
+    Bench('contains wide', 'str_contains.une', WORDS_WIDE, 200),
+    Bench('count', 'str_count.une', WORDS, 100),
+    Bench('count wide', 'str_count.une', WORDS_WIDE, 100),
+    Bench('replace', 'str_replace.une', WORDS, 20),
+    Bench('replace wide', 'str_replace.une', WORDS_WIDE, 20),
+    Bench('replace none', 'str_replace_none.une', WORDS, 100),
+    Bench('replace none wide', 'str_replace_none.une', WORDS_WIDE, 100),
+    Bench('split', 'str_split.une', WORDS, 10),
+    Bench('split wide', 'str_split.une', WORDS_WIDE, 10),
+    Bench('num loop', 'num_loop.une', '', 2000000),
+    Bench('num str int', 'num_str_int.une', '', 2000000),
+    Bench('num str flt', 'num_str_flt.une', '', 2000000),
+    Bench('num int', 'num_int.une', '', 2000000),
+    Bench('num flt', 'num_flt.une', '', 2000000),
+    Bench('file read ascii', 'file_read.une', '', 5, 'ascii.txt'),
+    Bench('file read latin1', 'file_read.une', '', 5, 'latin1.txt'),
+    Bench('file read mixed', 'file_read.une', '', 5, 'mixed.txt'),
+    Bench('file script', 'file_script.une', '', 5, 'module.une'),
+]
+
+
+def build(label: str, source: str, definitions: list[str]):
+    directory = os.path.join(DIR_BUILD, label)
+    print(f'\33[33mBuilding {label}...\33[0m')
+    for command in [['cmake', '-S', source, '-B', directory, '-DCMAKE_BUILD_TYPE=Release', *definitions],
+                    ['cmake', '--build', directory, '-j', str(os.cpu_count())]]:
+        process = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        if process.returncode != 0:
+            print(process.stdout.decode(errors='replace'))
+            print(f'\33[31m\33[1mBuilding {label} failed.\33[0m')
+            exit(1)
+    return os.path.join(directory, UNE)
+
+
+def build_revision(revision: str):
+    label = revision.replace('/', '_')
+    source = os.path.join(DIR_BUILD, f'{label}-source')
+    shutil.rmtree(source, ignore_errors=True)
+    archive = subprocess.run(['git', '-C', DIR_SOURCE, 'archive', revision],
+                             check=True, stdout=subprocess.PIPE).stdout
+    with tarfile.open(fileobj=io.BytesIO(archive)) as tar:
+        tar.extractall(source)
+    # Archives leave submodules empty, so use the working tree's.
+    submodules = subprocess.run(['git', '-C', DIR_SOURCE, 'config', '-f', '.gitmodules', '--get-regexp', 'path'],
+                                stdout=subprocess.PIPE).stdout.decode().split()[1::2]
+    for submodule in submodules:
+        shutil.rmtree(os.path.join(source, submodule), ignore_errors=True)
+        shutil.copytree(os.path.join(DIR_SOURCE, submodule), os.path.join(source, submodule))
+    return label, build(label, source, [])
+
+
+def data_path(name: str):
+    path = os.path.join(DIR_BUILD, name)
+    if not os.path.exists(path):
+        line = data[name].encode()
+        with open(path, 'wb') as file:
+            file.write(line * (DATA_SIZE // len(line)))
+    return path
+
+
+def time_script(une: str, bench: Bench, runs: int):
+    with open(os.path.join(DIR_BENCH, bench.script), encoding='utf-8') as file:
+        script = file.read()
+    preamble = bench.preamble
+    if bench.data:
+        preamble += f'\npath = "{data_path(bench.data).replace(os.sep, "/")}"'
+    with open(FILE_SCRIPT, 'w', encoding='utf-8') as file:
+        file.write(f'runs = {runs}\n{preamble}\n{script}')
+    best = None
+    for _ in range(REPEAT):
+        start = time.perf_counter()
+        process = subprocess.run([une, FILE_SCRIPT], stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        elapsed = time.perf_counter() - start
+        if process.returncode != 0:
+            print(f'\33[31m\33[1m{bench.name} failed:\33[0m')
+            print(process.stdout.decode(errors='replace'))
+            exit(1)
+        best = elapsed if best is None else min(best, elapsed)
+    return best
+
+
+def time_run(une: str, bench: Bench):
+    return max(time_script(une, bench, bench.runs) - time_script(une, bench, 0), 0) / bench.runs
+
+
+def format_time(bench: Bench, seconds: float):
+    if bench.data and seconds:
+        size = os.path.getsize(data_path(bench.data))
+        return f'{seconds * 1e3:.1f} ms ({size / seconds / 1e6:.0f} MB/s)'
+    if seconds < 1e-6:
+        return f'{seconds * 1e9:.1f} ns'
+    if seconds < 1e-3:
+        return f'{seconds * 1e6:.3f} us'
+    return f'{seconds * 1e3:.3f} ms'
+
+
+# Arguments
+args = argv[1:]
+against = None
+names = []
+while args:
+    arg = args.pop(0)
+    if arg == '--scalar':
+        against = 'scalar'
+    elif arg == '--against' and args:
+        against = args.pop(0)
+    elif arg == '--repeat' and args:
+        REPEAT = int(args.pop(0))
+    elif arg.startswith('--'):
+        print(f'Unknown option {arg}.')
+        exit(1)
+    else:
+        names.append(arg)
+selected = [bench for bench in benches if not names or any(bench.name.startswith(name) for name in names)]
+
+os.makedirs(DIR_BUILD, exist_ok=True)
+une = build('current', DIR_SOURCE, ['-DUNE_NO_SIMD=OFF'])
+if against == 'scalar':
+    une_against = build('scalar', DIR_SOURCE, ['-DUNE_NO_SIMD=ON'])
+elif against:
+    against, une_against = build_revision(against)
+
+if against:
+    print(f'{"benchmark":<20}{against:>24}{"current":>24}{"speedup":>10}')
+else:
+    print(f'{"benchmark":<20}{"current":>24}')
+for bench in selected:
+    current = time_run(une, bench)
+    if against:
+        before = time_run(une_against, bench)
+        speedup = f'{before / current:.2f}x' if current else '-'
+        print(f'{bench.name:<20}{format_time(bench, before):>24}{format_time(bench, current):>24}{speedup:>10}')
+    else:
+        print(f'{bench.name:<20}{format_time(bench, current):>24}')
+os.remove(FILE_SCRIPT)
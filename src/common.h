@@ -32,6 +32,12 @@ common.h - Une
 #define UNE_MODULE_NAME_PLACEHOLDER "<string>"
 #define UNE_SWITCH_SCRIPT "-s"
 #define UNE_SWITCH_INTERACTIVE "-i"
+#define UNE_SWITCH_TREE "-t"
+#define UNE_SWITCH_NO_OPTIMIZE "-u"
+#define UNE_SWITCH_DEPTH_LIMIT "-r"
+#define UNE_DEPTH_LIMIT 10000 /* Function calls in progress at once, see -r. */
+#define UNE_STACK_RESERVE (128 * 1024) /* Bytes of C stack left unused by calls. */
+#define UNE_STACK_SIZE_UNLIMITED (8 * 1024 * 1024) /* C stack size assumed without a limit. */
 #define UNE_INTERACTIVE_PREFIX L">>> "
 #define UNE_HEADER L"Une " UNE_VERSION L" (" UNE_VERSION_HASH L")"
 #define UNE_INTERACTIVE_INFO L"Use \"exit\" or CTRL + C to exit."
@@ -45,8 +51,12 @@ common.h - Une
 #define UNE_PRINTF_UNE_INT L"%lld"
 #define UNE_ERROR_OUT_OF_MEMORY L"Out of memory."
 #define UNE_ERROR_USAGE                                                                            \
-    L"Usage: %hs [[<path>|" UNE_SWITCH_SCRIPT L" <string>|" UNE_SWITCH_INTERACTIVE L"]]\n"         \
+    L"Usage: %hs [" UNE_SWITCH_TREE L"] [" UNE_SWITCH_NO_OPTIMIZE L"] [" UNE_SWITCH_DEPTH_LIMIT    \
+        L" <limit>] [[<path>|" UNE_SWITCH_SCRIPT L" <string>|" UNE_SWITCH_INTERACTIVE L"]]\n"      \
     L"\n"                                                                                          \
+    L"\t-t           Interpret the syntax tree instead of compiling to bytecode.\n"                \
+    L"\t-u           Do not optimize the syntax tree.\n"                                           \
+    L"\t-r <limit>   Allow at most <limit> function calls in progress at once.\n"                  \
     L"\t<path>       Execute the file at <path>.\n"                                                \
     L"\t-s <string>  Evaluate <string>.\n"                                                         \
     L"\t-i           Enter interactive mode."
@@ -67,35 +77,57 @@ common.h - Une
 #define UNE_SIZE_NODE_AS_WCS 128000 /* (Debug) Representing. */
 #define UNE_SIZE_TOKEN_AS_WCS 4096 /* (Debug) Representing. */
 #define UNE_SIZE_FGETWS_BUFFER 32767 /* une_native_fn_input. */
-#define UNE_SIZE_NUMBER_AS_STRING (48 + UNE_FLT_PRECISION) /* une_int and une_flt as strings. */
+#define UNE_SIZE_NUMBER_AS_STRING (320 + UNE_FLT_PRECISION) /* une_int and une_flt as strings. */
 #if !defined(UNE_DEBUG) || !defined(UNE_DBG_SIZES)
 #define UNE_SIZE_NUM_LEN 32 /* Lexing. */
 #define UNE_SIZE_STR_LEN 4096 /* Lexing. */
 #define UNE_SIZE_NAME_LEN 32 /* Lexing. */
-#define UNE_SIZE_VARIABLE_BUF 32 /* Context. */
+#define UNE_SIZE_VARIABLE_BUF 8 /* Context. */
 #define UNE_SIZE_FUNCTION_BUF 16 /* Context. */
+#define UNE_SIZE_CONTEXTS 64 /* Interpreter state. */
+#define UNE_SIZE_VM_STACK 1024 /* Executing. */
 #define UNE_SIZE_TOKEN_BUF 4096 /* Lexing. */
 #define UNE_SIZE_SEQUENCE 256 /* Parsing. */
 #define UNE_SIZE_FILE_BUFFER 4096 /* une_file_read. */
 #define UNE_SIZE_BIF_SPLIT_TKS 16 /* une_buitlin_split. */
+#define UNE_SIZE_BIF_REPLACE_MATCHES 16 /* une_native_fn_replace. */
 #define UNE_SIZE_EXPECTED_TRACEBACK_DEPTH 8 /* une_error_display. */
-#define UNE_SIZE_HOLDING 4 /* Interpreter state. */
+#define UNE_SIZE_HOLDING 64 /* Interpreter state. */
 #define UNE_SIZE_CALLABLES 32
 #define UNE_SIZE_MODULES 8
+#define UNE_SIZE_CHUNK_CODE 64 /* Compiling. */
+#define UNE_SIZE_CHUNK_CONSTANTS 16 /* Compiling. */
+#define UNE_SIZE_CHUNK_LOOPS 4 /* Compiling. */
+#define UNE_SIZE_CHUNK_CACHES 4 /* Compiling. */
+#define UNE_SIZE_SLOTS 8 /* Resolving. */
+#define UNE_SIZE_SYMBOLS 64 /* Engine. */
+#define UNE_SIZE_SHAPE_TRANSITIONS 2 /* Objects. */
+#define UNE_SIZE_STR_REPRESENT 256 /* Representing narrow strings. */
 #else
 #define UNE_SIZE_NUM_LEN UNE_DBG_SIZES_SIZE
 #define UNE_SIZE_STR_LEN UNE_DBG_SIZES_SIZE
 #define UNE_SIZE_NAME_LEN UNE_DBG_SIZES_SIZE
 #define UNE_SIZE_VARIABLE_BUF UNE_DBG_SIZES_SIZE
 #define UNE_SIZE_FUNCTION_BUF UNE_DBG_SIZES_SIZE
+#define UNE_SIZE_CONTEXTS UNE_DBG_SIZES_SIZE
+#define UNE_SIZE_VM_STACK UNE_DBG_SIZES_SIZE
 #define UNE_SIZE_TOKEN_BUF UNE_DBG_SIZES_SIZE
 #define UNE_SIZE_SEQUENCE UNE_DBG_SIZES_SIZE
 #define UNE_SIZE_FILE_BUFFER UNE_DBG_SIZES_SIZE
 #define UNE_SIZE_BIF_SPLIT_TKS UNE_DBG_SIZES_SIZE
+#define UNE_SIZE_BIF_REPLACE_MATCHES UNE_DBG_SIZES_SIZE
 #define UNE_SIZE_EXPECTED_TRACEBACK_DEPTH UNE_DBG_SIZES_SIZE
 #define UNE_SIZE_HOLDING UNE_DBG_SIZES_SIZE
 #define UNE_SIZE_CALLABLES UNE_DBG_SIZES_SIZE
 #define UNE_SIZE_MODULES UNE_DBG_SIZES_SIZE
+#define UNE_SIZE_CHUNK_CODE UNE_DBG_SIZES_SIZE
+#define UNE_SIZE_CHUNK_CONSTANTS UNE_DBG_SIZES_SIZE
+#define UNE_SIZE_CHUNK_LOOPS UNE_DBG_SIZES_SIZE
+#define UNE_SIZE_CHUNK_CACHES UNE_DBG_SIZES_SIZE
+#define UNE_SIZE_SLOTS UNE_DBG_SIZES_SIZE
+#define UNE_SIZE_SYMBOLS UNE_DBG_SIZES_SIZE
+#define UNE_SIZE_SHAPE_TRANSITIONS UNE_DBG_SIZES_SIZE
+#define UNE_SIZE_STR_REPRESENT UNE_DBG_SIZES_SIZE
 #endif
 
 /* Output Color Escape Sequences. */
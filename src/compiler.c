@@ -0,0 +1,640 @@
+/*
+compiler.c - Une
+*/
+
+/* Header-specific includes. */
+#include "compiler.h"
+
+/* Implementation-specific includes. */
+#include "interpreter.h"
+
+/*
+Compiler function lookup table.
+*/
+une_compiler__(*compiler_table__[]) = {
+    &une_compile_literal,        &une_compile_literal,        &une_compile_literal,
+    &une_compile_literal,        &une_compile_list,           &une_compile_eval,
+    &une_compile_eval,           &une_compile_literal,        &une_compile_stmts,
+    &une_compile_cop,            &une_compile_not,            &une_compile_and_or_nullish,
+    &une_compile_and_or_nullish, &une_compile_and_or_nullish, &une_compile_comparison,
+    &une_compile_comparison,     &une_compile_comparison,     &une_compile_comparison,
+    &une_compile_comparison,     &une_compile_comparison,     &une_compile_arithmetic,
+    &une_compile_arithmetic,     &une_compile_arithmetic,     &une_compile_arithmetic,
+    &une_compile_arithmetic,     &une_compile_arithmetic,     &une_compile_arithmetic,
+    &une_compile_neg,            &une_compile_seek,           &une_compile_idx_seek,
+    &une_compile_member_seek,    &une_compile_assign,         &une_compile_assign_op,
+    &une_compile_assign_op,      &une_compile_assign_op,      &une_compile_assign_op,
+    &une_compile_assign_op,      &une_compile_assign_op,      &une_compile_assign_op,
+    &une_compile_call,           &une_compile_for_range,      &une_compile_for_element,
+    &une_compile_while,          &une_compile_if,             &une_compile_assert,
+    &une_compile_continue_or_break, &une_compile_continue_or_break, &une_compile_return,
+    &une_compile_exit,           &une_compile_eval,           &une_compile_eval,
+    &une_compile_cover,          &une_compile_concatenate,    &une_compile_this,
+};
+
+/*
+*** Interface.
+*/
+
+/*
+Compile a callable body into a une_chunk. Return NULL if the body exceeds the limits of the
+instruction format, in which case it has to be interpreted instead.
+*/
+une_chunk *une_compile(une_node *body)
+{
+    assert(body);
+
+    une_compiler_state cs = une_compiler_state_create();
+    cs.chunk = une_chunk_create();
+
+    une_compile_node(&cs, body, 0);
+    une_compile_emit(&cs, UNE_OP_END, NULL, 0, 0, 0);
+
+    if (cs.failed) {
+        une_chunk_free(cs.chunk);
+        return NULL;
+    }
+    return cs.chunk;
+}
+
+/*
+*** Compiler table.
+*/
+
+une_compiler__(une_compile_literal)
+{
+    /* Literals are evaluated once and loaded from the constant pool. */
+    une_result constant = une_interpret(node);
+    assert(constant.kind != UNE_RK_ERROR);
+    size_t index = une_chunk_add_constant(cs->chunk, constant);
+    if (index >= UNE_CHUNK_OPERAND_MAX)
+        cs->failed = true;
+    une_compile_emit(cs, UNE_OP_LOAD, node, dst, index, 0);
+}
+
+une_compiler__(une_compile_eval)
+{
+    une_compile_emit(cs, UNE_OP_EVAL, node, dst, 0, 0);
+}
+
+une_compiler__(une_compile_list)
+{
+    UNE_UNPACK_NODE_LIST(node, list, list_size);
+
+    /* Evaluate items into consecutive registers. */
+    UNE_FOR_NODE_LIST_ITEM(i, list_size)
+    une_compile_value(cs, list[i], dst + i);
+
+    une_compile_emit(cs, UNE_OP_LIST, node, dst, dst + 1, list_size);
+}
+
+une_compiler__(une_compile_stmts)
+{
+    UNE_UNPACK_NODE_LIST(node, nodes, nodes_size);
+
+    une_compile_emit(cs, UNE_OP_BLOCK_BEGIN, node, dst, 0, 0);
+    cs->blocks_depth++;
+    if (cs->blocks_depth > cs->chunk->blocks_depth)
+        cs->chunk->blocks_depth = cs->blocks_depth;
+
+    /* Each statement is evaluated into the register above the block's result. */
+    UNE_FOR_NODE_LIST_ITEM(i, nodes_size)
+    {
+        une_compile_node(cs, nodes[i], dst + 1);
+        une_compile_emit(
+            cs, UNE_OP_STATEMENT, nodes[i], dst, cs->constructs_depth > 0, cs->loop);
+    }
+
+    cs->blocks_depth--;
+    une_compile_emit(cs, UNE_OP_BLOCK_END, node, 0, 0, 0);
+}
+
+une_compiler__(une_compile_cop)
+{
+    /* Evaluate condition. */
+    une_compile_value(cs, node->content.branch.a, dst);
+    size_t to_else = une_compile_jump(cs, UNE_OP_JUMP_IF_FALSE, node, dst);
+
+    /* Evaluate correct branch. */
+    une_compile_value(cs, node->content.branch.b, dst);
+    size_t to_end = une_compile_jump(cs, UNE_OP_JUMP, node, 0);
+    une_compile_patch(cs, to_else, cs->chunk->code_count);
+    une_compile_value(cs, node->content.branch.c, dst);
+    une_compile_patch(cs, to_end, cs->chunk->code_count);
+}
+
+une_compiler__(une_compile_not)
+{
+    une_compile_value(cs, node->content.branch.a, dst);
+    une_compile_emit(cs, UNE_OP_NOT, node, dst, 0, 0);
+}
+
+une_compiler__(une_compile_and_or_nullish)
+{
+    une_opcode opcode = UNE_OP_AND;
+    if (node->kind == UNE_NK_OR)
+        opcode = UNE_OP_OR;
+    else if (node->kind == UNE_NK_NULLISH)
+        opcode = UNE_OP_NULLISH;
+
+    /* If branch A decides the outcome, it is kept. Otherwise, branch B replaces it. */
+    une_compile_value(cs, node->content.branch.a, dst);
+    size_t to_end = une_compile_jump(cs, opcode, node, dst);
+    une_compile_value(cs, node->content.branch.b, dst);
+    une_compile_patch(cs, to_end, cs->chunk->code_count);
+}
+
+une_compiler__(une_compile_comparison)
+{
+    /* Comparisons involving ANY or ALL are left to the interpreter. */
+    if (node->content.branch.a->kind == UNE_NK_ANY || node->content.branch.a->kind == UNE_NK_ALL ||
+        node->content.branch.b->kind == UNE_NK_ANY || node->content.branch.b->kind == UNE_NK_ALL) {
+        une_compile_eval(cs, node, dst);
+        return;
+    }
+
+    une_compile_value(cs, node->content.branch.a, dst);
+    une_compile_value(cs, node->content.branch.b, dst + 1);
+    une_opcode opcode =
+        (une_opcode)(UNE_R_BGN_COMPARISON_OPCODES + node->kind - UNE_R_BGN_CONDITION_NODES);
+    une_compile_emit(cs, opcode, node, dst, dst + 1, 0);
+}
+
+une_compiler__(une_compile_arithmetic)
+{
+    une_opcode opcode = UNE_OP_none__;
+    switch (node->kind) {
+    case UNE_NK_ADD:
+        opcode = UNE_OP_ADD;
+        break;
+    case UNE_NK_SUB:
+        opcode = UNE_OP_SUB;
+        break;
+    case UNE_NK_MUL:
+        opcode = UNE_OP_MUL;
+        break;
+    case UNE_NK_FDIV:
+        opcode = UNE_OP_FDIV;
+        break;
+    case UNE_NK_DIV:
+        opcode = UNE_OP_DIV;
+        break;
+    case UNE_NK_MOD:
+        opcode = UNE_OP_MOD;
+        break;
+    case UNE_NK_POW:
+        opcode = UNE_OP_POW;
+        break;
+    default:
+        assert(false);
+    }
+
+    une_compile_value(cs, node->content.branch.a, dst);
+    une_compile_value(cs, node->content.branch.b, dst + 1);
+    une_compile_emit(cs, opcode, node, dst, dst + 1, 0);
+}
+
+une_compiler__(une_compile_neg)
+{
+    une_compile_value(cs, node->content.branch.a, dst);
+    une_compile_emit(cs, UNE_OP_NEGATE, node, dst, 0, 0);
+}
+
+une_compiler__(une_compile_seek)
+{
+    une_compile_emit(cs, UNE_OP_SEEK, node, dst, 0, 0);
+}
+
+une_compiler__(une_compile_idx_seek)
+{
+    une_compile_idx_access(cs, node, dst, false);
+}
+
+une_compiler__(une_compile_member_seek)
+{
+    une_compile_member_access(cs, node, dst, false);
+}
+
+une_compiler__(une_compile_assign)
+{
+    /* Evaluate value. */
+    une_compile_value(cs, node->content.branch.b, dst);
+
+    /* Evaluate assignee. */
+    if (node->content.branch.a->kind == UNE_NK_SEEK)
+        une_compile_emit(cs, UNE_OP_SEEK_OR_CREATE, node->content.branch.a, dst + 1, 0, 0);
+    else
+        une_compile_assignee(cs, node->content.branch.a, dst + 1);
+
+    une_compile_emit(cs, UNE_OP_ASSIGN, node, dst, dst + 1, 0);
+}
+
+une_compiler__(une_compile_assign_op)
+{
+    /* The assignee is checked before the operand is evaluated. */
+    une_compile_assignee(cs, node->content.branch.a, dst);
+    une_compile_emit(cs, UNE_OP_OPERATE_CHECK, node, dst, 0, 0);
+    une_compile_value(cs, node->content.branch.b, dst + 1);
+    une_compile_emit(cs, UNE_OP_OPERATE, node, dst, dst + 1, 0);
+}
+
+une_compiler__(une_compile_call)
+{
+    /* Arguments are evaluated before the callee. A method may write to 'this', so its receiver is
+    resolved like an assignee. */
+    une_compile_arguments(cs, node, dst);
+    if (node->content.branch.a->kind == UNE_NK_MEMBER_SEEK) {
+        une_compile_assignee(cs, node->content.branch.a, dst + 1);
+        une_compile_emit(cs, UNE_OP_DEREFERENCE, node->content.branch.a, dst + 1, 0, 0);
+    } else {
+        une_compile_value(cs, node->content.branch.a, dst + 1);
+    }
+    une_compile_emit(cs, UNE_OP_CALL, node, dst, dst + 1, 0);
+}
+
+une_compiler__(une_compile_for_range)
+{
+    /* Get range. */
+    une_compile_value(cs, node->content.branch.b, dst + 1);
+    une_compile_emit(cs, UNE_OP_AS_INT, node->content.branch.b, dst + 1, 0, 0);
+    une_compile_value(cs, node->content.branch.c, dst + 2);
+    une_compile_emit(cs, UNE_OP_AS_INT, node->content.branch.c, dst + 2, 0, 0);
+    size_t to_end = une_compile_jump(cs, UNE_OP_FOR_RANGE_BEGIN, node, dst + 1);
+
+    /* Loop. */
+    size_t loop = une_compile_loop(cs, dst + 3);
+    size_t outer_loop = cs->loop;
+    size_t body = cs->chunk->code_count;
+    une_compile_emit(cs, UNE_OP_FOR_RANGE_SET, node, dst + 1, 0, 0);
+    cs->loop = loop;
+    cs->constructs_depth++;
+    une_compile_node(cs, node->content.branch.d, dst + 3);
+    cs->constructs_depth--;
+    cs->loop = outer_loop;
+    if (node->content.branch.d->kind != UNE_NK_STMTS) /* Blocks free their previous result. */
+        une_compile_emit(cs, UNE_OP_CLEAR, node, dst + 3, 0, 0);
+    cs->chunk->loops[loop].continue_target = cs->chunk->code_count;
+    size_t to_body = une_compile_jump(cs, UNE_OP_FOR_RANGE_NEXT, node, dst + 1);
+    une_compile_patch(cs, to_body, body);
+
+    /* Release range. */
+    cs->chunk->loops[loop].break_target = cs->chunk->code_count;
+    une_compile_patch(cs, to_end, cs->chunk->code_count);
+    une_compile_emit(cs, UNE_OP_CLEAR, node, dst + 1, 0, 0);
+    une_compile_emit(cs, UNE_OP_CLEAR, node, dst + 2, 0, 0);
+    une_compile_emit(cs, UNE_OP_CLEAR, node, dst + 3, 0, 0);
+}
+
+une_compiler__(une_compile_for_element)
+{
+    /* Get elements. */
+    une_compile_value(cs, node->content.branch.b, dst + 1);
+    une_compile_register(cs, dst + 2); /* Cursor. */
+    une_compile_register(cs, dst + 3); /* Next element. */
+    size_t to_end = une_compile_jump(cs, UNE_OP_FOR_ELEMENT_BEGIN, node, dst + 1);
+
+    /* Loop. */
+    size_t loop = une_compile_loop(cs, dst + 4);
+    size_t outer_loop = cs->loop;
+    size_t body = cs->chunk->code_count;
+    une_compile_emit(cs, UNE_OP_FOR_ELEMENT_SET, node, dst + 1, 0, 0);
+    cs->loop = loop;
+    cs->constructs_depth++;
+    une_compile_node(cs, node->content.branch.c, dst + 4);
+    cs->constructs_depth--;
+    cs->loop = outer_loop;
+    une_compile_emit(cs, UNE_OP_CLEAR, node, dst + 4, 0, 0);
+    cs->chunk->loops[loop].continue_target = cs->chunk->code_count;
+    size_t to_body = une_compile_jump(cs, UNE_OP_FOR_ELEMENT_NEXT, node, dst + 1);
+    une_compile_patch(cs, to_body, body);
+
+    /* Release elements. */
+    cs->chunk->loops[loop].break_target = cs->chunk->code_count;
+    une_compile_patch(cs, to_end, cs->chunk->code_count);
+    une_compile_emit(cs, UNE_OP_CLEAR, node, dst + 1, 0, 0);
+    une_compile_emit(cs, UNE_OP_CLEAR, node, dst + 2, 0, 0);
+    une_compile_emit(cs, UNE_OP_CLEAR, node, dst + 3, 0, 0);
+}
+
+une_compiler__(une_compile_while)
+{
+    size_t loop = une_compile_loop(cs, dst);
+    size_t outer_loop = cs->loop;
+
+    /* Check condition. */
+    size_t condition = cs->chunk->code_count;
+    une_compile_value(cs, node->content.branch.a, dst);
+    size_t to_end = une_compile_jump(cs, UNE_OP_JUMP_IF_FALSE, node, dst);
+
+    /* Loop. */
+    cs->loop = loop;
+    cs->constructs_depth++;
+    une_compile_node(cs, node->content.branch.b, dst);
+    cs->constructs_depth--;
+    cs->loop = outer_loop;
+    une_compile_emit(cs, UNE_OP_CLEAR, node, dst, 0, 0);
+    size_t to_condition = une_compile_jump(cs, UNE_OP_JUMP, node, 0);
+    une_compile_patch(cs, to_condition, condition);
+
+    une_compile_patch(cs, to_end, cs->chunk->code_count);
+    cs->chunk->loops[loop].break_target = cs->chunk->code_count;
+    cs->chunk->loops[loop].continue_target = condition;
+}
+
+une_compiler__(une_compile_if)
+{
+    /* Check if predicate applies. */
+    une_compile_value(cs, node->content.branch.a, dst);
+    size_t to_else = une_compile_jump(cs, UNE_OP_JUMP_IF_FALSE, node, dst);
+
+    cs->constructs_depth++;
+    une_compile_value(cs, node->content.branch.b, dst);
+    if (node->content.branch.c != NULL) {
+        size_t to_end = une_compile_jump(cs, UNE_OP_JUMP, node, 0);
+        une_compile_patch(cs, to_else, cs->chunk->code_count);
+        une_compile_value(cs, node->content.branch.c, dst);
+        une_compile_patch(cs, to_end, cs->chunk->code_count);
+    } else {
+        une_compile_patch(cs, to_else, cs->chunk->code_count);
+    }
+    cs->constructs_depth--;
+}
+
+une_compiler__(une_compile_assert)
+{
+    une_compile_value(cs, node->content.branch.a, dst);
+    une_compile_emit(cs, UNE_OP_ASSERT, node, dst, 0, 0);
+}
+
+une_compiler__(une_compile_continue_or_break)
+{
+    /* The resulting CONTINUE or BREAK is handled by the enclosing statement. */
+    une_compile_literal(cs, node, dst);
+}
+
+une_compiler__(une_compile_return)
+{
+    /* Dereferencing happens in the enclosing statement. */
+    if (node->content.branch.a != NULL)
+        une_compile_tail(cs, node->content.branch.a, dst);
+    else
+        une_compile_emit(cs, UNE_OP_CLEAR, node, dst, 0, 0);
+    une_compile_emit(cs, UNE_OP_RETURN, node, dst, 0, 0);
+}
+
+une_compiler__(une_compile_exit)
+{
+    if (node->content.branch.a != NULL) {
+        une_compile_value(cs, node->content.branch.a, dst);
+        une_compile_emit(cs, UNE_OP_EXIT, node->content.branch.a, dst, 0, 0);
+    } else {
+        une_compile_emit(cs, UNE_OP_CLEAR, node, dst, 0, 0);
+        une_compile_emit(cs, UNE_OP_EXIT, NULL, dst, 0, 0);
+    }
+}
+
+une_compiler__(une_compile_cover)
+{
+    /* Try to evaluate branch A. */
+    size_t to_handler = une_compile_jump(cs, UNE_OP_COVER_BEGIN, node, dst);
+    cs->covers_depth++;
+    if (cs->covers_depth > cs->chunk->covers_depth)
+        cs->chunk->covers_depth = cs->covers_depth;
+    une_compile_value(cs, node->content.branch.a, dst);
+    cs->covers_depth--;
+    une_compile_emit(cs, UNE_OP_COVER_END, node, 0, 0, 0);
+    size_t to_end = une_compile_jump(cs, UNE_OP_JUMP, node, 0);
+
+    /* Fall back to branch B. */
+    une_compile_patch(cs, to_handler, cs->chunk->code_count);
+    une_compile_value(cs, node->content.branch.b, dst);
+    une_compile_patch(cs, to_end, cs->chunk->code_count);
+}
+
+une_compiler__(une_compile_concatenate)
+{
+    une_compile_value(cs, node->content.branch.a, dst);
+    une_compile_value(cs, node->content.branch.b, dst + 1);
+    une_compile_emit(cs, UNE_OP_CONCATENATE, node, dst, dst + 1, 0);
+}
+
+une_compiler__(une_compile_this)
+{
+    une_compile_emit(cs, UNE_OP_THIS, node, dst, 0, 0);
+}
+
+/*
+*** Helpers.
+*/
+
+/*
+Compile a node into a register. Registers above it may be used as temporaries.
+*/
+une_static__ void une_compile_node(une_compiler_state *cs, une_node *node, size_t dst)
+{
+    assert(UNE_NODE_KIND_IS_IN_LUT(node->kind));
+
+    une_compile_register(cs, dst);
+    if (cs->failed)
+        return;
+    compiler_table__[(node->kind) - UNE_R_BGN_LUT_NODES](cs, node, dst);
+}
+
+/*
+Compile a node into a register and dereference the result.
+*/
+une_static__ void une_compile_value(une_compiler_state *cs, une_node *node, size_t dst)
+{
+    /* Variables are read in one instruction. */
+    if (node->kind == UNE_NK_SEEK) {
+        une_compile_register(cs, dst);
+        une_compile_emit(cs, UNE_OP_SEEK_VALUE, node, dst, 0, 0);
+        return;
+    }
+
+    une_compile_node(cs, node, dst);
+
+    /* Constants are never references. */
+    if (compiler_table__[node->kind - UNE_R_BGN_LUT_NODES] != &une_compile_literal)
+        une_compile_emit(cs, UNE_OP_DEREFERENCE, node, dst, 0, 0);
+}
+
+/*
+Compile a returned node, turning calls in tail position into tail calls. A cover must still catch
+the errors of a call, so calls inside covers are never tail calls.
+*/
+une_static__ void une_compile_tail(une_compiler_state *cs, une_node *node, size_t dst)
+{
+    bool is_tail_call =
+        node->kind == UNE_NK_CALL && node->content.branch.a->kind != UNE_NK_MEMBER_SEEK;
+    if (cs->covers_depth > 0 || (!is_tail_call && node->kind != UNE_NK_COP)) {
+        une_compile_node(cs, node, dst);
+        return;
+    }
+    une_compile_register(cs, dst);
+    if (cs->failed)
+        return;
+
+    /* Call, without the method handling of une_compile_call. */
+    if (is_tail_call) {
+        une_compile_arguments(cs, node, dst);
+        une_compile_value(cs, node->content.branch.a, dst + 1);
+        une_compile_emit(cs, UNE_OP_TAIL_CALL, node, dst, dst + 1, 0);
+        return;
+    }
+
+    /* Conditional operation, see une_compile_cop. */
+    une_compile_value(cs, node->content.branch.a, dst);
+    size_t to_else = une_compile_jump(cs, UNE_OP_JUMP_IF_FALSE, node, dst);
+    une_compile_tail(cs, node->content.branch.b, dst);
+    une_compile_emit(cs, UNE_OP_DEREFERENCE, node->content.branch.b, dst, 0, 0);
+    size_t to_end = une_compile_jump(cs, UNE_OP_JUMP, node, 0);
+    une_compile_patch(cs, to_else, cs->chunk->code_count);
+    une_compile_tail(cs, node->content.branch.c, dst);
+    une_compile_emit(cs, UNE_OP_DEREFERENCE, node->content.branch.c, dst, 0, 0);
+    une_compile_patch(cs, to_end, cs->chunk->code_count);
+}
+
+/*
+Compile the arguments of a call into a list. A native that writes to its first argument receives a
+reference to it instead, which is resolved after the other arguments so that evaluating them cannot
+move what it refers to.
+*/
+une_static__ void une_compile_arguments(une_compiler_state *cs, une_node *call, size_t dst)
+{
+    une_node *callee = call->content.branch.a;
+    une_node *arguments = call->content.branch.b;
+    if (callee->kind != UNE_NK_NATIVE ||
+        !une_native_writes_to_argument((une_native)callee->content.value._int)) {
+        une_compile_list(cs, arguments, dst);
+        return;
+    }
+    UNE_UNPACK_NODE_LIST(arguments, list, list_size);
+    for (size_t i = 2; i <= list_size; i++)
+        une_compile_value(cs, list[i], dst + i);
+    if (list_size > 0) {
+        une_compile_assignee(cs, list[1], dst + list_size + 1);
+        une_compile_emit(cs, UNE_OP_MOVE, list[1], dst + 1, dst + list_size + 1, 0);
+    }
+    une_compile_emit(cs, UNE_OP_LIST, arguments, dst, dst + 1, list_size);
+}
+
+/*
+Compile the target of an assignment, giving every container on the way sole ownership of its
+storage. See une_interpret_assignee.
+*/
+une_static__ void une_compile_assignee(une_compiler_state *cs, une_node *node, size_t dst)
+{
+    if (node->kind != UNE_NK_IDX_SEEK && node->kind != UNE_NK_MEMBER_SEEK) {
+        une_compile_node(cs, node, dst);
+        return;
+    }
+    une_compile_register(cs, dst);
+    if (cs->failed)
+        return;
+    if (node->kind == UNE_NK_IDX_SEEK)
+        une_compile_idx_access(cs, node, dst, true);
+    else
+        une_compile_member_access(cs, node, dst, true);
+}
+
+/*
+Compile an index or range access. Operand c of the access instruction is set when writing.
+*/
+une_static__ void une_compile_idx_access(une_compiler_state *cs,
+                                         une_node *node,
+                                         size_t dst,
+                                         bool for_writing)
+{
+    /* The subject is not dereferenced, so that we can refer into it. */
+    if (for_writing)
+        une_compile_assignee(cs, node->content.branch.a, dst);
+    else
+        une_compile_node(cs, node->content.branch.a, dst);
+    une_compile_emit(cs, UNE_OP_INDEX_CHECK, node, dst, 0, 0);
+
+    une_compile_value(cs, node->content.branch.b, dst + 1);
+    if (node->content.branch.c) {
+        une_compile_value(cs, node->content.branch.c, dst + 2);
+        une_compile_emit(cs, UNE_OP_RANGE, node, dst, dst + 1, for_writing);
+    } else {
+        une_compile_emit(cs, UNE_OP_INDEX, node, dst, dst + 1, for_writing);
+    }
+}
+
+/*
+Compile a member access. Operand c of the access instruction is set when writing.
+*/
+une_static__ void une_compile_member_access(une_compiler_state *cs,
+                                            une_node *node,
+                                            size_t dst,
+                                            bool for_writing)
+{
+    if (for_writing)
+        une_compile_assignee(cs, node->content.branch.a, dst);
+    else
+        une_compile_node(cs, node->content.branch.a, dst);
+    size_t cache = une_chunk_add_cache(cs->chunk);
+    if (cache >= UNE_CHUNK_OPERAND_MAX)
+        cs->failed = true;
+    une_compile_emit(cs, UNE_OP_MEMBER, node, dst, cache, for_writing);
+}
+
+/*
+Ensure a register exists and return it as an operand.
+*/
+une_static__ uint16_t une_compile_register(une_compiler_state *cs, size_t index)
+{
+    if (index >= UNE_CHUNK_OPERAND_MAX) {
+        cs->failed = true;
+        return 0;
+    }
+    if (index >= cs->chunk->registers_count)
+        cs->chunk->registers_count = index + 1;
+    return (uint16_t)index;
+}
+
+/*
+Emit an instruction, returning its index.
+*/
+une_static__ size_t une_compile_emit(
+    une_compiler_state *cs, une_opcode opcode, une_node *node, size_t a, size_t b, size_t c)
+{
+    une_compile_register(cs, a); /* Operand 'a' is always a register. */
+    if (b > UNE_CHUNK_OPERAND_MAX || c > UNE_CHUNK_OPERAND_MAX ||
+        cs->chunk->code_count >= UNE_CHUNK_TARGET_MAX)
+        cs->failed = true;
+    if (cs->failed)
+        return 0;
+    return une_chunk_emit(cs->chunk, opcode, node, (uint16_t)a, (uint16_t)b, (uint16_t)c);
+}
+
+/*
+Register a loop starting at the current block depth, returning its index.
+*/
+une_static__ size_t une_compile_loop(une_compiler_state *cs, size_t registers)
+{
+    size_t loop = une_chunk_add_loop(cs->chunk, cs->blocks_depth, registers);
+    if (loop >= UNE_CHUNK_NO_LOOP)
+        cs->failed = true;
+    return loop;
+}
+
+/*
+Emit a jump instruction whose target is patched later, returning its index.
+*/
+une_static__ size_t une_compile_jump(
+    une_compiler_state *cs, une_opcode opcode, une_node *node, size_t a)
+{
+    return une_compile_emit(cs, opcode, node, a, 0, 0);
+}
+
+/*
+Set the target of a jump instruction.
+*/
+une_static__ void une_compile_patch(une_compiler_state *cs, size_t instruction, size_t target)
+{
+    if (cs->failed)
+        return;
+    une_chunk_patch_target(cs->chunk, instruction, target);
+}
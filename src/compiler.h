@@ -0,0 +1,83 @@
+/*
+compiler.h - Une
+*/
+
+#ifndef UNE_COMPILER_H
+#define UNE_COMPILER_H
+
+/* Header-specific includes. */
+#include "common.h"
+#include "struct/chunk.h"
+#include "struct/compiler_state.h"
+#include "struct/node.h"
+
+/*
+Compiler function template.
+*/
+#define une_compiler__(name__, ...)                                                                \
+    une_static__ void(name__)(une_compiler_state * cs, une_node * node, size_t dst, ##__VA_ARGS__)
+
+/*
+*** Interface.
+*/
+
+une_chunk *une_compile(une_node *body);
+
+/*
+*** Compiler table.
+*/
+
+une_compiler__(une_compile_literal);
+une_compiler__(une_compile_eval);
+une_compiler__(une_compile_list);
+une_compiler__(une_compile_stmts);
+une_compiler__(une_compile_cop);
+une_compiler__(une_compile_not);
+une_compiler__(une_compile_and_or_nullish);
+une_compiler__(une_compile_comparison);
+une_compiler__(une_compile_arithmetic);
+une_compiler__(une_compile_neg);
+une_compiler__(une_compile_seek);
+une_compiler__(une_compile_idx_seek);
+une_compiler__(une_compile_member_seek);
+une_compiler__(une_compile_assign);
+une_compiler__(une_compile_assign_op);
+une_compiler__(une_compile_call);
+une_compiler__(une_compile_for_range);
+une_compiler__(une_compile_for_element);
+une_compiler__(une_compile_while);
+une_compiler__(une_compile_if);
+une_compiler__(une_compile_assert);
+une_compiler__(une_compile_continue_or_break);
+une_compiler__(une_compile_return);
+une_compiler__(une_compile_exit);
+une_compiler__(une_compile_cover);
+une_compiler__(une_compile_concatenate);
+une_compiler__(une_compile_this);
+
+/*
+*** Helpers.
+*/
+
+une_static__ void une_compile_node(une_compiler_state *cs, une_node *node, size_t dst);
+une_static__ void une_compile_arguments(une_compiler_state *cs, une_node *call, size_t dst);
+une_static__ void une_compile_assignee(une_compiler_state *cs, une_node *node, size_t dst);
+une_static__ void une_compile_idx_access(une_compiler_state *cs,
+                                         une_node *node,
+                                         size_t dst,
+                                         bool for_writing);
+une_static__ void une_compile_member_access(une_compiler_state *cs,
+                                            une_node *node,
+                                            size_t dst,
+                                            bool for_writing);
+une_static__ void une_compile_value(une_compiler_state *cs, une_node *node, size_t dst);
+une_static__ void une_compile_tail(une_compiler_state *cs, une_node *node, size_t dst);
+une_static__ uint16_t une_compile_register(une_compiler_state *cs, size_t index);
+une_static__ size_t une_compile_emit(
+    une_compiler_state *cs, une_opcode opcode, une_node *node, size_t a, size_t b, size_t c);
+une_static__ size_t une_compile_loop(une_compiler_state *cs, size_t registers);
+une_static__ size_t une_compile_jump(
+    une_compiler_state *cs, une_opcode opcode, une_node *node, size_t a);
+une_static__ void une_compile_patch(une_compiler_state *cs, size_t instruction, size_t target);
+
+#endif /* !UNE_COMPILER_H */
@@ -76,9 +76,7 @@ une_interpreter__(une_interpret_flt)
 une_interpreter__(une_interpret_str)
 {
     /* DOC: Memory Management: Here we can see that results DUPLICATE strings. */
-    une_result result = {.kind = UNE_RK_STR, .value._wcs = wcsdup(node->content.value._wcs)};
-    verify(result.value._wcs);
-    return result;
+    return une_type_str_from_wcs(node->content.value._wcs);
 }
 
 une_interpreter__(une_interpret_list)
@@ -93,10 +91,9 @@ une_interpreter__(une_interpret_list)
     {
         result_list[i] = une_result_dereference(une_interpret(list[i]));
         if (result_list[i].kind == UNE_RK_ERROR) {
-            une_result result = une_result_copy(result_list[i]);
-            for (size_t j = 0; j <= i; j++)
-                une_result_free(result_list[j]);
-            free(result_list);
+            une_result result = result_list[i];
+            result_list[0].value._int = (une_int)(i - 1); /* Free the items before the error. */
+            une_result_free((une_result){.kind = UNE_RK_LIST, .value._vp = (void *)result_list});
             return result;
         }
     }
@@ -110,64 +107,45 @@ une_interpreter__(une_interpret_object)
 {
     UNE_UNPACK_NODE_LIST(node, list, list_size);
 
+    /* Determine shape. */
+    une_shape *shape = felix->shapes;
+    UNE_FOR_NODE_LIST_ITEM(i, list_size)
+    {
+        une_symbol name = (une_symbol)list[i]->content.branch.a->content.value._id;
+        if (une_shape_find_member(shape, name) == UNE_SHAPE_NO_MEMBER)
+            shape = une_shape_add_member(shape, name);
+    }
+
     /* Create object. */
-    une_object *object = malloc(sizeof(*object));
-    verify(object);
-    object->members_length = list_size;
-    object->members = malloc(object->members_length * sizeof(*object->members));
-    verify(object->members);
-    object->owner = felix->is.context;
-
-    /* Store associations. */
+    une_object *object = une_type_object_create(shape);
+    une_result result = (une_result){.kind = UNE_RK_OBJECT, .value._vp = (void *)object};
+
+    /* Store members. If a name repeats, the last value wins. */
     UNE_FOR_NODE_LIST_ITEM(i, list_size)
     {
-        /* Add association. */
-        une_association *association = une_association_create();
-        object->members[i - 1] = association;
-        /* Populate association. */
-        association->name = wcsdup(list[i]->content.branch.a->content.value._wcs);
-        verify(association->name);
-        association->content = une_result_dereference(une_interpret(list[i]->content.branch.b));
-        if (association->content.kind == UNE_RK_ERROR) {
-            une_result result = une_result_copy(association->content);
-            UNE_FOR_NODE_LIST_ITEM(j, i)
-            une_association_free(object->members[j - 1]);
-            free(object->members);
-            free(object);
-            return result;
+        une_symbol name = (une_symbol)list[i]->content.branch.a->content.value._id;
+        une_result member = une_result_dereference(une_interpret(list[i]->content.branch.b));
+        if (member.kind == UNE_RK_ERROR) {
+            une_result_free(result);
+            return member;
         }
+        size_t offset = une_shape_find_member(shape, name);
+        une_result_free(object->members[offset]);
+        object->members[offset] = member;
     }
 
-    return (une_result){.kind = UNE_RK_OBJECT, .value._vp = (void *)object};
+    return result;
 }
 
 une_interpreter__(une_interpret_function)
 {
-    /* Reduce parameter nodes to a vector of strings. */
-    UNE_UNPACK_NODE_LIST(node->content.branch.a, p_nodes, p_count);
-    wchar_t **p_names = NULL;
-    if (p_count > 0) {
-        p_names = malloc(p_count * sizeof(*p_names));
-        verify(p_names);
-    }
-    for (size_t i = 0; i < p_count; i++) {
-        p_names[i] = wcsdup(p_nodes[i + 1]->content.value._wcs);
-        verify(p_names[i]);
-    }
-
-    /* Register callable. */
-    une_callable *callable = une_callables_add_callable(&felix->is.callables);
+    /* The resolver registered one callable for this literal. */
+    assert(node->content.branch.d->kind == UNE_NK_ID);
+    size_t id = node->content.branch.d->content.value._id;
+    une_callable *callable = une_callables_get_callable_by_id(felix->is.callables, id);
     assert(callable);
-
-    assert(node->content.branch.c->kind == UNE_NK_ID);
-    callable->module_id = node->content.branch.c->content.value._id;
-    callable->position = node->pos;
-    callable->parameters.count = p_count;
-    callable->parameters.names = p_names;
-    callable->body = une_node_copy(node->content.branch.b);
-
-    /* Return FUNCTION result. */
-    return (une_result){.kind = UNE_RK_FUNCTION, .value._id = callable->id};
+    callable->is_lent = true;
+    return (une_result){.kind = UNE_RK_FUNCTION, .value._id = id};
 }
 
 une_interpreter__(une_interpret_native)
@@ -177,7 +155,7 @@ une_interpreter__(une_interpret_native)
 
 une_interpreter__(une_interpret_stmts)
 {
-    une_holding old_holding = une_interpreter_state_holding_strip(&felix->is);
+    size_t watermark = une_interpreter_state_holding_strip(&felix->is);
 
     une_result result_ = une_result_create(UNE_RK_VOID);
 
@@ -202,7 +180,7 @@ une_interpreter__(une_interpret_stmts)
             break;
     }
 
-    une_interpreter_state_holding_reinstate(&felix->is, old_holding);
+    une_interpreter_state_holding_reinstate(&felix->is, watermark);
 
     return result_; /* Return last result. */
 }
@@ -520,58 +498,13 @@ une_interpreter__(une_interpret_seek)
 une_interpreter__(une_interpret_idx_seek)
 {
     if (node->content.branch.c)
-        return une_interpret_idx_seek_range(node);
-    return une_interpret_idx_seek_index(node);
+        return une_interpret_idx_seek_range(node, false);
+    return une_interpret_idx_seek_index(node, false);
 }
 
 une_interpreter__(une_interpret_member_seek)
 {
-    /* Evaluate subject. */
-    une_result subject = une_interpret(node->content.branch.a);
-    if (subject.kind == UNE_RK_ERROR)
-        return subject;
-    if (subject.kind != UNE_RK_REFERENCE && subject.kind != UNE_RK_OBJECT) {
-        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
-        une_result_free(subject);
-        return une_result_create(UNE_RK_ERROR);
-    }
-    if (subject.kind == UNE_RK_OBJECT) {
-        assert(felix->is.holding.buffer);
-        une_result *object_container = une_interpreter_state_holding_add(&felix->is, subject);
-        subject = (une_result){
-            .kind = UNE_RK_REFERENCE,
-            .reference = (une_reference){.kind = UNE_FK_SINGLE, .root = (void *)object_container}};
-    }
-
-    /* Get applicable type. */
-    une_type result_type = UNE_TYPE_FOR_RESULT(subject);
-
-    /* Check if subject supports members. */
-    if (!result_type.refer_to_member) {
-        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
-        une_result_free(subject);
-        return une_result_create(UNE_RK_ERROR);
-    }
-    assert(result_type.member_exists);
-
-    /* Extract member name. */
-    assert(node->content.branch.b->kind == UNE_NK_NAME);
-    wchar_t *name = node->content.branch.b->content.value._wcs;
-
-    /* Refer to member. */
-    if (!result_type.member_exists(subject, name)) {
-        felix->error = UNE_ERROR_SET(UNE_EK_SYMBOL_NOT_DEFINED, node->content.branch.b->pos);
-        une_result_free(subject);
-        return une_result_create(UNE_RK_ERROR);
-    }
-    une_result member = result_type.refer_to_member(subject, name);
-    assert(member.kind == UNE_RK_REFERENCE);
-
-    /* Register container as 'this' contestant. */
-    une_result_free(felix->is.this_contestant);
-    felix->is.this_contestant = subject;
-
-    return member;
+    return une_interpret_member_access(node, false);
 }
 
 une_interpreter__(une_interpret_assign)
@@ -586,7 +519,7 @@ une_interpreter__(une_interpret_assign)
     if (node->content.branch.a->kind == UNE_NK_SEEK)
         assignee = une_interpret_seek_or_create(node->content.branch.a, false);
     else
-        assignee = une_interpret(node->content.branch.a);
+        assignee = une_interpret_assignee(node->content.branch.a);
     if (assignee.kind == UNE_RK_ERROR) {
         une_result_free(value);
         return assignee;
@@ -597,7 +530,8 @@ une_interpreter__(une_interpret_assign)
 
     /* Check if value can be assigned. If .can_assign is undefined, assume any value can be
      * assigned. */
-    if (assignee_type.can_assign && !assignee_type.can_assign(assignee.reference, value)) {
+    if (assignee_type.can_assign &&
+        !assignee_type.can_assign(UNE_RESULT_REFERENCE(assignee), value)) {
         felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.b->pos);
         une_result_free(assignee);
         une_result_free(value);
@@ -607,10 +541,10 @@ une_interpreter__(une_interpret_assign)
     /* Assign value. If .assign is undefined, assume reference.root points to a generic une_result*.
      */
     if (assignee_type.assign) {
-        assignee_type.assign(assignee.reference, value);
+        assignee_type.assign(UNE_RESULT_REFERENCE(assignee), value);
         une_result_free(value);
     } else {
-        une_result *root = (une_result *)assignee.reference.root;
+        une_result *root = (une_result *)assignee.reference_root;
         une_result_free(*root); /* Free the value currently stored at reference.root. */
         *root = value; /* Instead of copying this result, we just use the original; this way, we
                           also don't need to worry about freeing it. */
@@ -623,19 +557,19 @@ une_interpreter__(une_interpret_assign)
 une_interpreter__(une_interpret_assign_add)
 {
     /* Evaluate assignee. */
-    une_result assignee = une_interpret(node->content.branch.a);
+    une_result assignee = une_interpret_assignee(node->content.branch.a);
     if (assignee.kind == UNE_RK_ERROR)
         return assignee;
 
     /* Access subject. */
     une_result *subject;
     if (assignee.kind == UNE_RK_REFERENCE) {
-        if (assignee.reference.kind != UNE_FK_SINGLE) {
+        if (assignee.reference_kind != UNE_FK_SINGLE) {
             une_result_free(assignee);
             felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
             return une_result_create(UNE_RK_ERROR);
         }
-        subject = (une_result *)assignee.reference.root;
+        subject = (une_result *)assignee.reference_root;
     } else {
         assert(UNE_RESULT_KIND_IS_TYPE(assignee.kind));
         subject = &assignee;
@@ -658,6 +592,14 @@ une_interpreter__(une_interpret_assign_add)
         return operand;
     }
 
+    /* Add in place where the type can. */
+    if (subject != &assignee && subject_type.add_in_place &&
+        subject_type.add_in_place(subject, operand)) {
+        une_result_free(assignee);
+        une_result_free(operand);
+        return une_result_create(UNE_RK_VOID);
+    }
+
     /* Perform operation. */
     une_result result = subject_type.add(*subject, operand);
     if (result.kind == UNE_RK_ERROR) {
@@ -678,19 +620,19 @@ une_interpreter__(une_interpret_assign_add)
 une_interpreter__(une_interpret_assign_sub)
 {
     /* Evaluate assignee. */
-    une_result assignee = une_interpret(node->content.branch.a);
+    une_result assignee = une_interpret_assignee(node->content.branch.a);
     if (assignee.kind == UNE_RK_ERROR)
         return assignee;
 
     /* Access subject. */
     une_result *subject;
     if (assignee.kind == UNE_RK_REFERENCE) {
-        if (assignee.reference.kind != UNE_FK_SINGLE) {
+        if (assignee.reference_kind != UNE_FK_SINGLE) {
             une_result_free(assignee);
             felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
             return une_result_create(UNE_RK_ERROR);
         }
-        subject = (une_result *)assignee.reference.root;
+        subject = (une_result *)assignee.reference_root;
     } else {
         assert(UNE_RESULT_KIND_IS_TYPE(assignee.kind));
         subject = &assignee;
@@ -733,19 +675,19 @@ une_interpreter__(une_interpret_assign_sub)
 une_interpreter__(une_interpret_assign_pow)
 {
     /* Evaluate assignee. */
-    une_result assignee = une_interpret(node->content.branch.a);
+    une_result assignee = une_interpret_assignee(node->content.branch.a);
     if (assignee.kind == UNE_RK_ERROR)
         return assignee;
 
     /* Access subject. */
     une_result *subject;
     if (assignee.kind == UNE_RK_REFERENCE) {
-        if (assignee.reference.kind != UNE_FK_SINGLE) {
+        if (assignee.reference_kind != UNE_FK_SINGLE) {
             une_result_free(assignee);
             felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
             return une_result_create(UNE_RK_ERROR);
         }
-        subject = (une_result *)assignee.reference.root;
+        subject = (une_result *)assignee.reference_root;
     } else {
         assert(UNE_RESULT_KIND_IS_TYPE(assignee.kind));
         subject = &assignee;
@@ -788,19 +730,19 @@ une_interpreter__(une_interpret_assign_pow)
 une_interpreter__(une_interpret_assign_mul)
 {
     /* Evaluate assignee. */
-    une_result assignee = une_interpret(node->content.branch.a);
+    une_result assignee = une_interpret_assignee(node->content.branch.a);
     if (assignee.kind == UNE_RK_ERROR)
         return assignee;
 
     /* Access subject. */
     une_result *subject;
     if (assignee.kind == UNE_RK_REFERENCE) {
-        if (assignee.reference.kind != UNE_FK_SINGLE) {
+        if (assignee.reference_kind != UNE_FK_SINGLE) {
             une_result_free(assignee);
             felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
             return une_result_create(UNE_RK_ERROR);
         }
-        subject = (une_result *)assignee.reference.root;
+        subject = (une_result *)assignee.reference_root;
     } else {
         assert(UNE_RESULT_KIND_IS_TYPE(assignee.kind));
         subject = &assignee;
@@ -843,19 +785,19 @@ une_interpreter__(une_interpret_assign_mul)
 une_interpreter__(une_interpret_assign_fdiv)
 {
     /* Evaluate assignee. */
-    une_result assignee = une_interpret(node->content.branch.a);
+    une_result assignee = une_interpret_assignee(node->content.branch.a);
     if (assignee.kind == UNE_RK_ERROR)
         return assignee;
 
     /* Access subject. */
     une_result *subject;
     if (assignee.kind == UNE_RK_REFERENCE) {
-        if (assignee.reference.kind != UNE_FK_SINGLE) {
+        if (assignee.reference_kind != UNE_FK_SINGLE) {
             une_result_free(assignee);
             felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
             return une_result_create(UNE_RK_ERROR);
         }
-        subject = (une_result *)assignee.reference.root;
+        subject = (une_result *)assignee.reference_root;
     } else {
         assert(UNE_RESULT_KIND_IS_TYPE(assignee.kind));
         subject = &assignee;
@@ -898,19 +840,19 @@ une_interpreter__(une_interpret_assign_fdiv)
 une_interpreter__(une_interpret_assign_div)
 {
     /* Evaluate assignee. */
-    une_result assignee = une_interpret(node->content.branch.a);
+    une_result assignee = une_interpret_assignee(node->content.branch.a);
     if (assignee.kind == UNE_RK_ERROR)
         return assignee;
 
     /* Access subject. */
     une_result *subject;
     if (assignee.kind == UNE_RK_REFERENCE) {
-        if (assignee.reference.kind != UNE_FK_SINGLE) {
+        if (assignee.reference_kind != UNE_FK_SINGLE) {
             une_result_free(assignee);
             felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
             return une_result_create(UNE_RK_ERROR);
         }
-        subject = (une_result *)assignee.reference.root;
+        subject = (une_result *)assignee.reference_root;
     } else {
         assert(UNE_RESULT_KIND_IS_TYPE(assignee.kind));
         subject = &assignee;
@@ -953,19 +895,19 @@ une_interpreter__(une_interpret_assign_div)
 une_interpreter__(une_interpret_assign_mod)
 {
     /* Evaluate assignee. */
-    une_result assignee = une_interpret(node->content.branch.a);
+    une_result assignee = une_interpret_assignee(node->content.branch.a);
     if (assignee.kind == UNE_RK_ERROR)
         return assignee;
 
     /* Access subject. */
     une_result *subject;
     if (assignee.kind == UNE_RK_REFERENCE) {
-        if (assignee.reference.kind != UNE_FK_SINGLE) {
+        if (assignee.reference_kind != UNE_FK_SINGLE) {
             une_result_free(assignee);
             felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
             return une_result_create(UNE_RK_ERROR);
         }
-        subject = (une_result *)assignee.reference.root;
+        subject = (une_result *)assignee.reference_root;
     } else {
         assert(UNE_RESULT_KIND_IS_TYPE(assignee.kind));
         subject = &assignee;
@@ -1008,12 +950,15 @@ une_interpreter__(une_interpret_assign_mod)
 une_interpreter__(une_interpret_call)
 {
     /* Interpret arguments. */
-    une_result args = une_result_dereference(une_interpret_list(node->content.branch.b));
+    une_result args = une_interpret_arguments(node);
     if (args.kind == UNE_RK_ERROR)
         return args;
 
-    /* Get callable. */
-    une_result callable = une_result_dereference(une_interpret(node->content.branch.a));
+    /* Get callable. A method may write to 'this', so its receiver is resolved like an assignee. */
+    une_node *callee = node->content.branch.a;
+    une_result callable = une_result_dereference(callee->kind == UNE_NK_MEMBER_SEEK
+                                                     ? une_interpret_member_access(callee, true)
+                                                     : une_interpret(callee));
     if (callable.kind == UNE_RK_ERROR) {
         une_result_free(args);
         return callable;
@@ -1042,17 +987,17 @@ une_interpreter__(une_interpret_call)
     }
 
     /* Determine label. */
-    wchar_t *label = NULL;
+    une_symbol label = UNE_SYMBOL_NONE;
     if (node->content.branch.a->kind == UNE_NK_SEEK) {
         une_node *seek = node->content.branch.a;
         une_node *name = seek->content.branch.a;
         assert(name && name->kind == UNE_NK_NAME);
-        label = name->content.value._wcs;
+        label = (une_symbol)name->content.value._id;
     } else if (node->content.branch.a->kind == UNE_NK_MEMBER_SEEK) {
         une_node *member_seek = node->content.branch.a;
         une_node *name = member_seek->content.branch.b;
         assert(name && name->kind == UNE_NK_NAME);
-        label = name->content.value._wcs;
+        label = (une_symbol)name->content.value._id;
     }
 
     /* Execute function. */
@@ -1093,14 +1038,14 @@ une_interpreter__(une_interpret_for_range)
         step = -1;
 
     /* Get loop variable. */
-    wchar_t *name = node->content.branch.a->content.value._wcs;
-    une_association *var = une_variable_find_by_name_or_create(
-        felix->is.context, name); /* We only check the *local* variables. */
+    une_node *name = node->content.branch.a;
+    une_association *var = une_variable_find_by_node_or_create(
+        felix->is.context, name, false); /* We only check the *local* variables. */
 
     /* Loop. */
     for (une_int i = from; i != till; i += step) {
-        var = une_variable_find_by_name(felix->is.context,
-                                        name); /* Avoid stale pointer if variable buffer grows. */
+        var = une_variable_find_by_node(
+            felix->is.context, name, false); /* Avoid stale pointer if variable buffer grows. */
         une_result_free(var->content);
         var->content = (une_result){.kind = UNE_RK_INT, .value._int = i};
         result = une_result_dereference(une_interpret(node->content.branch.d));
@@ -1122,33 +1067,30 @@ une_interpreter__(une_interpret_for_element)
     une_result elements = une_result_dereference(une_interpret(node->content.branch.b));
     if (elements.kind == UNE_RK_ERROR)
         return elements;
-    une_type elements_type = UNE_TYPE_FOR_RESULT(elements);
-    if (!elements_type.get_len) {
+    if (!une_type_is_iterable(elements)) {
         une_result_free(elements);
         felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.b->pos);
         return une_result_create(UNE_RK_ERROR);
     }
-    une_int length = (une_int)elements_type.get_len(elements);
-    assert(elements_type.refer_to_index);
 
     /* Get loop variable. */
-    wchar_t *name = node->content.branch.a->content.value._wcs;
-    une_association *var = une_variable_find_by_name_or_create(
-        felix->is.context, name); /* We only check the *local* variables. */
+    une_node *name = node->content.branch.a;
+    une_association *var = une_variable_find_by_node_or_create(
+        felix->is.context, name, false); /* We only check the *local* variables. */
 
-    /* Prepare internal index. */
-    une_result index = une_result_create(UNE_RK_INT);
-    index.value._int = 0;
+    /* Prepare cursor. */
+    une_result cursor = une_type_begin(elements);
 
     /* Prepare result. */
     une_result result = une_result_create(UNE_RK_VOID);
 
     /* Loop. */
-    for (; index.value._int < length; index.value._int++) {
-        var = une_variable_find_by_name(felix->is.context,
-                                        name); /* Avoid stale pointer if variable buffer grows. */
+    une_result element;
+    while ((element = une_type_next(elements, &cursor)).kind != UNE_RK_none__) {
+        var = une_variable_find_by_node(
+            felix->is.context, name, false); /* Avoid stale pointer if variable buffer grows. */
         une_result_free(var->content);
-        var->content = une_result_dereference(elements_type.refer_to_index(elements, index));
+        var->content = element;
         une_result result_ = une_result_dereference(une_interpret(node->content.branch.c));
         if (result_.kind == UNE_RK_ERROR || felix->is.should_return || felix->is.should_exit) {
             result = result_;
@@ -1161,6 +1103,7 @@ une_interpreter__(une_interpret_for_element)
         une_result_free(result_);
     }
 
+    une_result_free(cursor);
     une_result_free(elements);
     return result;
 }
@@ -1343,22 +1286,15 @@ une_interpreter__(une_interpret_as, une_result_kind kind)
 une_interpreter__(une_interpret_seek_or_create, bool existing_only)
 {
     /* Extract information. */
-    wchar_t *name = node->content.branch.a->content.value._wcs;
+    une_node *name = node->content.branch.a;
     bool global = (une_node *)node->content.branch.b;
 
     /* Find variable. */
     une_association *var;
-    if (global) {
-        if (existing_only)
-            var = une_variable_find_by_name_global(felix->is.context, name);
-        else
-            var = une_variable_find_by_name_or_create_global(felix->is.context, name);
-    } else {
-        if (existing_only)
-            var = une_variable_find_by_name(felix->is.context, name);
-        else
-            var = une_variable_find_by_name_or_create(felix->is.context, name);
-    }
+    if (existing_only)
+        var = une_variable_find_by_node(felix->is.context, name, global);
+    else
+        var = une_variable_find_by_node_or_create(felix->is.context, name, global);
     if (var == NULL) {
         felix->error = UNE_ERROR_SET(UNE_EK_SYMBOL_NOT_DEFINED, node->content.branch.a->pos);
         return une_result_create(UNE_RK_ERROR);
@@ -1366,14 +1302,68 @@ une_interpreter__(une_interpret_seek_or_create, bool existing_only)
 
     /* Return reference to variable content. */
     return (une_result){.kind = UNE_RK_REFERENCE,
-                        .reference =
-                            (une_reference){.kind = UNE_FK_SINGLE, .root = (void *)&var->content}};
+                        .reference_kind = UNE_FK_SINGLE,
+                        .reference_root = (void *)&var->content};
 }
 
-une_interpreter__(une_interpret_idx_seek_index)
+une_interpreter__(une_interpret_member_access, bool for_writing)
 {
     /* Evaluate subject. */
-    une_result subject = une_interpret(node->content.branch.a);
+    une_result subject = for_writing ? une_interpret_assignee(node->content.branch.a)
+                                     : une_interpret(node->content.branch.a);
+    if (subject.kind == UNE_RK_ERROR)
+        return subject;
+    if (subject.kind != UNE_RK_REFERENCE && subject.kind != UNE_RK_OBJECT) {
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
+        une_result_free(subject);
+        return une_result_create(UNE_RK_ERROR);
+    }
+    if (subject.kind == UNE_RK_OBJECT) {
+        assert(felix->is.holding.blocks > 0);
+        une_result *object_container = une_interpreter_state_holding_add(&felix->is, subject);
+        subject = (une_result){.kind = UNE_RK_REFERENCE,
+                               .reference_kind = UNE_FK_SINGLE,
+                               .reference_root = (void *)object_container};
+    }
+
+    /* Get applicable type. */
+    une_type result_type = UNE_TYPE_FOR_RESULT(subject);
+
+    /* Check if subject supports members. */
+    if (!result_type.refer_to_member) {
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
+        une_result_free(subject);
+        return une_result_create(UNE_RK_ERROR);
+    }
+    assert(result_type.member_exists);
+
+    /* Extract member name. */
+    assert(node->content.branch.b->kind == UNE_NK_NAME);
+    une_symbol name = (une_symbol)node->content.branch.b->content.value._id;
+
+    /* Refer to member. */
+    if (!result_type.member_exists(subject, name)) {
+        felix->error = UNE_ERROR_SET(UNE_EK_SYMBOL_NOT_DEFINED, node->content.branch.b->pos);
+        une_result_free(subject);
+        return une_result_create(UNE_RK_ERROR);
+    }
+    if (for_writing)
+        une_result_unshare((une_result *)subject.reference_root);
+    une_result member = result_type.refer_to_member(subject, name);
+    assert(member.kind == UNE_RK_REFERENCE);
+
+    /* Register container as 'this' contestant. */
+    une_result_free(felix->is.this_contestant);
+    felix->is.this_contestant = subject;
+
+    return member;
+}
+
+une_interpreter__(une_interpret_idx_seek_index, bool for_writing)
+{
+    /* Evaluate subject. */
+    une_result subject = for_writing ? une_interpret_assignee(node->content.branch.a)
+                                     : une_interpret(node->content.branch.a);
     if (subject.kind == UNE_RK_ERROR)
         return subject;
 
@@ -1403,8 +1393,19 @@ une_interpreter__(une_interpret_idx_seek_index)
         return une_result_create(UNE_RK_ERROR);
     }
 
+    /* Get index if it is only read and the type can do so without copying it. */
+    une_result result;
+    if (!for_writing && result_type.get_index) {
+        result = result_type.get_index(subject, index);
+        une_result_free(subject);
+        une_result_free(index);
+        return result;
+    }
+
     /* Refer to index. */
-    une_result result = result_type.refer_to_index(subject, index);
+    if (for_writing && subject.kind == UNE_RK_REFERENCE && subject.reference_kind == UNE_FK_SINGLE)
+        une_result_unshare((une_result *)subject.reference_root);
+    result = result_type.refer_to_index(subject, index);
     assert(result.kind == UNE_RK_REFERENCE);
 
     /* If the subject was NOT a reference (i.e. we interpreted a literal), we need to dereference
@@ -1418,10 +1419,11 @@ une_interpreter__(une_interpret_idx_seek_index)
     return result;
 }
 
-une_interpreter__(une_interpret_idx_seek_range)
+une_interpreter__(une_interpret_idx_seek_range, bool for_writing)
 {
     /* Evaluate subject. */
-    une_result subject = une_interpret(node->content.branch.a);
+    une_result subject = for_writing ? une_interpret_assignee(node->content.branch.a)
+                                     : une_interpret(node->content.branch.a);
     if (subject.kind == UNE_RK_ERROR)
         return subject;
 
@@ -1429,7 +1431,7 @@ une_interpreter__(une_interpret_idx_seek_range)
     une_type result_type = UNE_TYPE_FOR_RESULT(subject);
 
     /* Check if subject supports referring to ranges. */
-    if (!result_type.refer_to_index) {
+    if (!result_type.refer_to_index || !result_type.is_valid_range) {
         felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
         une_result_free(subject);
         return une_result_create(UNE_RK_ERROR);
@@ -1458,9 +1460,39 @@ une_interpreter__(une_interpret_idx_seek_range)
         return une_result_create(UNE_RK_ERROR);
     }
 
+    /* Get range if it is only read and the type can do so without copying it. */
+    une_result result;
+    if (!for_writing && result_type.get_range) {
+        result = result_type.get_range(subject, begin, end);
+        une_result_free(subject);
+        une_result_free(begin);
+        une_result_free(end);
+        return result;
+    }
+
+    /* Check if subject supports referring to ranges. */
+    if (!result_type.refer_to_range) {
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
+        une_result_free(subject);
+        une_result_free(begin);
+        une_result_free(end);
+        return une_result_create(UNE_RK_ERROR);
+    }
+
     /* Refer to range. */
-    une_result result = result_type.refer_to_range(subject, begin, end);
-    assert(result.kind == UNE_RK_REFERENCE);
+    if (for_writing && subject.kind == UNE_RK_REFERENCE && subject.reference_kind == UNE_FK_SINGLE)
+        une_result_unshare((une_result *)subject.reference_root);
+    result = result_type.refer_to_range(subject, begin, end);
+
+    /* Ranges too wide to refer to are copied, which cannot be written to. */
+    if (result.kind != UNE_RK_REFERENCE && for_writing) {
+        une_result_free(result);
+        felix->error = UNE_ERROR_SET(UNE_EK_INDEX, node->content.branch.b->pos);
+        une_result_free(subject);
+        une_result_free(begin);
+        une_result_free(end);
+        return une_result_create(UNE_RK_ERROR);
+    }
 
     /* If the subject was NOT a reference (i.e. we interpreted a literal), we need to dereference
      * the retrieved data *now*, because the literal will be deleted upon completion of this
@@ -1474,6 +1506,54 @@ une_interpreter__(une_interpret_idx_seek_range)
     return result;
 }
 
+/*
+Evaluate the target of an assignment, giving every container on the way sole ownership of its
+storage, so that writing to it does not affect the results it was shared with.
+*/
+une_interpreter__(une_interpret_assignee)
+{
+    if (node->kind == UNE_NK_IDX_SEEK) {
+        if (node->content.branch.c)
+            return une_interpret_idx_seek_range(node, true);
+        return une_interpret_idx_seek_index(node, true);
+    }
+    if (node->kind == UNE_NK_MEMBER_SEEK)
+        return une_interpret_member_access(node, true);
+    return une_interpret(node);
+}
+
+/*
+Evaluate the arguments of a call into a list. A native that writes to its first argument receives a
+reference to it instead, which is resolved after the other arguments so that evaluating them cannot
+move what it refers to.
+*/
+une_interpreter__(une_interpret_arguments)
+{
+    une_node *callee = node->content.branch.a;
+    une_node *arguments = node->content.branch.b;
+    if (callee->kind != UNE_NK_NATIVE ||
+        !une_native_writes_to_argument((une_native)callee->content.value._int))
+        return une_interpret_list(arguments);
+
+    UNE_UNPACK_NODE_LIST(arguments, list, list_size);
+    une_result *result_list = une_result_list_create(list_size);
+    for (size_t i = 2; i <= list_size + 1; i++) {
+        size_t item = i <= list_size ? i : 1;
+        result_list[item] = item == 1 ? une_interpret_assignee(list[1])
+                                      : une_result_dereference(une_interpret(list[item]));
+        if (result_list[item].kind == UNE_RK_ERROR) {
+            une_result result = result_list[item];
+            /* Free the items before the error, which start at the second. */
+            for (size_t j = 2; j < i && j <= list_size; j++)
+                une_result_free(result_list[j]);
+            result_list[0].value._int = 0;
+            une_result_free((une_result){.kind = UNE_RK_LIST, .value._vp = (void *)result_list});
+            return result;
+        }
+    }
+    return (une_result){.kind = UNE_RK_LIST, .value._vp = (void *)result_list};
+}
+
 une_interpreter__(une_interpret_comparison, une_int (*comparator)(une_result, une_result))
 {
     /* Evaluate left branch. */
@@ -1482,17 +1562,15 @@ une_interpreter__(une_interpret_comparison, une_int (*comparator)(une_result, un
         une_interpret(une_node_unwrap_any_or_all(node->content.branch.a, &left_wrapped_as)));
     if (left.kind == UNE_RK_ERROR)
         return left;
-    if (left_wrapped_as != UNE_NK_none__ && !UNE_TYPE_FOR_RESULT(left).refer_to_index) {
+    if (left_wrapped_as != UNE_NK_none__ && !une_type_has_elements(left)) {
         une_result_free(left);
         felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
         return une_result_create(UNE_RK_ERROR);
     }
     if (left_wrapped_as == UNE_NK_none__)
         left = une_result_wrap_in_list(left);
-    une_type left_type = UNE_TYPE_FOR_RESULT(left);
-    assert(left_type.refer_to_index);
-    assert(left_type.get_len);
-    size_t left_length = left_type.get_len(left);
+    assert(une_type_has_elements(left));
+    size_t left_length = UNE_TYPE_FOR_RESULT(left).get_len(left);
 
     /* Evaluate right branch. */
     une_node_kind right_wrapped_as = UNE_NK_none__;
@@ -1502,7 +1580,7 @@ une_interpreter__(une_interpret_comparison, une_int (*comparator)(une_result, un
         une_result_free(left);
         return right;
     }
-    if (right_wrapped_as != UNE_NK_none__ && !UNE_TYPE_FOR_RESULT(right).refer_to_index) {
+    if (right_wrapped_as != UNE_NK_none__ && !une_type_has_elements(right)) {
         une_result_free(left);
         une_result_free(right);
         felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.b->pos);
@@ -1510,10 +1588,8 @@ une_interpreter__(une_interpret_comparison, une_int (*comparator)(une_result, un
     }
     if (right_wrapped_as == UNE_NK_none__)
         right = une_result_wrap_in_list(right);
-    une_type right_type = UNE_TYPE_FOR_RESULT(right);
-    assert(right_type.refer_to_index);
-    assert(right_type.get_len);
-    size_t right_length = right_type.get_len(right);
+    assert(une_type_has_elements(right));
+    size_t right_length = UNE_TYPE_FOR_RESULT(right).get_len(right);
 
     /* Compare. */
     bool kind_error = false;
@@ -1523,8 +1599,8 @@ une_interpreter__(une_interpret_comparison, une_int (*comparator)(une_result, un
     for (i.value._int = 0; i.value._int < (une_int)left_length; i.value._int++) {
         une_int partial_matches = 0;
         for (j.value._int = 0; j.value._int < (une_int)right_length; j.value._int++) {
-            une_result left_element = une_result_dereference(left_type.refer_to_index(left, i));
-            une_result right_element = une_result_dereference(right_type.refer_to_index(right, j));
+            une_result left_element = une_type_get_element(left, i);
+            une_result right_element = une_type_get_element(right, j);
             une_int match = comparator(left_element, right_element);
             une_result_free(left_element);
             une_result_free(right_element);
@@ -92,8 +92,11 @@ une_interpreter__(une_interpret_this);
 
 une_interpreter__(une_interpret_as, une_result_kind kind);
 une_interpreter__(une_interpret_seek_or_create, bool existing_only);
-une_interpreter__(une_interpret_idx_seek_index);
-une_interpreter__(une_interpret_idx_seek_range);
+une_interpreter__(une_interpret_idx_seek_index, bool for_writing);
+une_interpreter__(une_interpret_idx_seek_range, bool for_writing);
+une_interpreter__(une_interpret_member_access, bool for_writing);
+une_interpreter__(une_interpret_assignee);
+une_interpreter__(une_interpret_arguments);
 une_interpreter__(une_interpret_comparison, une_int (*comparator)(une_result, une_result));
 
 #endif /* !UNE_INTERPRETER_H */
@@ -6,7 +6,7 @@ lexer.c - Une
 #include "lexer.h"
 
 /* Implementation-specific includes. */
-#include "natives.h"
+#include "struct/engine.h"
 #include "tools.h"
 #include <string.h>
 
@@ -184,13 +184,13 @@ une_lexer__(une_lex_number, bool allow_signed)
     if (has_exponent) {
         if (!une_lex_number_exponent(error, ls, &exponent))
             return une_token_create(UNE_TK_none__);
-        if (!is_floating) {
-            is_floating = true;
-            floating = (une_flt)integer;
-        }
-        floating *= une_flt_pow(UNE_NEW_FLT(10.0), (une_flt)exponent);
+        is_floating = true;
     }
 
+    /* Decimal numbers are converted from their text, which rounds correctly. */
+    if (is_floating && base == 10)
+        floating = une_decimal_wcs_to_une_flt(ls->text + start_index, ls->text_index - start_index);
+
     une_token number = {
         .kind = is_floating ? UNE_TK_FLT : UNE_TK_INT,
         .pos = (une_position){.start = start_index, .end = ls->text_index, .line = ls->line}};
@@ -365,19 +365,12 @@ une_lexer__(une_lex_keyword_or_name)
             tk.kind = kind;
             goto keyword_or_name_defined;
         }
-    une_native native = une_native_wcs_to_function(buffer);
-    if (native != UNE_NATIVE_none__) {
-        tk.kind = UNE_TK_NATIVE;
-        tk.value._int = (une_int)native;
-        goto keyword_or_name_defined;
-    }
     tk.kind = UNE_TK_NAME;
-    tk.value._wcs = buffer;
+    tk.value._id = une_symbols_intern(&felix->symbols, buffer);
 
 /* Finalize token. */
 keyword_or_name_defined:
-    if (tk.kind != UNE_TK_NAME)
-        free(buffer);
+    free(buffer);
     tk.pos = (une_position){.start = idx_start, .end = ls->text_index, .line = ls->line};
 
     return tk;
@@ -441,8 +434,7 @@ bool une_lex_number_integer(une_error *error,
                                                    .line = ls->line}));
             return false;
         }
-        *integer *= base;
-        *integer += digit_in_decimal;
+        *integer = (une_int)((une_uint)*integer * (une_uint)base + (une_uint)digit_in_decimal);
         une_lexer_advance(ls);
     }
 
@@ -464,6 +456,7 @@ bool une_lex_number_fractional_part(une_error *error,
     assert(une_lexer_now(ls) == L'.' && une_lexer_peek(ls, 1) != L'.');
     une_lexer_advance(ls); /* Radix point. */
 
+    size_t index_start = ls->text_index;
     une_flt floating_divisor = 1;
     int digit_in_decimal;
 
@@ -478,13 +471,16 @@ bool une_lex_number_fractional_part(une_error *error,
                                                    .line = ls->line}));
             return false;
         }
-        floating_divisor *= base;
-        *floating += digit_in_decimal / floating_divisor;
+        /* une_lex_number converts decimal numbers from their text. */
+        if (base != 10) {
+            floating_divisor *= base;
+            *floating += digit_in_decimal / floating_divisor;
+        }
         une_lexer_advance(ls);
     }
 
     /* Missing fraction. */
-    if (floating_divisor <= 1) {
+    if (ls->text_index == index_start) {
         *error = UNE_ERROR_SET(
             UNE_EK_SYNTAX,
             ((une_position){.start = ls->text_index, .end = ls->text_index + 1, .line = ls->line}));
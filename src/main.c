@@ -54,7 +54,31 @@ int main(int argc, char *argv[])
     bool show_usage = argc <= 1;
     int arg = 1;
     while (arg < argc) {
-        if (!strcmp(argv[arg], UNE_SWITCH_INTERACTIVE)) {
+        if (!strcmp(argv[arg], UNE_SWITCH_TREE)) {
+            ++arg;
+            if (argc <= arg) {
+                show_usage = true;
+                break;
+            }
+            felix->mode = UNE_EM_TREE;
+        } else if (!strcmp(argv[arg], UNE_SWITCH_NO_OPTIMIZE)) {
+            ++arg;
+            if (argc <= arg) {
+                show_usage = true;
+                break;
+            }
+            felix->optimizes = false;
+        } else if (!strcmp(argv[arg], UNE_SWITCH_DEPTH_LIMIT)) {
+            ++arg;
+            char *end = NULL;
+            if (argc > arg)
+                felix->depth_limit = (size_t)strtoull(argv[arg], &end, 10);
+            ++arg;
+            if (argc <= arg || end == argv[arg - 1] || *end != '\0' || felix->depth_limit == 0) {
+                show_usage = true;
+                break;
+            }
+        } else if (!strcmp(argv[arg], UNE_SWITCH_INTERACTIVE)) {
             ++arg;
             interactive();
             result = (une_result){.kind = UNE_RK_INT, .value._int = EXIT_SUCCESS};
@@ -88,9 +112,6 @@ int main(int argc, char *argv[])
         print_usage(argv[0]);
     }
 
-    /* Free engine. */
-    une_engine_free();
-
 #if defined(UNE_DEBUG) && defined(UNE_DISPLAY_RESULT)
     if (result.kind != UNE_RK_ERROR) {
         assert(UNE_RESULT_KIND_IS_TYPE(result.kind));
@@ -120,6 +141,9 @@ int main(int argc, char *argv[])
         final = EXIT_SUCCESS;
     une_result_free(result);
 
+    /* Free engine. The result may refer to its symbols, so this happens last. */
+    une_engine_free();
+
 #if defined(UNE_DEBUG) && defined(UNE_DBG_REPORT)
 #ifdef UNE_DBG_MEMDBG
     extern int64_t memdbg_allocations_count;
@@ -180,7 +204,7 @@ void interactive(void)
         } else if (!wcscmp(stmts, L"#inspect\n")) {
             /* Modules. */
             fputws(L"--- modules ---\n", stdout);
-            for (size_t i = 0; i < felix->is.modules.size; i++) {
+            for (size_t i = 0; i < felix->is.modules.count; i++) {
                 une_module module = felix->is.modules.buffer[i];
                 if (module.id == 0)
                     continue;
@@ -195,7 +219,7 @@ void interactive(void)
 
             /* Callables. */
             fputws(L"--- callables ---\n", stdout);
-            for (size_t i = 0; i < felix->is.callables.size; i++) {
+            for (size_t i = 0; i < felix->is.callables.count; i++) {
                 une_callable callable = felix->is.callables.buffer[i];
                 if (callable.id == 0)
                     continue;
@@ -207,9 +231,11 @@ void interactive(void)
                          callable.position.start,
                          callable.position.end);
                 if (callable.parameters.count) {
-                    fputws(callable.parameters.names[0], stdout);
+                    fputws(une_symbols_name(&felix->symbols, callable.parameters.names[0]), stdout);
                     for (size_t j = 1; j < callable.parameters.count; j++) {
-                        fwprintf(stdout, L", %ls", callable.parameters.names[j]);
+                        fwprintf(stdout,
+                                 L", %ls",
+                                 une_symbols_name(&felix->symbols, callable.parameters.names[j]));
                     }
                 }
                 fputws(L")\n", stdout);
@@ -218,7 +244,8 @@ void interactive(void)
             /* Symbols. */
             fputws(L"--- symbols ---\n", stdout);
             for (size_t i = 0; i < felix->is.context->variables.count; i++) {
-                fputws(felix->is.context->variables.buffer[i]->name, stdout);
+                fputws(une_symbols_name(&felix->symbols, felix->is.context->variables.buffer[i]->name),
+                       stdout);
                 if (felix->is.context->variables.buffer[i]->content.kind == UNE_RK_FUNCTION) {
                     une_callable *callable = une_callables_get_callable_by_id(
                         felix->is.callables,
@@ -228,6 +255,13 @@ void interactive(void)
                 }
                 fputwc(L'\n', stdout);
             }
+
+            /* Quickening. */
+            fputws(L"--- quickening ---\n", stdout);
+            fwprintf(stdout,
+                     L"%zu quickened, %zu deoptimized\n",
+                     felix->quickened,
+                     felix->deoptimized);
             continue;
         }
 
@@ -7,6 +7,7 @@ natives.c - Une
 
 /* Implementation-specific includes. */
 #include "deprecated/stream.h"
+#include "struct/callable.h"
 #include "struct/engine.h"
 #include "tools.h"
 #include "types/types.h"
@@ -50,8 +51,29 @@ const size_t une_natives_params_count[] = {
     2, /* split */
     1, /* eval */
     3, /* replace */
+    2, /* find */
+    2, /* contains */
+    2, /* count */
     2, /* join */
     2, /* sort */
+    2, /* push */
+    1, /* pop */
+    3, /* insert */
+    2, /* remove */
+    1, /* array */
+    1, /* list */
+    1, /* sum */
+    1, /* min */
+    1, /* max */
+    2, /* dot */
+    1, /* map */
+    2, /* get */
+    3, /* set */
+    2, /* has */
+    2, /* delete */
+    1, /* keys */
+    1, /* values */
+    3, /* range */
     0, /* getcwd */
     1, /* setcwd */
     1, /* playwav */
@@ -70,6 +92,25 @@ size_t une_native_params_count(une_native function)
     return une_natives_params_count[function - 1];
 }
 
+/*
+Check whether a native function writes to its first argument, which it then receives as a reference.
+*/
+bool une_native_writes_to_argument(une_native function)
+{
+    assert(UNE_NATIVE_IS_VALID(function));
+    switch (function) {
+    case UNE_NATIVE_push:
+    case UNE_NATIVE_pop:
+    case UNE_NATIVE_insert:
+    case UNE_NATIVE_remove:
+    case UNE_NATIVE_set:
+    case UNE_NATIVE_delete:
+        return true;
+    default:
+        return false;
+    }
+}
+
 /*
 Get the function pointer for a native-in function.
 */
@@ -80,17 +121,24 @@ une_native_fnptr une_native_to_fnptr(une_native function)
 }
 
 /*
-Get a pointer to the native function matching the given string or NULL;
+Intern the names of all native functions, so that the symbol of each name equals its une_native.
+This must happen before any other name is interned.
 */
-une_native une_native_wcs_to_function(wchar_t *wcs)
+void une_native_intern_names(une_symbols *symbols)
 {
-    une_native fn = UNE_NATIVE_none__;
-    for (une_native i = 1; i < UNE_NATIVE_max__; i++)
-        if (wcscmp(une_natives_as_strings[i - 1], wcs) == 0) {
-            fn = i;
-            break;
-        }
-    return fn;
+    for (une_native i = 1; i < UNE_NATIVE_max__; i++) {
+        une_symbol symbol = une_symbols_intern(symbols, (wchar_t *)une_natives_as_strings[i - 1]);
+        assert(symbol == (une_symbol)i);
+        (void)symbol;
+    }
+}
+
+/*
+Get the native function named by a symbol, or UNE_NATIVE_none__ if there is none.
+*/
+une_native une_native_symbol_to_function(une_symbol symbol)
+{
+    return symbol < UNE_NATIVE_max__ ? (une_native)symbol : UNE_NATIVE_none__;
 }
 
 /*
@@ -243,12 +291,8 @@ une_native_fn__(chr)
         return une_result_create(UNE_RK_ERROR);
     }
 
-    une_result chr = une_result_create(UNE_RK_STR);
-    chr.value._wcs = malloc(2 * sizeof(*chr.value._wcs));
-    verify(chr.value._wcs);
-    chr.value._wcs[0] = (wchar_t)args[result].value._int;
-    chr.value._wcs[1] = L'\0';
-    return chr;
+    wchar_t character = (wchar_t)args[result].value._int;
+    return une_type_str_from_wcs_with_length(&character, 1);
 }
 
 /*
@@ -259,13 +303,13 @@ une_native_fn__(ord)
     une_native_param result = 0;
 
     /* Ensure input une_result_kind is UNE_RK_STR and is only one character long. */
-    if (args[result].kind != UNE_RK_STR || wcslen(args[result].value._wcs) != 1) {
+    if (args[result].kind != UNE_RK_STR || une_type_str_get_len(args[result]) != 1) {
         felix->error = UNE_ERROR_SET(UNE_EK_TYPE, UNE_NATIVE_POS_OF_ARG(result));
         return une_result_create(UNE_RK_ERROR);
     }
 
     une_result ord = une_result_create(UNE_RK_INT);
-    ord.value._int = (une_int)args[result].value._wcs[0];
+    ord.value._int = (une_int)UNE_STR_CHARACTER(UNE_STR(args[result]), 0);
     return ord;
 }
 
@@ -279,7 +323,7 @@ une_native_fn__(read)
     UNE_NATIVE_VERIFY_ARG_KIND(file, UNE_RK_STR);
 
     /* Check if file exists. */
-    char *path = une_wcs_to_str(args[file].value._wcs);
+    char *path = une_type_str_to_str(args[file]);
     if (path == NULL) {
         felix->error = UNE_ERROR_SET(UNE_EK_ENCODING, UNE_NATIVE_POS_OF_ARG(file));
         return une_result_create(UNE_RK_ERROR);
@@ -291,10 +335,10 @@ une_native_fn__(read)
     }
 
     /* Read file. */
-    une_result str = une_result_create(UNE_RK_STR);
-    str.value._wcs = une_file_read(path, true, 0);
-    assert(str.value._wcs != NULL);
+    une_result str = une_type_str_from_file(path);
     free(path);
+    if (str.kind == UNE_RK_ERROR)
+        felix->error = UNE_ERROR_SET(UNE_EK_FILE, UNE_NATIVE_POS_OF_ARG(file));
     return str;
 }
 
@@ -310,7 +354,7 @@ une_result une_native_fn_write_or_append(une_node *call_node, une_result *args,
     UNE_NATIVE_VERIFY_ARG_KIND(text, UNE_RK_STR);
 
     /* Create file. */
-    char *path = une_wcs_to_str(args[file].value._wcs);
+    char *path = une_type_str_to_str(args[file]);
     if (path == NULL) {
         felix->error = UNE_ERROR_SET(UNE_EK_ENCODING, UNE_NATIVE_POS_OF_ARG(file));
         return une_result_create(UNE_RK_ERROR);
@@ -323,7 +367,7 @@ une_result une_native_fn_write_or_append(une_node *call_node, une_result *args,
     }
 
     /* Print text. */
-    fputws(args[text].value._wcs, fp);
+    une_type_str_represent(fp, args[text]);
     fclose(fp);
     return une_result_create(UNE_RK_VOID);
 }
@@ -363,10 +407,7 @@ une_native_fn__(input)
     instr[--len] = L'\0'; /* Remove trailing newline. */
 
     /* Return result. */
-    une_result str = une_result_create(UNE_RK_STR);
-    str.value._wcs = malloc((len + 1) * sizeof(*str.value._wcs));
-    verify(str.value._wcs);
-    wcscpy(str.value._wcs, instr);
+    une_result str = une_type_str_from_wcs(instr);
     free(instr);
     return str;
 }
@@ -381,7 +422,7 @@ une_native_fn__(script)
     UNE_NATIVE_VERIFY_ARG_KIND(script, UNE_RK_STR);
 
     /* Check if file exists. */
-    char *path = une_wcs_to_str(args[script].value._wcs);
+    char *path = une_type_str_to_str(args[script]);
     if (path == NULL) {
         felix->error = UNE_ERROR_SET(UNE_EK_ENCODING, UNE_NATIVE_POS_OF_ARG(script));
         return une_result_create(UNE_RK_ERROR);
@@ -409,7 +450,7 @@ une_native_fn__(exist)
     UNE_NATIVE_VERIFY_ARG_KIND(path, UNE_RK_STR);
 
     /* Check if file or folder exists. */
-    char *path_str = une_wcs_to_str(args[path].value._wcs);
+    char *path_str = une_type_str_to_str(args[path]);
     if (path_str == NULL) {
         felix->error = UNE_ERROR_SET(UNE_EK_ENCODING, UNE_NATIVE_POS_OF_ARG(path));
         return une_result_create(UNE_RK_ERROR);
@@ -435,7 +476,7 @@ une_native_fn__(split)
     UNE_UNPACK_RESULT_LIST(args[delims], delims_p, delims_len);
     UNE_FOR_RESULT_LIST_ITEM(i, delims_len)
     {
-        if (delims_p[i].kind != UNE_RK_STR || wcslen(delims_p[i].value._wcs) <= 0) {
+        if (delims_p[i].kind != UNE_RK_STR || une_type_str_get_len(delims_p[i]) == 0) {
             felix->error = UNE_ERROR_SET(UNE_EK_TYPE, UNE_NATIVE_POS_OF_ARG(delims));
             return une_result_create(UNE_RK_ERROR);
         }
@@ -450,57 +491,52 @@ une_native_fn__(split)
     tokens = NULL; /* This pointer can turn stale after pushing. */
     void (*push)(une_ostream *, une_result) = &une_native_split_push__;
     push(&out, une_result_create(UNE_RK_SIZE));
-    /* Cache delimiter lengths for performance. */
+    /* Cache delimiter lengths and the next occurrence of each delimiter. */
     size_t *delim_lens = malloc(delims_len * sizeof(*delim_lens));
     verify(delim_lens);
-    for (size_t i = 0; i < delims_len; i++)
-        delim_lens[i] = wcslen(delims_p[i + 1].value._wcs);
-    wchar_t *wcs = args[string].value._wcs;
-    size_t wcs_len = wcslen(wcs);
-    size_t last_token_end = 0;
-    size_t left_for_match = 0;
-
-    /* Create tokens. */
-    for (size_t i = 0; i < wcs_len; i++) { /* For each character. */
-        for (size_t delim = 0; delim < delims_len; delim++) { /* For each delimiter. */
-            left_for_match = delim_lens[delim];
-            for (size_t delim_i = 0; delim_i < delim_lens[delim];
-                 delim_i++) { /* For each character in the delimiter. */
-                if (i + delim_i >= wcs_len ||
-                    wcs[i + delim_i] != delims_p[delim + 1].value._wcs[delim_i])
-                    break;
-                left_for_match--;
-            }
-            if (left_for_match != 0 && i + 1 == wcs_len) { /* Special case for end of string. */
-                i++;
-                left_for_match = 0;
-            }
-            if (left_for_match == 0) { /* All characters have been matched. */
-                size_t last_token_end_cpy = last_token_end;
-                size_t substr_len = i - last_token_end_cpy;
-                i += delim_lens[delim] - 1 /* Compensate for next i++. */;
-                last_token_end = i + 1; /* last_token_end is not incremented next loop. */
-                /* Break if there was no token before this delimiter. */
-                if (substr_len == 0)
-                    break;
-                /* Create substring. */
-                wchar_t *substr = malloc((substr_len + 1) * sizeof(*substr));
-                verify(substr);
-                wmemcpy(substr, wcs + last_token_end_cpy, substr_len);
-                substr[substr_len] = L'\0';
-                /* Push substring. */
-                push(&out, (une_result){.kind = UNE_RK_STR, .value._wcs = substr});
-                tokens_amt++;
-                break;
+    size_t *delim_next = malloc(delims_len * sizeof(*delim_next));
+    verify(delim_next);
+    for (size_t i = 0; i < delims_len; i++) {
+        delim_lens[i] = une_type_str_get_len(delims_p[i + 1]);
+        delim_next[i] = une_type_str_find(args[string], delims_p[i + 1], 0);
+    }
+    size_t string_len = une_type_str_get_len(args[string]);
+    size_t token_begin = 0;
+
+    /* Create tokens, splitting at the earliest delimiter (or the first listed among those that
+    start at the same position). */
+    while (true) {
+        size_t split_at = UNE_STR_NOT_FOUND;
+        size_t split_delim = 0;
+        for (size_t delim = 0; delim < delims_len; delim++) {
+            if (delim_next[delim] != UNE_STR_NOT_FOUND && delim_next[delim] < token_begin)
+                delim_next[delim] =
+                    une_type_str_find(args[string], delims_p[delim + 1], token_begin);
+            if (delim_next[delim] < split_at) {
+                split_at = delim_next[delim];
+                split_delim = delim;
             }
         }
+        size_t token_end = split_at == UNE_STR_NOT_FOUND ? string_len : split_at;
+        /* Skip empty tokens. */
+        if (token_end > token_begin) {
+            push(&out,
+                 une_type_str_substring(args[string], token_begin, token_end - token_begin));
+            tokens_amt++;
+        }
+        if (split_at == UNE_STR_NOT_FOUND)
+            break;
+        token_begin = split_at + delim_lens[split_delim];
     }
 
     /* Wrap up. */
     free(delim_lens);
+    free(delim_next);
     tokens = (une_result *)out.array; /* Reobtain up-to-date pointer. */
-    tokens[0].value._int = (une_int)tokens_amt;
-    return (une_result){.kind = UNE_RK_LIST, .value._vp = (void *)tokens};
+    une_result *list = une_result_list_create(tokens_amt);
+    memcpy(list + 1, tokens + 1, tokens_amt * sizeof(*list));
+    free(tokens);
+    return (une_result){.kind = UNE_RK_LIST, .value._vp = (void *)list};
 }
 
 /*
@@ -513,8 +549,9 @@ une_native_fn__(eval)
     UNE_NATIVE_VERIFY_ARG_KIND(script, UNE_RK_STR);
 
     /* Run script. */
-    une_result out = une_engine_interpret_file_or_wcs_with_position(
-        NULL, args[script].value._wcs, call_node->pos);
+    wchar_t *wcs = une_type_str_to_wcs(args[script]);
+    une_result out = une_engine_interpret_file_or_wcs_with_position(NULL, wcs, call_node->pos);
+    free(wcs);
 
     return out;
 }
@@ -532,37 +569,118 @@ une_native_fn__(replace)
     UNE_NATIVE_VERIFY_ARG_KIND(replace_arg, UNE_RK_STR);
     UNE_NATIVE_VERIFY_ARG_KIND(subject_arg, UNE_RK_STR);
 
-    wchar_t *search = args[search_arg].value._wcs;
-    wchar_t *replace = args[replace_arg].value._wcs;
-    wchar_t *subject = args[subject_arg].value._wcs;
+    une_str *replace = UNE_STR(args[replace_arg]);
+    une_str *subject = UNE_STR(args[subject_arg]);
+    bool replace_is_narrow = replace->is_narrow;
+    bool subject_is_narrow = subject->is_narrow;
 
-    size_t search_len = wcslen(search);
+    size_t search_len = une_type_str_get_len(args[search_arg]);
     if (!search_len) {
         felix->error = UNE_ERROR_SET(UNE_EK_ENCODING, UNE_NATIVE_POS_OF_ARG(search_arg));
         return une_result_create(UNE_RK_ERROR);
     }
-    size_t replace_len = wcslen(replace);
-    size_t subject_len = wcslen(subject);
-    size_t new_size = subject_len * (replace_len || 1) + 1;
+    size_t replace_len = une_type_str_get_len(args[replace_arg]);
+    size_t subject_len = une_type_str_get_len(args[subject_arg]);
+
+    /* Find matches first to allocate exactly the memory needed. */
+    size_t matches_count = 0, matches_size = UNE_SIZE_BIF_REPLACE_MATCHES;
+    size_t *matches = malloc(matches_size * sizeof(*matches));
+    verify(matches);
+    for (size_t match = une_type_str_find(args[subject_arg], args[search_arg], 0);
+         match != UNE_STR_NOT_FOUND;
+         match = une_type_str_find(args[subject_arg], args[search_arg], match + search_len)) {
+        if (matches_count >= matches_size) {
+            matches_size *= 2;
+            matches = realloc(matches, matches_size * sizeof(*matches));
+            verify(matches);
+        }
+        matches[matches_count++] = match;
+    }
+    if (matches_count == 0) {
+        free(matches);
+        return une_result_copy(args[subject_arg]);
+    }
+    une_str *new = une_type_str_create(
+        subject_len - matches_count * search_len + matches_count * replace_len,
+        replace_is_narrow && subject_is_narrow);
+
+    /* Create new string, copying the characters between matches at once. */
+    size_t character_size = subject_is_narrow ? sizeof(unsigned char) : sizeof(wchar_t);
+    size_t new_idx = 0, unmatched_idx = 0;
+    for (size_t i = 0; i <= matches_count; i++) {
+        size_t match = i < matches_count ? matches[i] : subject_len;
+        une_type_str_write(new,
+                           new_idx,
+                           (char *)subject->characters + unmatched_idx * character_size,
+                           subject_is_narrow,
+                           match - unmatched_idx);
+        new_idx += match - unmatched_idx;
+        if (i == matches_count)
+            break;
+        une_type_str_write(new, new_idx, replace->characters, replace_is_narrow, replace_len);
+        new_idx += replace_len;
+        unmatched_idx = match + search_len;
+    }
+    assert(new_idx == new->length);
+    free(matches);
 
-    /* Allocate memory for new string. */
-    wchar_t *new = malloc(new_size * sizeof(*new));
+    return (une_result){.kind = UNE_RK_STR, .value._vp = new};
+}
 
-    /* Create new string. */
-    size_t new_idx = 0, subject_idx = 0;
-    while (subject_idx < subject_len)
-        if (wcsncmp(subject + subject_idx, search, search_len) == 0) {
-            subject_idx += search_len;
-            wcsncpy(new + new_idx, replace, replace_len);
-            new_idx += replace_len;
-        } else {
-            new[new_idx++] = subject[subject_idx++];
-        }
-    new[new_idx] = L'\0';
+/*
+Return the index of the first occurrence of string 'search' in string 'text', or -1.
+*/
+une_native_fn__(find)
+{
+    une_native_param text = 0;
+    une_native_param search = 1;
 
-    une_result result = une_result_create(UNE_RK_STR);
-    result.value._wcs = new;
-    return result;
+    UNE_NATIVE_VERIFY_ARG_KIND(text, UNE_RK_STR);
+    UNE_NATIVE_VERIFY_ARG_KIND(search, UNE_RK_STR);
+
+    size_t index = une_type_str_find(args[text], args[search], 0);
+    return (une_result){.kind = UNE_RK_INT,
+                        .value._int = index == UNE_STR_NOT_FOUND ? -1 : (une_int)index};
+}
+
+/*
+Check if string 'text' contains string 'search'.
+*/
+une_native_fn__(contains)
+{
+    une_native_param text = 0;
+    une_native_param search = 1;
+
+    UNE_NATIVE_VERIFY_ARG_KIND(text, UNE_RK_STR);
+    UNE_NATIVE_VERIFY_ARG_KIND(search, UNE_RK_STR);
+
+    size_t index = une_type_str_find(args[text], args[search], 0);
+    return (une_result){.kind = UNE_RK_INT, .value._int = index != UNE_STR_NOT_FOUND};
+}
+
+/*
+Count the non-overlapping occurrences of string 'search' in string 'text'.
+*/
+une_native_fn__(count)
+{
+    une_native_param text = 0;
+    une_native_param search = 1;
+
+    UNE_NATIVE_VERIFY_ARG_KIND(text, UNE_RK_STR);
+    UNE_NATIVE_VERIFY_ARG_KIND(search, UNE_RK_STR);
+
+    /* The empty string occurs before every character and at the end, matching find(). */
+    size_t search_len = une_type_str_get_len(args[search]);
+    if (!search_len)
+        return (une_result){.kind = UNE_RK_INT,
+                            .value._int = (une_int)une_type_str_get_len(args[text]) + 1};
+
+    une_int count = 0;
+    for (size_t match = une_type_str_find(args[text], args[search], 0);
+         match != UNE_STR_NOT_FOUND;
+         match = une_type_str_find(args[text], args[search], match + search_len))
+        count++;
+    return (une_result){.kind = UNE_RK_INT, .value._int = count};
 }
 
 /*
@@ -583,99 +701,587 @@ une_native_fn__(join)
     UNE_NATIVE_VERIFY_ARG_KIND(seperator, UNE_RK_STR);
 
     /* Prepare lengths and sizes. */
-    size_t seperator_length = wcslen(args[seperator].value._wcs);
-    size_t joined_length = (count > 1 ? count - 1 : 0) * seperator_length;
+    une_str *seperator_str = UNE_STR(args[seperator]);
+    size_t joined_length = (count > 1 ? count - 1 : 0) * seperator_str->length;
+    bool is_narrow = seperator_str->is_narrow;
     UNE_FOR_RESULT_LIST_ITEM(i, count)
-    joined_length += wcslen(elements[i].value._wcs);
-    wchar_t *joined_string = malloc((joined_length + 1) * sizeof(*joined_string));
-    verify(joined_string);
+    {
+        joined_length += UNE_STR(elements[i])->length;
+        is_narrow = is_narrow && UNE_STR(elements[i])->is_narrow;
+    }
+    une_str *joined_string = une_type_str_create(joined_length, is_narrow);
 
     /* Assemble string. */
-    joined_string[0] = L'\0';
+    size_t offset = 0;
     UNE_FOR_RESULT_LIST_ITEM(i, count)
     {
-        wcscat(joined_string, elements[i].value._wcs);
-        if (i < count)
-            wcscat(joined_string, args[seperator].value._wcs);
+        une_str *element = UNE_STR(elements[i]);
+        une_type_str_write(
+            joined_string, offset, element->characters, element->is_narrow, element->length);
+        offset += element->length;
+        if (i < count) {
+            une_type_str_write(joined_string,
+                               offset,
+                               seperator_str->characters,
+                               seperator_str->is_narrow,
+                               seperator_str->length);
+            offset += seperator_str->length;
+        }
     }
-    joined_string[joined_length] = L'\0';
+    assert(offset == joined_length);
 
-    une_result result = une_result_create(UNE_RK_STR);
-    result.value._wcs = joined_string;
-    return result;
+    return (une_result){.kind = UNE_RK_STR, .value._vp = joined_string};
 }
 
-static une_error *sort_error = NULL;
-static une_node *sort_call_node = NULL;
-static une_result sort_comparator = {.kind = UNE_RK_none__};
+/*
+An item of a list being sorted and the key it is ordered by.
+*/
+typedef struct sort_entry_
+{
+    une_result key;
+    une_result item;
+} sort_entry;
 
-static int sort_compare(const void *a, const void *b)
+/*
+Everything a sort needs to compare two entries.
+*/
+typedef struct sort_state_
 {
-    assert(sort_error);
-    /* Avoid repeated traceback. */
-    if (sort_error->kind != UNE_EK_none__)
-        return 0;
+    une_node *call_node;
+    une_result comparator;
+    une_result comparator_args;
+} sort_state;
 
-    assert(sort_call_node);
-    une_type comparator_type = UNE_TYPE_FOR_RESULT(sort_comparator);
-    assert(comparator_type.call);
+/*
+Length of the runs sorted by insertion before they are merged.
+*/
+#define SORT_RUN_LENGTH 16
 
-    une_result *subjects = une_result_list_create(2);
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wcast-qual"
-    subjects[1] = une_result_copy(*(une_result *)a);
-    subjects[2] = une_result_copy(*(une_result *)b);
-#pragma clang diagnostic pop
-    une_result comparator_args = une_result_create(UNE_RK_LIST);
-    comparator_args.value._vp = (void *)subjects;
+/*
+Check if left must come before right. If a comparator is given, it is called with the items as
+borrowed arguments. Otherwise, the keys are compared using the '<' operator. After an error, every
+entry is considered in order, so the sort finishes without making further calls.
+*/
+static bool sort_is_less(sort_state *state, sort_entry *left, sort_entry *right)
+{
+    if (felix->error.kind != UNE_EK_none__)
+        return false;
+
+    if (state->comparator.kind == UNE_RK_none__) {
+        une_int is_less = une_result_lss_result(left->key, right->key);
+        if (is_less == -1)
+            felix->error = UNE_ERROR_SET(UNE_EK_TYPE, state->call_node->pos);
+        return is_less == 1;
+    }
 
-    une_result result =
-        comparator_type.call(sort_call_node, sort_comparator, comparator_args, NULL);
-    int rating = 0;
+    une_result *comparator_args = (une_result *)state->comparator_args.value._vp;
+    comparator_args[1] = left->item;
+    comparator_args[2] = right->item;
+    une_result result = UNE_TYPE_FOR_RESULT(state->comparator)
+                            .call(state->call_node,
+                                  state->comparator,
+                                  state->comparator_args,
+                                  UNE_SYMBOL_NONE);
+    bool is_less = false;
     if (result.kind == UNE_RK_INT)
-        rating = result.value._int > 0 ? 1 : result.value._int < 0 ? -1 : 0;
+        is_less = result.value._int < 0;
     else if (result.kind != UNE_RK_ERROR)
-        *sort_error = UNE_ERROR_SET(UNE_EK_TYPE, sort_call_node->pos);
-
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, state->call_node->pos);
     une_result_free(result);
-    une_result_free(comparator_args);
+    return is_less;
+}
+
+/*
+Merge the sorted runs left and right into destination, keeping entries that are in order in their
+original order.
+*/
+static void sort_merge(sort_state *state,
+                       sort_entry *left,
+                       size_t left_count,
+                       sort_entry *right,
+                       size_t right_count,
+                       sort_entry *destination)
+{
+    /* Runs that are already in order are only copied. */
+    if (right_count == 0 || !sort_is_less(state, right, left + left_count - 1)) {
+        memcpy(destination, left, left_count * sizeof(*left));
+        memcpy(destination + left_count, right, right_count * sizeof(*right));
+        return;
+    }
 
-    return rating;
+    size_t l = 0, r = 0;
+    while (l < left_count && r < right_count)
+        *destination++ = sort_is_less(state, right + r, left + l) ? right[r++] : left[l++];
+    memcpy(destination, left + l, (left_count - l) * sizeof(*left));
+    memcpy(destination + left_count - l, right + r, (right_count - r) * sizeof(*right));
 }
 
 /*
-Return the list 'subject', sorted using the function 'compare'.
+Sort entries in a stable manner, using buffer, which holds as many entries, for merging.
+*/
+static void sort_entries(sort_state *state, sort_entry *entries, sort_entry *buffer, size_t count)
+{
+    /* Sort short runs by insertion, searching for the position of each entry after the entries it
+    is in order with, so that as few comparisons as possible are made. */
+    for (size_t start = 0; start < count; start += SORT_RUN_LENGTH) {
+        size_t end = start + SORT_RUN_LENGTH < count ? start + SORT_RUN_LENGTH : count;
+        for (size_t i = start + 1; i < end; i++) {
+            sort_entry entry = entries[i];
+            size_t low = start, high = i;
+            while (low < high) {
+                size_t middle = low + (high - low) / 2;
+                if (sort_is_less(state, &entry, entries + middle))
+                    high = middle;
+                else
+                    low = middle + 1;
+            }
+            memmove(entries + low + 1, entries + low, (i - low) * sizeof(*entries));
+            entries[low] = entry;
+        }
+    }
+
+    /* Merge runs of doubling length, alternating between entries and buffer. */
+    sort_entry *from = entries;
+    sort_entry *to = buffer;
+    for (size_t width = SORT_RUN_LENGTH; width < count; width *= 2) {
+        for (size_t start = 0; start < count; start += 2 * width) {
+            size_t middle = start + width < count ? start + width : count;
+            size_t end = middle + width < count ? middle + width : count;
+            sort_merge(
+                state, from + start, middle - start, from + middle, end - middle, to + start);
+        }
+        sort_entry *merged = to;
+        to = from;
+        from = merged;
+    }
+    if (from != entries)
+        memcpy(entries, from, count * sizeof(*entries));
+}
+
+/*
+Return the list 'subject', sorted in a stable manner. If 'order' is Void, items are ordered using
+the '<' operator. If it is a function with one parameter, it is called once per item, and items are
+ordered by what it returns using the '<' operator. Otherwise, it is called with two items and
+returns a negative INT if the first must come before the second.
 */
 une_native_fn__(sort)
 {
     une_native_param subject = 0;
-    une_native_param compare = 1;
+    une_native_param order = 1;
 
     UNE_NATIVE_VERIFY_ARG_KIND(subject, UNE_RK_LIST);
-    UNE_NATIVE_VERIFY_ARG_KIND(compare, UNE_RK_FUNCTION);
-
-    assert(!sort_error);
-    assert(!sort_call_node);
-    assert(sort_comparator.kind == UNE_RK_none__);
-    sort_error = &felix->error;
-    sort_call_node = call_node;
-    sort_comparator = args[compare];
+    if (args[order].kind != UNE_RK_VOID)
+        UNE_NATIVE_VERIFY_ARG_KIND(order, UNE_RK_FUNCTION);
+
+    /* A function with one parameter extracts keys. */
+    bool uses_keys = false;
+    if (args[order].kind == UNE_RK_FUNCTION) {
+        une_callable *callable =
+            une_callables_get_callable_by_id(felix->is.callables, args[order].value._id);
+        assert(callable);
+        uses_keys = callable->parameters.count == 1;
+    }
 
     une_result result = une_result_copy(args[subject]);
-    UNE_UNPACK_RESULT_LIST(result, elements, count);
-    qsort(elements + 1 /* Size. */, count, sizeof(*elements), &sort_compare);
+    une_result_unshare(&result);
+    UNE_UNPACK_RESULT_LIST(result, items, count);
+    if (count < 2)
+        return result;
+
+    /* Items are moved into the entries without being copied. */
+    sort_entry *entries = malloc(2 * count * sizeof(*entries));
+    verify(entries);
+    UNE_FOR_RESULT_LIST_ITEM(i, count)
+    entries[i - 1] = (sort_entry){.key = items[i], .item = items[i]};
+
+    sort_state state = {
+        .call_node = call_node,
+        .comparator = (une_result){.kind = UNE_RK_none__},
+        .comparator_args = une_result_create(UNE_RK_VOID),
+    };
+    if (args[order].kind == UNE_RK_FUNCTION) {
+        state.comparator_args = (une_result){
+            .kind = UNE_RK_LIST, .value._vp = (void *)une_result_list_create(uses_keys ? 1 : 2)};
+        if (!uses_keys)
+            state.comparator = args[order];
+    }
+
+    /* Extract keys. */
+    size_t keys_count = 0;
+    if (uses_keys) {
+        une_result *key_args = (une_result *)state.comparator_args.value._vp;
+        for (; keys_count < count; keys_count++) {
+            key_args[1] = entries[keys_count].item;
+            une_result key = UNE_TYPE_FOR_RESULT(args[order])
+                                 .call(call_node,
+                                       args[order],
+                                       state.comparator_args,
+                                       UNE_SYMBOL_NONE);
+            if (key.kind == UNE_RK_ERROR)
+                break;
+            entries[keys_count].key = key;
+        }
+    }
+
+    if (felix->error.kind == UNE_EK_none__)
+        sort_entries(&state, entries, entries + count, count);
+
+    /* Put the items back and release the borrowed arguments and keys. */
+    UNE_FOR_RESULT_LIST_ITEM(i, count)
+    items[i] = entries[i - 1].item;
+    if (state.comparator_args.kind == UNE_RK_LIST) {
+        UNE_UNPACK_RESULT_LIST(state.comparator_args, comparator_args, comparator_args_count);
+        UNE_FOR_RESULT_LIST_ITEM(i, comparator_args_count)
+        comparator_args[i] = une_result_create(UNE_RK_VOID);
+        une_result_free(state.comparator_args);
+    }
+    for (size_t i = 0; i < keys_count; i++)
+        une_result_free(entries[i].key);
+    free(entries);
+
     if (felix->error.kind != UNE_EK_none__) {
         une_result_free(result);
         return une_result_create(UNE_RK_ERROR);
     }
+    return result;
+}
+
+/*
+Get the result of kind 'kind' a native function writes to, or NULL if the argument is not of that
+kind or cannot be written to.
+*/
+static une_result *writable_argument(
+    une_node *call_node, une_result *args, une_native_param index, une_result_kind kind)
+{
+    if (args[index].kind != UNE_RK_REFERENCE || args[index].reference_kind != UNE_FK_SINGLE ||
+        ((une_result *)args[index].reference_root)->kind != kind) {
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, UNE_NATIVE_POS_OF_ARG(index));
+        return NULL;
+    }
+    return (une_result *)args[index].reference_root;
+}
+
+/*
+Append 'item' to the list 'list'.
+*/
+une_native_fn__(push)
+{
+    une_native_param list = 0;
+    une_native_param item = 1;
+
+    une_result *subject = writable_argument(call_node, args, list, UNE_RK_LIST);
+    if (!subject)
+        return une_result_create(UNE_RK_ERROR);
+
+    une_type_list_insert(subject, une_type_list_get_len(*subject), une_result_copy(args[item]));
+    return une_result_create(UNE_RK_VOID);
+}
+
+/*
+Remove and return the last item of the list 'list'.
+*/
+une_native_fn__(pop)
+{
+    une_native_param list = 0;
+
+    une_result *subject = writable_argument(call_node, args, list, UNE_RK_LIST);
+    if (!subject)
+        return une_result_create(UNE_RK_ERROR);
+
+    size_t length = une_type_list_get_len(*subject);
+    if (length == 0) {
+        felix->error = UNE_ERROR_SET(UNE_EK_INDEX, UNE_NATIVE_POS_OF_ARG(list));
+        return une_result_create(UNE_RK_ERROR);
+    }
+    return une_type_list_remove(subject, length - 1);
+}
+
+/*
+Insert 'item' into the list 'list' before index 'index'.
+*/
+une_native_fn__(insert)
+{
+    une_native_param list = 0;
+    une_native_param index = 1;
+    une_native_param item = 2;
+
+    une_result *subject = writable_argument(call_node, args, list, UNE_RK_LIST);
+    if (!subject)
+        return une_result_create(UNE_RK_ERROR);
+    UNE_NATIVE_VERIFY_ARG_KIND(index, UNE_RK_INT);
+
+    /* The end of the list is a valid position. */
+    une_range position =
+        une_range_from_relative_index(args[index], une_type_list_get_len(*subject) + 1);
+    if (!position.valid) {
+        felix->error = UNE_ERROR_SET(UNE_EK_INDEX, UNE_NATIVE_POS_OF_ARG(index));
+        return une_result_create(UNE_RK_ERROR);
+    }
+
+    une_type_list_insert(subject, position.first, une_result_copy(args[item]));
+    return une_result_create(UNE_RK_VOID);
+}
+
+/*
+Remove and return the item at index 'index' of the list 'list'.
+*/
+une_native_fn__(remove)
+{
+    une_native_param list = 0;
+    une_native_param index = 1;
+
+    une_result *subject = writable_argument(call_node, args, list, UNE_RK_LIST);
+    if (!subject)
+        return une_result_create(UNE_RK_ERROR);
+    UNE_NATIVE_VERIFY_ARG_KIND(index, UNE_RK_INT);
+
+    une_range position =
+        une_range_from_relative_index(args[index], une_type_list_get_len(*subject));
+    if (!position.valid) {
+        felix->error = UNE_ERROR_SET(UNE_EK_INDEX, UNE_NATIVE_POS_OF_ARG(index));
+        return une_result_create(UNE_RK_ERROR);
+    }
+
+    return une_type_list_remove(subject, position.first);
+}
+
+/*
+Pack the list of INTs and FLTs 'list' into an array.
+*/
+une_native_fn__(array)
+{
+    une_native_param list = 0;
+
+    UNE_NATIVE_VERIFY_ARG_KIND(list, UNE_RK_LIST);
+
+    une_result result = une_type_array_from_list(args[list]);
+    if (result.kind == UNE_RK_ERROR)
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, UNE_NATIVE_POS_OF_ARG(list));
+    return result;
+}
+
+/*
+Unpack the array or range 'array' into a list.
+*/
+une_native_fn__(list)
+{
+    une_native_param array = 0;
+
+    if (args[array].kind == UNE_RK_RANGE)
+        return une_type_range_to_list(args[array]);
+    UNE_NATIVE_VERIFY_ARG_KIND(array, UNE_RK_ARRAY);
+
+    return une_type_array_to_list(args[array]);
+}
+
+/*
+Add up the items of the array 'array'.
+*/
+une_native_fn__(sum)
+{
+    une_native_param array = 0;
+
+    UNE_NATIVE_VERIFY_ARG_KIND(array, UNE_RK_ARRAY);
+
+    return une_type_array_sum(args[array]);
+}
+
+/*
+Get the least item of the array 'array'.
+*/
+une_native_fn__(min)
+{
+    une_native_param array = 0;
+
+    UNE_NATIVE_VERIFY_ARG_KIND(array, UNE_RK_ARRAY);
+    if (une_type_array_get_len(args[array]) == 0) {
+        felix->error = UNE_ERROR_SET(UNE_EK_INDEX, UNE_NATIVE_POS_OF_ARG(array));
+        return une_result_create(UNE_RK_ERROR);
+    }
+
+    return une_type_array_extreme(args[array], false);
+}
+
+/*
+Get the greatest item of the array 'array'.
+*/
+une_native_fn__(max)
+{
+    une_native_param array = 0;
+
+    UNE_NATIVE_VERIFY_ARG_KIND(array, UNE_RK_ARRAY);
+    if (une_type_array_get_len(args[array]) == 0) {
+        felix->error = UNE_ERROR_SET(UNE_EK_INDEX, UNE_NATIVE_POS_OF_ARG(array));
+        return une_result_create(UNE_RK_ERROR);
+    }
+
+    return une_type_array_extreme(args[array], true);
+}
+
+/*
+Get the dot product of the arrays 'left' and 'right'.
+*/
+une_native_fn__(dot)
+{
+    une_native_param left = 0;
+    une_native_param right = 1;
+
+    UNE_NATIVE_VERIFY_ARG_KIND(left, UNE_RK_ARRAY);
+    UNE_NATIVE_VERIFY_ARG_KIND(right, UNE_RK_ARRAY);
+    if (une_type_array_get_len(args[left]) != une_type_array_get_len(args[right])) {
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, UNE_NATIVE_POS_OF_ARG(right));
+        return une_result_create(UNE_RK_ERROR);
+    }
+
+    return une_type_array_dot(args[left], args[right]);
+}
+
+/*
+Create a map from the list of [key, value] pairs 'pairs'.
+*/
+une_native_fn__(map)
+{
+    une_native_param pairs = 0;
+
+    UNE_NATIVE_VERIFY_ARG_KIND(pairs, UNE_RK_LIST);
+
+    une_result result = une_type_map_from_pairs(args[pairs]);
+    if (result.kind == UNE_RK_ERROR)
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, UNE_NATIVE_POS_OF_ARG(pairs));
+    return result;
+}
+
+/*
+Get the value 'key' maps to in the map 'map', or Void if it is not in the map.
+*/
+une_native_fn__(get)
+{
+    une_native_param map = 0;
+    une_native_param key = 1;
+
+    UNE_NATIVE_VERIFY_ARG_KIND(map, UNE_RK_MAP);
+    if (!une_type_map_is_valid_key(args[key])) {
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, UNE_NATIVE_POS_OF_ARG(key));
+        return une_result_create(UNE_RK_ERROR);
+    }
+
+    return une_type_map_get_index(args[map], args[key]);
+}
+
+/*
+Map 'key' to 'value' in the map 'map'.
+*/
+une_native_fn__(set)
+{
+    une_native_param map = 0;
+    une_native_param key = 1;
+    une_native_param value = 2;
+
+    une_result *subject = writable_argument(call_node, args, map, UNE_RK_MAP);
+    if (!subject)
+        return une_result_create(UNE_RK_ERROR);
+    if (!une_type_map_is_valid_key(args[key])) {
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, UNE_NATIVE_POS_OF_ARG(key));
+        return une_result_create(UNE_RK_ERROR);
+    }
 
-    sort_error = NULL;
-    sort_call_node = NULL;
-    sort_comparator = (une_result){.kind = UNE_RK_none__};
+    une_result *target = une_type_map_insert(subject, args[key]);
+    une_result_free(*target);
+    *target = une_result_copy(args[value]);
+    return une_result_create(UNE_RK_VOID);
+}
 
+/*
+Check if 'key' is in the map 'map'.
+*/
+une_native_fn__(has)
+{
+    une_native_param map = 0;
+    une_native_param key = 1;
+
+    UNE_NATIVE_VERIFY_ARG_KIND(map, UNE_RK_MAP);
+    if (!une_type_map_is_valid_key(args[key])) {
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, UNE_NATIVE_POS_OF_ARG(key));
+        return une_result_create(UNE_RK_ERROR);
+    }
+
+    une_result result = une_result_create(UNE_RK_INT);
+    result.value._int = une_type_map_find(args[map], args[key]) ? 1 : 0;
     return result;
 }
 
+/*
+Remove 'key' from the map 'map' and return the value it mapped to.
+*/
+une_native_fn__(delete)
+{
+    une_native_param map = 0;
+    une_native_param key = 1;
+
+    une_result *subject = writable_argument(call_node, args, map, UNE_RK_MAP);
+    if (!subject)
+        return une_result_create(UNE_RK_ERROR);
+    if (!une_type_map_is_valid_key(args[key])) {
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, UNE_NATIVE_POS_OF_ARG(key));
+        return une_result_create(UNE_RK_ERROR);
+    }
+    if (!une_type_map_find(*subject, args[key])) {
+        felix->error = UNE_ERROR_SET(UNE_EK_INDEX, UNE_NATIVE_POS_OF_ARG(key));
+        return une_result_create(UNE_RK_ERROR);
+    }
+
+    return une_type_map_delete(subject, args[key]);
+}
+
+/*
+Get a list of the keys of the map 'map', in the order they were added.
+*/
+une_native_fn__(keys)
+{
+    une_native_param map = 0;
+
+    UNE_NATIVE_VERIFY_ARG_KIND(map, UNE_RK_MAP);
+
+    return une_type_map_keys(args[map]);
+}
+
+/*
+Get a list of the values of the map 'map', in the order their keys were added.
+*/
+une_native_fn__(values)
+{
+    une_native_param map = 0;
+
+    UNE_NATIVE_VERIFY_ARG_KIND(map, UNE_RK_MAP);
+
+    return une_type_map_values(args[map]);
+}
+
+/*
+Create a range of the INTs from 'start' up to (but excluding) 'stop', spaced 'step' apart. The INTs
+are produced when they are needed.
+*/
+une_native_fn__(range)
+{
+    une_native_param start = 0;
+    une_native_param stop = 1;
+    une_native_param step = 2;
+
+    UNE_NATIVE_VERIFY_ARG_KIND(start, UNE_RK_INT);
+    UNE_NATIVE_VERIFY_ARG_KIND(stop, UNE_RK_INT);
+    UNE_NATIVE_VERIFY_ARG_KIND(step, UNE_RK_INT);
+    if (args[step].value._int == 0) {
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, UNE_NATIVE_POS_OF_ARG(step));
+        return une_result_create(UNE_RK_ERROR);
+    }
+
+    une_result range = une_type_range_create(
+        args[start].value._int, args[stop].value._int, args[step].value._int);
+    if (range.kind == UNE_RK_ERROR)
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, UNE_NATIVE_POS_OF_ARG(stop));
+    return range;
+}
+
 /*
 Get the working directory.
 */
@@ -687,7 +1293,9 @@ une_native_fn__(getwd)
         return une_result_create(UNE_RK_ERROR);
     }
 
-    return (une_result){.kind = UNE_RK_STR, .value._wcs = path};
+    une_result result = une_type_str_from_wcs(path);
+    free(path);
+    return result;
 }
 
 /*
@@ -698,7 +1306,9 @@ une_native_fn__(setwd)
     une_native_param path = 0;
     UNE_NATIVE_VERIFY_ARG_KIND(path, UNE_RK_STR);
 
-    bool success = une_set_working_directory(args[path].value._wcs);
+    wchar_t *path_wcs = une_type_str_to_wcs(args[path]);
+    bool success = une_set_working_directory(path_wcs);
+    free(path_wcs);
     if (!success) {
         felix->error = UNE_ERROR_SET(UNE_EK_FILE, UNE_NATIVE_POS_OF_ARG(path));
         return une_result_create(UNE_RK_ERROR);
@@ -715,7 +1325,7 @@ une_native_fn__(playwav)
     une_native_param path = 0;
     UNE_NATIVE_VERIFY_ARG_KIND(path, UNE_RK_STR);
 
-    char *path_narrow = une_wcs_to_str(args[path].value._wcs);
+    char *path_narrow = une_type_str_to_str(args[path]);
     if (!path_narrow) {
         felix->error = UNE_ERROR_SET(UNE_EK_ENCODING, UNE_NATIVE_POS_OF_ARG(path));
         return une_result_create(UNE_RK_ERROR);
@@ -728,5 +1338,8 @@ une_native_fn__(playwav)
         return une_result_create(UNE_RK_ERROR);
     }
 
-    return (une_result){.kind = UNE_RK_INT, .value._int = une_play_wav(args[path].value._wcs)};
+    wchar_t *path_wcs = une_type_str_to_wcs(args[path]);
+    bool played = une_play_wav(path_wcs);
+    free(path_wcs);
+    return (une_result){.kind = UNE_RK_INT, .value._int = (une_int)played};
 }
@@ -29,8 +29,14 @@ Every native function.
         enumerator(len) enumerator(sleep) enumerator(chr) enumerator(ord) enumerator(read)         \
             enumerator(write) enumerator(append) enumerator(input) enumerator(script)              \
                 enumerator(exist) enumerator(split) enumerator(eval) enumerator(replace)           \
-                    enumerator(join) enumerator(sort) enumerator(getwd) enumerator(setwd)          \
-                        enumerator(playwav)
+                    enumerator(find) enumerator(contains) enumerator(count) enumerator(join)       \
+                        enumerator(sort) enumerator(push) enumerator(pop) enumerator(insert)       \
+                            enumerator(remove) enumerator(array) enumerator(list) enumerator(sum)  \
+                                enumerator(min) enumerator(max) enumerator(dot) enumerator(map)    \
+                                    enumerator(get) enumerator(set) enumerator(has)                \
+                                        enumerator(delete) enumerator(keys) enumerator(values)     \
+                                            enumerator(range) enumerator(getwd) enumerator(setwd)  \
+                                                enumerator(playwav)
 
 /*
 The index of a native function.
@@ -44,6 +50,8 @@ typedef enum une_native_
         UNE_NATIVE_max__,
 } une_native;
 
+_Static_assert(UNE_NATIVE_max__ <= 64, "une_native must fit une_engine.shadowed_natives.");
+
 /*
 Native function template.
 */
@@ -72,8 +80,10 @@ Verify that a une_native is valid.
 #define UNE_NATIVE_IS_VALID(function) (function > UNE_NATIVE_none__ && function < UNE_NATIVE_max__)
 
 size_t une_native_params_count(une_native function);
+bool une_native_writes_to_argument(une_native function);
 une_native_fnptr une_native_to_fnptr(une_native function);
-une_native une_native_wcs_to_function(wchar_t *wcs);
+void une_native_intern_names(une_symbols *symbols);
+une_native une_native_symbol_to_function(une_symbol symbol);
 
 #ifdef UNE_DEBUG
 const wchar_t *une_native_to_wcs(une_native function);
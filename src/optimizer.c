@@ -0,0 +1,368 @@
+/*
+optimizer.c - Une
+*/
+
+/* Header-specific includes. */
+#include "optimizer.h"
+
+/* Implementation-specific includes. */
+#include "tools.h"
+#include "types/types.h"
+#include <math.h>
+
+/*
+*** Interface.
+*/
+
+/*
+Simplify the syntax tree of a module before it is resolved: fold operators whose operands are
+literals, prune branches whose condition is a literal, and drop statements that can never run.
+
+Only outcomes the interpreter would produce without error are folded, so errors are still raised
+at run time, at the same position.
+*/
+void une_optimize(une_module *module, une_node *module_body)
+{
+    assert(module);
+    assert(module_body && module_body->kind == UNE_NK_STMTS);
+    une_node *optimized = une_optimize_node(module, module_body);
+    assert(optimized == module_body);
+    (void)optimized;
+}
+
+/*
+*** Helpers.
+*/
+
+/*
+Optimize a node and its children, returning the node that takes its place.
+*/
+une_static__ une_node *une_optimize_node(une_module *module, une_node *node)
+{
+    if (node == NULL)
+        return NULL;
+    assert(UNE_NODE_KIND_IS_VALID(node->kind));
+
+    switch (node->kind) {
+
+    /* Data. */
+    case UNE_NK_NAME:
+    case UNE_NK_SIZE:
+    case UNE_NK_ID:
+    case UNE_NK_VOID:
+    case UNE_NK_INT:
+    case UNE_NK_FLT:
+    case UNE_NK_STR:
+    case UNE_NK_NATIVE:
+    case UNE_NK_BREAK:
+    case UNE_NK_CONTINUE:
+    case UNE_NK_THIS:
+        return node;
+
+    /* Node lists. */
+    case UNE_NK_LIST:
+    case UNE_NK_OBJECT:
+    case UNE_NK_STMTS: {
+        UNE_UNPACK_NODE_LIST(node, list, size);
+        UNE_FOR_NODE_LIST_ITEM(i, size)
+        list[i] = une_optimize_node(module, list[i]);
+        if (node->kind == UNE_NK_STMTS)
+            une_optimize_stmts(node);
+        return node;
+    }
+
+    /* Nodes. */
+    default:
+        node->content.branch.a = une_optimize_node(module, node->content.branch.a);
+        if (node->kind != UNE_NK_SEEK)
+            node->content.branch.b = une_optimize_node(module, node->content.branch.b);
+        node->content.branch.c = une_optimize_node(module, node->content.branch.c);
+        node->content.branch.d = une_optimize_node(module, node->content.branch.d);
+        break;
+    }
+
+    /* Prune branches whose condition is known. */
+    switch (node->kind) {
+    case UNE_NK_IF:
+    case UNE_NK_COP:
+    case UNE_NK_WHILE: {
+        if (!une_optimize_is_literal(node->content.branch.a))
+            return node;
+        une_result condition = une_optimize_literal_to_result(node->content.branch.a);
+        une_int is_true = une_result_is_true(condition);
+        une_result_free(condition);
+        if (node->kind == UNE_NK_WHILE)
+            return is_true ? node : une_optimize_select(node, NULL);
+        return une_optimize_select(node, is_true ? node->content.branch.b : node->content.branch.c);
+    }
+    default:
+        return une_optimize_fold(module, node);
+    }
+}
+
+/*
+Drop the statements following one that always leaves the list.
+*/
+une_static__ void une_optimize_stmts(une_node *node)
+{
+    assert(node->kind == UNE_NK_STMTS);
+    UNE_UNPACK_NODE_LIST(node, list, size);
+    UNE_FOR_NODE_LIST_ITEM(i, size)
+    {
+        une_node_kind kind = list[i]->kind;
+        if (kind != UNE_NK_RETURN && kind != UNE_NK_EXIT && kind != UNE_NK_BREAK &&
+            kind != UNE_NK_CONTINUE)
+            continue;
+        for (size_t j = i + 1; j <= size; j++) {
+            une_node_free(list[j], false);
+            list[j] = NULL;
+        }
+        list[0]->content.value._int = (une_int)i;
+        break;
+    }
+}
+
+/*
+Replace an operator whose operands are literals with its outcome.
+*/
+une_static__ une_node *une_optimize_fold(une_module *module, une_node *node)
+{
+    une_result outcome = une_optimize_evaluate(node);
+    if (outcome.kind == UNE_RK_none__)
+        return node;
+    une_node *literal = une_optimize_result_to_literal(module, outcome, node->pos);
+    une_result_free(outcome);
+    une_node_free(node, false);
+    return literal;
+}
+
+/*
+Evaluate an operator whose operands are literals, returning a UNE_RK_none__ result if it cannot be
+folded.
+*/
+une_static__ une_result une_optimize_evaluate(une_node *node)
+{
+    une_result outcome = une_result_create(UNE_RK_none__);
+
+    /* Unary operators. */
+    if (node->kind == UNE_NK_NEG || node->kind == UNE_NK_NOT) {
+        if (!une_optimize_is_literal(node->content.branch.a))
+            return outcome;
+        une_result center = une_optimize_literal_to_result(node->content.branch.a);
+        if (node->kind == UNE_NK_NOT)
+            outcome = (une_result){.kind = UNE_RK_INT, .value._int = !une_result_is_true(center)};
+        else if (UNE_TYPE_FOR_RESULT(center).negate &&
+                 !(center.kind == UNE_RK_INT && center.value._int == INT64_MIN))
+            outcome = UNE_TYPE_FOR_RESULT(center).negate(center);
+        une_result_free(center);
+        return outcome;
+    }
+
+    /* Binary operators. */
+    if ((node->kind < UNE_R_BGN_CONDITION_NODES || node->kind > UNE_NK_POW) &&
+        node->kind != UNE_NK_CONCATENATE)
+        return outcome;
+    if (!une_optimize_is_literal(node->content.branch.a) ||
+        !une_optimize_is_literal(node->content.branch.b))
+        return outcome;
+    une_result left = une_optimize_literal_to_result(node->content.branch.a);
+    une_result right = une_optimize_literal_to_result(node->content.branch.b);
+    une_type left_type = UNE_TYPE_FOR_RESULT(left);
+
+    /* Integer arithmetic that overflows is undefined or traps, so it is left to run time. */
+    if (left.kind == UNE_RK_INT && right.kind == UNE_RK_INT &&
+        une_optimize_int_overflows(node->kind, left.value._int, right.value._int))
+        return outcome;
+
+    /* Dividing by zero either raises an error or crashes, so it is left to run time. */
+    bool right_is_zero =
+        (right.kind == UNE_RK_INT && right.value._int == 0) ||
+        (right.kind == UNE_RK_FLT && une_flts_equal(right.value._flt, UNE_NEW_FLT(0.0)));
+    une_int applies = -1;
+
+    switch (node->kind) {
+    case UNE_NK_EQU:
+        applies = une_result_equ_result(left, right);
+        break;
+    case UNE_NK_NEQ:
+        applies = une_result_neq_result(left, right);
+        break;
+    case UNE_NK_GEQ:
+        applies = une_result_geq_result(left, right);
+        break;
+    case UNE_NK_GTR:
+        applies = une_result_gtr_result(left, right);
+        break;
+    case UNE_NK_LEQ:
+        applies = une_result_leq_result(left, right);
+        break;
+    case UNE_NK_LSS:
+        applies = une_result_lss_result(left, right);
+        break;
+    case UNE_NK_ADD:
+        if (left_type.add)
+            outcome = left_type.add(left, right);
+        break;
+    case UNE_NK_SUB:
+        if (left_type.sub)
+            outcome = left_type.sub(left, right);
+        break;
+    case UNE_NK_MUL:
+        /* Repeated strings could grow without bound. */
+        if (left_type.mul && left.kind != UNE_RK_STR && right.kind != UNE_RK_STR)
+            outcome = left_type.mul(left, right);
+        break;
+    case UNE_NK_FDIV:
+        if (left_type.fdiv && !right_is_zero)
+            outcome = left_type.fdiv(left, right);
+        break;
+    case UNE_NK_DIV:
+        if (left_type.div && !right_is_zero)
+            outcome = left_type.div(left, right);
+        break;
+    case UNE_NK_MOD:
+        if (left_type.mod && !right_is_zero)
+            outcome = left_type.mod(left, right);
+        break;
+    case UNE_NK_POW:
+        if (left_type.pow)
+            outcome = left_type.pow(left, right);
+        break;
+    case UNE_NK_CONCATENATE: {
+        une_result left_as_str = left_type.as_str(left);
+        une_result right_as_str = UNE_TYPE_FOR_RESULT(right).as_str(right);
+        outcome = une_type_str_add(left_as_str, right_as_str);
+        une_result_free(left_as_str);
+        une_result_free(right_as_str);
+        break;
+    }
+    default:
+        assert(false);
+    }
+    une_result_free(left);
+    une_result_free(right);
+
+    if (node->kind >= UNE_R_BGN_CONDITION_NODES && node->kind <= UNE_R_END_CONDITION_NODES)
+        return applies == -1 ? outcome : (une_result){.kind = UNE_RK_INT, .value._int = applies};
+
+    /* Outcomes the interpreter turns into errors. */
+    if (outcome.kind == UNE_RK_ERROR ||
+        (outcome.kind == UNE_RK_FLT && (isnan(outcome.value._flt) || isinf(outcome.value._flt)))) {
+        une_result_free(outcome);
+        return une_result_create(UNE_RK_none__);
+    }
+    return outcome;
+}
+
+/*
+Check whether an integer operator overflows une_int or traps for the given operands.
+*/
+une_static__ bool une_optimize_int_overflows(une_node_kind kind, une_int left, une_int right)
+{
+    une_int outcome;
+    switch (kind) {
+    case UNE_NK_ADD:
+        return __builtin_add_overflow(left, right, &outcome);
+    case UNE_NK_SUB:
+        return __builtin_sub_overflow(left, right, &outcome);
+    case UNE_NK_MUL:
+        return __builtin_mul_overflow(left, right, &outcome);
+    case UNE_NK_DIV:
+    case UNE_NK_FDIV:
+    case UNE_NK_MOD:
+        return left == INT64_MIN && right == -1;
+    case UNE_NK_POW: {
+        /* Negative exponents produce floats. */
+        if (right < 0)
+            return false;
+        une_int base = left;
+        outcome = 1;
+        for (une_int exponent = right; exponent > 0; exponent >>= 1) {
+            if ((exponent & 1) && __builtin_mul_overflow(outcome, base, &outcome))
+                return true;
+            if (exponent > 1 && __builtin_mul_overflow(base, base, &base))
+                return true;
+        }
+        /* The interpreter goes through une_flt, which may round past the range of une_int. */
+        return fabs(une_flt_pow((une_flt)left, (une_flt)right)) >= 0x1p63;
+    }
+    default:
+        return false;
+    }
+}
+
+/*
+Check whether a node is a literal the optimizer can evaluate.
+*/
+une_static__ bool une_optimize_is_literal(une_node *node)
+{
+    return node &&
+           (node->kind == UNE_NK_INT || node->kind == UNE_NK_FLT || node->kind == UNE_NK_STR);
+}
+
+/*
+Convert a literal into a une_result.
+*/
+une_static__ une_result une_optimize_literal_to_result(une_node *node)
+{
+    switch (node->kind) {
+    case UNE_NK_INT:
+        return (une_result){.kind = UNE_RK_INT, .value._int = node->content.value._int};
+    case UNE_NK_FLT:
+        return (une_result){.kind = UNE_RK_FLT, .value._flt = node->content.value._flt};
+    case UNE_NK_STR:
+        return une_type_str_from_wcs(node->content.value._wcs);
+    default:
+        assert(false);
+    }
+    return une_result_create(UNE_RK_none__);
+}
+
+/*
+Convert a une_result into a literal. Strings are handed over to the module.
+*/
+une_static__ une_node *une_optimize_result_to_literal(une_module *module,
+                                                      une_result result,
+                                                      une_position pos)
+{
+    une_node *literal = NULL;
+    switch (result.kind) {
+    case UNE_RK_INT:
+        literal = une_node_create(UNE_NK_INT);
+        literal->content.value._int = result.value._int;
+        break;
+    case UNE_RK_FLT:
+        literal = une_node_create(UNE_NK_FLT);
+        literal->content.value._flt = result.value._flt;
+        break;
+    case UNE_RK_STR: {
+        wchar_t *wcs = une_type_str_to_wcs(result);
+        une_module_add_string(module, wcs);
+        literal = une_node_create(UNE_NK_STR);
+        literal->content.value._wcs = wcs;
+        break;
+    }
+    default:
+        assert(false);
+    }
+    literal->pos = pos;
+    return literal;
+}
+
+/*
+Replace a conditional node with one of its branches, or with VOID if selected is NULL.
+*/
+une_static__ une_node *une_optimize_select(une_node *node, une_node *selected)
+{
+    if (selected == NULL) {
+        selected = une_node_create(UNE_NK_VOID);
+        selected->pos = node->pos;
+    } else if (selected == node->content.branch.b) {
+        node->content.branch.b = NULL;
+    } else {
+        assert(selected == node->content.branch.c);
+        node->content.branch.c = NULL;
+    }
+    une_node_free(node, false);
+    return selected;
+}
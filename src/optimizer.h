@@ -0,0 +1,36 @@
+/*
+optimizer.h - Une
+*/
+
+#ifndef UNE_OPTIMIZER_H
+#define UNE_OPTIMIZER_H
+
+/* Header-specific includes. */
+#include "common.h"
+#include "struct/module.h"
+#include "struct/node.h"
+#include "struct/result.h"
+
+/*
+*** Interface.
+*/
+
+void une_optimize(une_module *module, une_node *module_body);
+
+/*
+*** Helpers.
+*/
+
+une_static__ une_node *une_optimize_node(une_module *module, une_node *node);
+une_static__ void une_optimize_stmts(une_node *node);
+une_static__ une_node *une_optimize_fold(une_module *module, une_node *node);
+une_static__ une_result une_optimize_evaluate(une_node *node);
+une_static__ bool une_optimize_int_overflows(une_node_kind kind, une_int left, une_int right);
+une_static__ bool une_optimize_is_literal(une_node *node);
+une_static__ une_result une_optimize_literal_to_result(une_node *node);
+une_static__ une_node *une_optimize_result_to_literal(une_module *module,
+                                                      une_result result,
+                                                      une_position pos);
+une_static__ une_node *une_optimize_select(une_node *node, une_node *selected);
+
+#endif /* !UNE_OPTIMIZER_H */
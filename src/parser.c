@@ -7,7 +7,6 @@ parser.c - Une
 
 /* Implementation-specific includes. */
 #include "deprecated/stream.h"
-#include "natives.h"
 #include "tools.h"
 
 #if defined(UNE_DEBUG) && defined(UNE_DBG_LOG_PARSE)
@@ -97,7 +96,7 @@ une_parser__(une_parse_name)
 
     une_node *name = une_node_create(UNE_NK_NAME);
     name->pos = now(&ps->in).pos;
-    name->content.value._wcs = now(&ps->in).value._wcs;
+    name->content.value._id = now(&ps->in).value._id;
     pull(&ps->in);
 
     LOGPARSE_END(name);
@@ -343,9 +342,6 @@ une_parser__(une_parse_atom)
     case UNE_TK_THIS:
         LOGPARSE_END(une_parse_this(error, ps));
 
-    case UNE_TK_NATIVE:
-        LOGPARSE_END(une_parse_native(error, ps));
-
     case UNE_TK_LSQB:
         LOGPARSE_END(une_parse_list(error, ps));
 
@@ -534,18 +530,6 @@ une_parser__(une_parse_seek_or_this, bool global)
     LOGPARSE_END(une_parse_seek(error, ps, global));
 }
 
-une_parser__(une_parse_native)
-{
-    LOGPARSE_BEGIN();
-    if (!UNE_NATIVE_IS_VALID(now(&ps->in).value._int))
-        LOGPARSE_END(NULL);
-    une_node *native = une_node_create(UNE_NK_NATIVE);
-    native->pos = now(&ps->in).pos;
-    native->content.value._int = now(&ps->in).value._int;
-    pull(&ps->in);
-    LOGPARSE_END(native);
-}
-
 une_parser__(une_parse_list)
 {
     LOGPARSE_BEGIN();
@@ -598,11 +582,15 @@ une_parser__(une_parse_function, une_node *parameters)
     une_node *module_id = une_node_create(UNE_NK_ID);
     module_id->content.value._id = ps->module_id;
 
+    une_node *callable_id = une_node_create(UNE_NK_ID); /* Populated by the resolver. */
+    callable_id->content.value._id = 0;
+
     une_node *function = une_node_create(UNE_NK_FUNCTION);
     function->pos = une_position_between(parameters->pos, body->pos);
     function->content.branch.a = parameters;
     function->content.branch.b = body;
     function->content.branch.c = module_id;
+    function->content.branch.d = callable_id;
 
     LOGPARSE_END(function);
 }
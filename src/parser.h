@@ -49,7 +49,6 @@ une_parser__(une_parse_true);
 une_parser__(une_parse_false);
 une_parser__(une_parse_this);
 une_parser__(une_parse_seek, bool global);
-une_parser__(une_parse_native);
 une_parser__(une_parse_list);
 une_parser__(une_parse_signature);
 une_parser__(une_parse_function, une_node *parameters);
@@ -0,0 +1,246 @@
+/*
+resolver.c - Une
+*/
+
+/* Header-specific includes. */
+#include "resolver.h"
+
+/* Implementation-specific includes. */
+#include "natives.h"
+#include "struct/engine.h"
+#include "tools.h"
+
+/*
+*** Interface.
+*/
+
+/*
+Assign frame slots to the variable names in every function body of a module, and register one
+callable per function literal.
+
+Une is dynamically scoped, so only the frame of the function itself can be addressed statically.
+Names at the top level of a module are left unresolved, because a module shares the frame of
+whoever runs it.
+
+Names of native functions refer to them unless a module the engine parsed binds the name.
+*/
+void une_resolve(une_node *module_body)
+{
+    une_resolve_shadowed_natives(module_body);
+    une_resolve_node(NULL, module_body);
+}
+
+/*
+*** Helpers.
+*/
+
+/*
+Resolve the names in a node and its children. rs is NULL outside of function bodies.
+*/
+une_static__ void une_resolve_node(une_resolver_state *rs, une_node *node)
+{
+    if (node == NULL)
+        return;
+    assert(UNE_NODE_KIND_IS_VALID(node->kind));
+
+    switch (node->kind) {
+
+    /* Data. */
+    case UNE_NK_NAME:
+    case UNE_NK_SIZE:
+    case UNE_NK_ID:
+    case UNE_NK_VOID:
+    case UNE_NK_INT:
+    case UNE_NK_FLT:
+    case UNE_NK_STR:
+    case UNE_NK_NATIVE:
+    case UNE_NK_BREAK:
+    case UNE_NK_CONTINUE:
+    case UNE_NK_THIS:
+        break;
+
+    /* Node lists. */
+    case UNE_NK_LIST:
+    case UNE_NK_OBJECT:
+    case UNE_NK_STMTS: {
+        UNE_UNPACK_NODE_LIST(node, list, size);
+        UNE_FOR_NODE_LIST_ITEM(i, size)
+        une_resolve_node(rs, list[i]);
+        break;
+    }
+
+    /* Function bodies get their own frame. */
+    case UNE_NK_FUNCTION:
+        une_resolve_function(node);
+        break;
+
+    /* Variables. */
+    case UNE_NK_SEEK:
+        if (!une_resolve_native(node))
+            une_resolve_name(rs, node->content.branch.a);
+        break;
+    case UNE_NK_FOR_RANGE:
+    case UNE_NK_FOR_ELEMENT:
+        une_resolve_name(rs, node->content.branch.a);
+        une_resolve_node(rs, node->content.branch.b);
+        une_resolve_node(rs, node->content.branch.c);
+        une_resolve_node(rs, node->content.branch.d);
+        break;
+
+    /* Nodes. */
+    default:
+        une_resolve_node(rs, node->content.branch.a);
+        une_resolve_node(rs, node->content.branch.b);
+        une_resolve_node(rs, node->content.branch.c);
+        une_resolve_node(rs, node->content.branch.d);
+        break;
+    }
+}
+
+/*
+Resolve a function body, reserving the first slots for its parameters, and register its callable.
+*/
+une_static__ void une_resolve_function(une_node *node)
+{
+    assert(node->kind == UNE_NK_FUNCTION);
+
+    une_resolver_state rs = une_resolver_state_create();
+
+    /* Parameters are defined in order when the function is called, see une_type_function_call. */
+    UNE_UNPACK_NODE_LIST(node->content.branch.a, parameters, parameters_count);
+    une_symbol *names = NULL;
+    if (parameters_count > 0) {
+        names = malloc(parameters_count * sizeof(*names));
+        verify(names);
+    }
+    UNE_FOR_NODE_LIST_ITEM(i, parameters_count)
+    {
+        names[i - 1] = (une_symbol)parameters[i]->content.value._id;
+        une_resolver_state_add(&rs, names[i - 1]);
+    }
+
+    une_resolve_node(&rs, node->content.branch.b);
+
+    /* Every evaluation of the literal shares this callable. The body stays owned by the module's
+    syntax tree, which lives as long as the engine. */
+    une_callable *callable = une_callables_add_callable(&felix->is.callables);
+    assert(callable);
+    assert(node->content.branch.c->kind == UNE_NK_ID);
+    callable->module_id = node->content.branch.c->content.value._id;
+    callable->position = node->pos;
+    callable->parameters.count = parameters_count;
+    callable->parameters.names = names;
+    callable->body = node->content.branch.b;
+    callable->borrows_body = true;
+    callable->slots_count = rs.count;
+
+    assert(node->content.branch.d->kind == UNE_NK_ID);
+    node->content.branch.d->content.value._id = callable->id;
+
+    une_module *module = une_modules_get_module_by_id(felix->is.modules, callable->module_id);
+    assert(module);
+    une_module_add_callable(module, callable->id);
+
+    une_resolver_state_free(&rs);
+}
+
+/*
+Assign a slot to a name inside a function body.
+*/
+une_static__ void une_resolve_name(une_resolver_state *rs, une_node *name)
+{
+    assert(name && name->kind == UNE_NK_NAME);
+    if (rs)
+        name->slot = une_resolver_state_slot(rs, (une_symbol)name->content.value._id);
+}
+
+/*
+Record the natives whose names a node and its children bind: assigned variables, loop variables and
+parameters.
+*/
+une_static__ void une_resolve_shadowed_natives(une_node *node)
+{
+    if (node == NULL)
+        return;
+    assert(UNE_NODE_KIND_IS_VALID(node->kind));
+
+    switch (node->kind) {
+
+    /* Data. */
+    case UNE_NK_NAME:
+    case UNE_NK_SIZE:
+    case UNE_NK_ID:
+    case UNE_NK_VOID:
+    case UNE_NK_INT:
+    case UNE_NK_FLT:
+    case UNE_NK_STR:
+    case UNE_NK_NATIVE:
+    case UNE_NK_BREAK:
+    case UNE_NK_CONTINUE:
+    case UNE_NK_THIS:
+        return;
+
+    /* Node lists. */
+    case UNE_NK_LIST:
+    case UNE_NK_OBJECT:
+    case UNE_NK_STMTS: {
+        UNE_UNPACK_NODE_LIST(node, list, size);
+        UNE_FOR_NODE_LIST_ITEM(i, size)
+        une_resolve_shadowed_natives(list[i]);
+        return;
+    }
+
+    /* Bindings. */
+    case UNE_NK_FUNCTION: {
+        UNE_UNPACK_NODE_LIST(node->content.branch.a, parameters, parameters_count);
+        UNE_FOR_NODE_LIST_ITEM(i, parameters_count)
+        une_resolve_shadow(parameters[i]);
+        une_resolve_shadowed_natives(node->content.branch.b);
+        return;
+    }
+    case UNE_NK_FOR_RANGE:
+    case UNE_NK_FOR_ELEMENT:
+        une_resolve_shadow(node->content.branch.a);
+        break;
+    case UNE_NK_SEEK:
+        return;
+    default:
+        if (node->kind >= UNE_R_BGN_ASSIGNMENT_NODES && node->kind <= UNE_R_END_ASSIGNMENT_NODES &&
+            node->content.branch.a->kind == UNE_NK_SEEK)
+            une_resolve_shadow(node->content.branch.a->content.branch.a);
+        une_resolve_shadowed_natives(node->content.branch.a);
+        break;
+    }
+    une_resolve_shadowed_natives(node->content.branch.b);
+    une_resolve_shadowed_natives(node->content.branch.c);
+    une_resolve_shadowed_natives(node->content.branch.d);
+}
+
+/*
+Record that a name no longer refers to the native function of the same name, if there is one.
+*/
+une_static__ void une_resolve_shadow(une_node *name)
+{
+    assert(name && name->kind == UNE_NK_NAME);
+    une_native native = une_native_symbol_to_function((une_symbol)name->content.value._id);
+    if (native != UNE_NATIVE_none__)
+        felix->shadowed_natives |= UINT64_C(1) << native;
+}
+
+/*
+Turn a variable into the native function of the same name, unless the name is bound. Return whether
+it was turned.
+*/
+une_static__ bool une_resolve_native(une_node *node)
+{
+    assert(node->kind == UNE_NK_SEEK);
+    une_node *name = node->content.branch.a;
+    une_native native = une_native_symbol_to_function((une_symbol)name->content.value._id);
+    if (native == UNE_NATIVE_none__ || felix->shadowed_natives & UINT64_C(1) << native)
+        return false;
+    une_node_free(name, false);
+    node->content.branch.b = NULL; /* Global flag. */
+    node->kind = UNE_NK_NATIVE;
+    node->content.value._int = (une_int)native;
+    return true;
+}
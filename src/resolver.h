@@ -0,0 +1,30 @@
+/*
+resolver.h - Une
+*/
+
+#ifndef UNE_RESOLVER_H
+#define UNE_RESOLVER_H
+
+/* Header-specific includes. */
+#include "common.h"
+#include "struct/node.h"
+#include "struct/resolver_state.h"
+
+/*
+*** Interface.
+*/
+
+void une_resolve(une_node *module_body);
+
+/*
+*** Helpers.
+*/
+
+une_static__ void une_resolve_node(une_resolver_state *rs, une_node *node);
+une_static__ void une_resolve_function(une_node *node);
+une_static__ void une_resolve_name(une_resolver_state *rs, une_node *name);
+une_static__ void une_resolve_shadowed_natives(une_node *node);
+une_static__ void une_resolve_shadow(une_node *name);
+une_static__ bool une_resolve_native(une_node *node);
+
+#endif /* !UNE_RESOLVER_H */
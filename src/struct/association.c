@@ -15,7 +15,7 @@ une_association *une_association_create(void)
 {
     une_association *association = malloc(sizeof(*association));
     verify(association);
-    association->name = NULL;
+    association->name = UNE_SYMBOL_NONE;
     association->content = une_result_create(UNE_RK_VOID);
     return association;
 }
@@ -25,8 +25,6 @@ Free all members of a une_association.
 */
 void une_association_free(une_association *association)
 {
-    if (association->name)
-        free(association->name);
     une_result_free(association->content);
     free(association);
 }
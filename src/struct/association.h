@@ -9,13 +9,14 @@ association.h - Une
 #include "../common.h"
 #include "node.h"
 #include "result.h"
+#include "symbols.h"
 
 /*
 Associate a result with a given name.
 */
 typedef struct une_association_
 {
-    wchar_t *name;
+    une_symbol name;
     une_result content;
 } une_association;
 
@@ -19,14 +19,13 @@ static void une_callable_clear(une_callable *callable)
 
     if (callable->parameters.count > 0) {
         assert(callable->parameters.names);
-        for (size_t i = 0; i < callable->parameters.count; i++) {
-            assert(callable->parameters.names[i]);
-            free(callable->parameters.names[i]);
-        }
         free(callable->parameters.names);
     }
 
-    if (callable->body)
+    if (callable->chunk)
+        une_chunk_free(callable->chunk);
+
+    if (callable->body && !callable->borrows_body)
         une_node_free(callable->body, !callable->borrows_body_strings);
 }
 
@@ -36,10 +35,17 @@ une_callables une_callables_create(void)
 
     une_callable *buffer = malloc(size * sizeof(*buffer));
     verify(buffer);
-    for (size_t i = 0; i < size; i++)
-        buffer[i] = (une_callable){.id = 0};
-
-    return (une_callables){.buffer = buffer, .size = size, .next_unused_id = 1};
+    size_t *generations = malloc(size * sizeof(*generations));
+    verify(generations);
+    size_t *free_indices = malloc(size * sizeof(*free_indices));
+    verify(free_indices);
+
+    return (une_callables){.buffer = buffer,
+                           .generations = generations,
+                           .free_indices = free_indices,
+                           .free_count = 0,
+                           .size = size,
+                           .count = 0};
 }
 
 une_callable *une_callables_add_callable(une_callables *callables)
@@ -48,20 +54,27 @@ une_callable *une_callables_add_callable(une_callables *callables)
     assert(callables->buffer);
 
     size_t index;
-    for (index = 0; index < callables->size; index++) {
-        if (callables->buffer[index].id == 0)
-            break;
-    }
-    if (index == callables->size) {
-        callables->size *= 2;
-        callables->buffer =
-            realloc(callables->buffer, callables->size * sizeof(*callables->buffer));
-        verify(callables->buffer);
-        for (size_t i = index; i < callables->size; i++)
-            callables->buffer[i] = (une_callable){.id = 0};
+    if (callables->free_count > 0) {
+        index = callables->free_indices[--callables->free_count];
+    } else {
+        if (callables->count == callables->size) {
+            callables->size *= 2;
+            callables->buffer =
+                realloc(callables->buffer, callables->size * sizeof(*callables->buffer));
+            verify(callables->buffer);
+            callables->generations =
+                realloc(callables->generations, callables->size * sizeof(*callables->generations));
+            verify(callables->generations);
+            callables->free_indices = realloc(callables->free_indices,
+                                              callables->size * sizeof(*callables->free_indices));
+            verify(callables->free_indices);
+        }
+        index = callables->count++;
+        callables->generations[index] = 0;
     }
 
-    callables->buffer[index] = (une_callable){.id = callables->next_unused_id++};
+    callables->buffer[index] =
+        (une_callable){.id = UNE_HANDLE_CREATE(index, callables->generations[index])};
 
     return callables->buffer + index;
 }
@@ -70,22 +83,38 @@ une_callable *une_callables_get_callable_by_id(une_callables callables, size_t i
 {
     assert(callables.buffer);
 
-    for (size_t i = 0; i < callables.size; i++) {
-        if (callables.buffer[i].id == id)
-            return callables.buffer + i;
-    }
+    /* An id of 0 wraps around to an out-of-range index. */
+    size_t index = UNE_HANDLE_INDEX(id);
+    if (index >= callables.count || callables.buffer[index].id != id)
+        return NULL;
+
+    return callables.buffer + index;
+}
+
+void une_callables_remove_callable(une_callables *callables, size_t id)
+{
+    assert(callables);
+
+    une_callable *callable = une_callables_get_callable_by_id(*callables, id);
+    assert(callable);
 
-    return NULL;
+    size_t index = (size_t)(callable - callables->buffer);
+    une_callable_clear(callable);
+    callables->generations[index] = (callables->generations[index] + 1) & UNE_HANDLE_INDEX_MASK;
+    callables->free_indices[callables->free_count++] = index;
 }
 
 void une_callables_free(une_callables *callables)
 {
     assert(callables);
 
-    for (size_t i = 0; i < callables->size; i++)
+    for (size_t i = 0; i < callables->count; i++)
         une_callable_clear(callables->buffer + i);
     free(callables->buffer);
+    free(callables->generations);
+    free(callables->free_indices);
 
     callables->size = 0;
-    callables->next_unused_id = 0;
+    callables->count = 0;
+    callables->free_count = 0;
 }
@@ -7,33 +7,44 @@ callable.h - Une
 
 /* Header-specific includes. */
 #include "../common.h"
+#include "chunk.h"
+#include "handle.h"
 #include "node.h"
+#include "symbols.h"
 
 /*
 A callable.
 */
 typedef struct une_callable_
 {
-    size_t id;
+    size_t id; /* A generational handle, 0 marks an unused slot. */
     size_t module_id;
     une_position position;
     struct
     {
         size_t count;
-        wchar_t **names;
+        une_symbol *names;
     } parameters;
     une_node *body;
+    size_t slots_count; /* Number of frame slots assigned by the resolver. */
+    bool borrows_body; /* The body belongs to the syntax tree of a function literal. */
     bool borrows_body_strings;
+    une_chunk *chunk; /* Compiled lazily from body. */
+    bool is_uncompilable;
+    bool is_lent; /* A function result refers to it, so it may outlive the run of its module. */
 } une_callable;
 
 /*
-A buffer of callables.
+A registry of callables, indexed by their handles.
 */
 typedef struct une_callables
 {
     une_callable *buffer;
+    size_t *generations; /* Current generation of each slot. */
+    size_t *free_indices; /* Reclaimed slots, reused before new ones. */
+    size_t free_count;
     size_t size;
-    size_t next_unused_id;
+    size_t count; /* Slots handed out so far. */
 } une_callables;
 
 /*
@@ -43,6 +54,7 @@ typedef struct une_callables
 une_callables une_callables_create(void);
 une_callable *une_callables_add_callable(une_callables *callables);
 une_callable *une_callables_get_callable_by_id(une_callables callables, size_t id);
+void une_callables_remove_callable(une_callables *callables, size_t id);
 void une_callables_free(une_callables *callables);
 
 #endif /* !UNE_CALLA_H */
@@ -0,0 +1,280 @@
+/*
+chunk.c - Une
+*/
+
+/* Header-specific includes. */
+#include "chunk.h"
+
+/* Implementation-specific includes. */
+#include "../tools.h"
+
+#ifdef UNE_DEBUG
+/*
+Opcode name table.
+*/
+const wchar_t *une_opcode_table[] = {
+    L"LOAD",
+    L"EVAL",
+    L"DEREFERENCE",
+    L"CLEAR",
+    L"MOVE",
+    L"LIST",
+    L"THIS",
+    L"SEEK",
+    L"SEEK_OR_CREATE",
+    L"SEEK_VALUE",
+    L"ASSIGN",
+    L"OPERATE_CHECK",
+    L"OPERATE",
+    L"INDEX_CHECK",
+    L"INDEX",
+    L"RANGE",
+    L"MEMBER",
+    L"ADD",
+    L"SUB",
+    L"MUL",
+    L"FDIV",
+    L"DIV",
+    L"MOD",
+    L"POW",
+    L"NEGATE",
+    L"EQU",
+    L"NEQ",
+    L"GEQ",
+    L"GTR",
+    L"LEQ",
+    L"LSS",
+    L"ADD_INT",
+    L"SUB_INT",
+    L"MUL_INT",
+    L"ADD_FLT",
+    L"SUB_FLT",
+    L"MUL_FLT",
+    L"ADD_STR",
+    L"EQU_INT",
+    L"NEQ_INT",
+    L"GEQ_INT",
+    L"GTR_INT",
+    L"LEQ_INT",
+    L"LSS_INT",
+    L"EQU_FLT",
+    L"NEQ_FLT",
+    L"GEQ_FLT",
+    L"GTR_FLT",
+    L"LEQ_FLT",
+    L"LSS_FLT",
+    L"EQU_STR",
+    L"NEQ_STR",
+    L"CONCATENATE",
+    L"NOT",
+    L"JUMP",
+    L"JUMP_IF_FALSE",
+    L"AND",
+    L"OR",
+    L"NULLISH",
+    L"AS_INT",
+    L"ASSERT",
+    L"CALL",
+    L"TAIL_CALL",
+    L"BLOCK_BEGIN",
+    L"BLOCK_END",
+    L"STATEMENT",
+    L"RETURN",
+    L"EXIT",
+    L"COVER_BEGIN",
+    L"COVER_END",
+    L"FOR_RANGE_BEGIN",
+    L"FOR_RANGE_SET",
+    L"FOR_RANGE_NEXT",
+    L"FOR_ELEMENT_BEGIN",
+    L"FOR_ELEMENT_SET",
+    L"FOR_ELEMENT_NEXT",
+    L"END",
+};
+#endif /* UNE_DEBUG */
+
+/*
+Allocate, initialize, and return a pointer to a une_chunk struct.
+*/
+une_chunk *une_chunk_create(void)
+{
+    une_chunk *chunk = malloc(sizeof(*chunk));
+    verify(chunk);
+
+    chunk->code_size = UNE_SIZE_CHUNK_CODE;
+    chunk->code_count = 0;
+    chunk->code = malloc(chunk->code_size * sizeof(*chunk->code));
+    verify(chunk->code);
+    chunk->nodes = malloc(chunk->code_size * sizeof(*chunk->nodes));
+    verify(chunk->nodes);
+
+    chunk->constants_size = UNE_SIZE_CHUNK_CONSTANTS;
+    chunk->constants_count = 0;
+    chunk->constants = malloc(chunk->constants_size * sizeof(*chunk->constants));
+    verify(chunk->constants);
+
+    chunk->loops_size = UNE_SIZE_CHUNK_LOOPS;
+    chunk->loops_count = 0;
+    chunk->loops = malloc(chunk->loops_size * sizeof(*chunk->loops));
+    verify(chunk->loops);
+
+    chunk->caches_size = UNE_SIZE_CHUNK_CACHES;
+    chunk->caches_count = 0;
+    chunk->caches = malloc(chunk->caches_size * sizeof(*chunk->caches));
+    verify(chunk->caches);
+
+    chunk->registers_count = 0;
+    chunk->blocks_depth = 0;
+    chunk->covers_depth = 0;
+
+    return chunk;
+}
+
+/*
+Free a une_chunk and all its constants.
+*/
+void une_chunk_free(une_chunk *chunk)
+{
+    assert(chunk);
+
+    for (size_t i = 0; i < chunk->constants_count; i++)
+        une_result_free(chunk->constants[i]);
+    free(chunk->constants);
+    free(chunk->code);
+    free(chunk->nodes);
+    free(chunk->loops);
+    free(chunk->caches);
+    free(chunk);
+}
+
+/*
+Append an instruction to a une_chunk, returning its index.
+*/
+size_t une_chunk_emit(
+    une_chunk *chunk, une_opcode opcode, une_node *node, uint16_t a, uint16_t b, uint16_t c)
+{
+    assert(chunk);
+    assert(UNE_OPCODE_IS_VALID(opcode));
+
+    /* Ensure buffers are big enough. */
+    if (chunk->code_count >= chunk->code_size) {
+        chunk->code_size *= 2;
+        chunk->code = realloc(chunk->code, chunk->code_size * sizeof(*chunk->code));
+        verify(chunk->code);
+        chunk->nodes = realloc(chunk->nodes, chunk->code_size * sizeof(*chunk->nodes));
+        verify(chunk->nodes);
+    }
+
+    chunk->code[chunk->code_count] =
+        (une_instruction){.opcode = (uint16_t)opcode, .a = a, .b = b, .c = c};
+    chunk->nodes[chunk->code_count] = node;
+    return chunk->code_count++;
+}
+
+/*
+Store a jump target in the 'b' and 'c' operands of an instruction.
+*/
+void une_chunk_patch_target(une_chunk *chunk, size_t instruction, size_t target)
+{
+    assert(chunk);
+    assert(instruction < chunk->code_count);
+    assert(target <= UNE_CHUNK_TARGET_MAX);
+
+    chunk->code[instruction].b = (uint16_t)(target & 0xFFFF);
+    chunk->code[instruction].c = (uint16_t)(target >> 16);
+}
+
+/*
+Add a constant to a une_chunk, returning its index. The chunk takes ownership of the constant.
+*/
+size_t une_chunk_add_constant(une_chunk *chunk, une_result constant)
+{
+    assert(chunk);
+
+    /* Ensure buffer is big enough. */
+    if (chunk->constants_count >= chunk->constants_size) {
+        chunk->constants_size *= 2;
+        chunk->constants =
+            realloc(chunk->constants, chunk->constants_size * sizeof(*chunk->constants));
+        verify(chunk->constants);
+    }
+
+    chunk->constants[chunk->constants_count] = constant;
+    return chunk->constants_count++;
+}
+
+/*
+Add a loop to a une_chunk, returning its index. Its targets are set once they are known.
+*/
+size_t une_chunk_add_loop(une_chunk *chunk, size_t depth, size_t registers)
+{
+    assert(chunk);
+
+    /* Ensure buffer is big enough. */
+    if (chunk->loops_count >= chunk->loops_size) {
+        chunk->loops_size *= 2;
+        chunk->loops = realloc(chunk->loops, chunk->loops_size * sizeof(*chunk->loops));
+        verify(chunk->loops);
+    }
+
+    chunk->loops[chunk->loops_count] = (une_chunk_loop){
+        .depth = depth, .registers = registers, .break_target = 0, .continue_target = 0};
+    return chunk->loops_count++;
+}
+
+/*
+Add an empty inline cache to a une_chunk, returning its index.
+*/
+size_t une_chunk_add_cache(une_chunk *chunk)
+{
+    assert(chunk);
+
+    /* Ensure buffer is big enough. */
+    if (chunk->caches_count >= chunk->caches_size) {
+        chunk->caches_size *= 2;
+        chunk->caches = realloc(chunk->caches, chunk->caches_size * sizeof(*chunk->caches));
+        verify(chunk->caches);
+    }
+
+    chunk->caches[chunk->caches_count] = (une_chunk_cache){.shape = NULL, .offset = 0};
+    return chunk->caches_count++;
+}
+
+#ifdef UNE_DEBUG
+/*
+Return a text representation of a une_opcode.
+*/
+const wchar_t *une_opcode_to_wcs(une_opcode opcode)
+{
+    assert(UNE_OPCODE_IS_VALID(opcode));
+
+    return une_opcode_table[opcode - 1];
+}
+
+/*
+Print a text representation of a une_chunk.
+*/
+void une_chunk_display(une_chunk *chunk)
+{
+    assert(chunk);
+
+    wprintf(UNE_COLOR_HINT L"registers: %zu, constants: %zu, loops: %zu" UNE_COLOR_RESET L"\n",
+            chunk->registers_count,
+            chunk->constants_count,
+            chunk->loops_count);
+    for (size_t i = 0; i < chunk->code_count; i++) {
+        une_instruction instruction = chunk->code[i];
+        wprintf(L"%4zu " UNE_COLOR_TOKEN_KIND L"%-18ls" UNE_COLOR_RESET L"%5u %5u %5u",
+                i,
+                une_opcode_to_wcs((une_opcode)instruction.opcode),
+                instruction.a,
+                instruction.b,
+                instruction.c);
+        if (chunk->nodes[i])
+            wprintf(UNE_COLOR_HINT L"  %zu-%zu" UNE_COLOR_RESET,
+                    chunk->nodes[i]->pos.start,
+                    chunk->nodes[i]->pos.end);
+        putwc(L'\n', stdout);
+    }
+}
+#endif /* UNE_DEBUG */
@@ -0,0 +1,206 @@
+/*
+chunk.h - Une
+*/
+
+#ifndef UNE_CHUNK_H
+#define UNE_CHUNK_H
+
+/* Header-specific includes. */
+#include "../common.h"
+#include "node.h"
+#include "result.h"
+#include "shape.h"
+
+/*
+Kind of une_instruction.
+*/
+typedef enum une_opcode_
+{
+    UNE_OP_none__,
+    UNE_OP_LOAD,
+    UNE_OP_EVAL,
+    UNE_OP_DEREFERENCE,
+    UNE_OP_CLEAR,
+    UNE_OP_MOVE,
+    UNE_OP_LIST,
+    UNE_OP_THIS,
+    UNE_OP_SEEK,
+    UNE_OP_SEEK_OR_CREATE,
+    UNE_OP_SEEK_VALUE,
+    UNE_OP_ASSIGN,
+    UNE_OP_OPERATE_CHECK,
+    UNE_OP_OPERATE,
+    UNE_OP_INDEX_CHECK,
+    UNE_OP_INDEX,
+    UNE_OP_RANGE,
+    UNE_OP_MEMBER,
+#define UNE_R_BGN_ARITHMETIC_OPCODES UNE_OP_ADD
+    UNE_OP_ADD,
+    UNE_OP_SUB,
+    UNE_OP_MUL,
+    UNE_OP_FDIV,
+    UNE_OP_DIV,
+    UNE_OP_MOD,
+    UNE_OP_POW,
+#define UNE_R_END_ARITHMETIC_OPCODES UNE_OP_POW
+    UNE_OP_NEGATE,
+#define UNE_R_BGN_COMPARISON_OPCODES UNE_OP_EQU
+    UNE_OP_EQU,
+    UNE_OP_NEQ,
+    UNE_OP_GEQ,
+    UNE_OP_GTR,
+    UNE_OP_LEQ,
+    UNE_OP_LSS,
+#define UNE_R_END_COMPARISON_OPCODES UNE_OP_LSS
+#define UNE_R_BGN_QUICKENED_OPCODES UNE_OP_ADD_INT
+    UNE_OP_ADD_INT,
+    UNE_OP_SUB_INT,
+    UNE_OP_MUL_INT,
+    UNE_OP_ADD_FLT,
+    UNE_OP_SUB_FLT,
+    UNE_OP_MUL_FLT,
+    UNE_OP_ADD_STR,
+    UNE_OP_EQU_INT,
+    UNE_OP_NEQ_INT,
+    UNE_OP_GEQ_INT,
+    UNE_OP_GTR_INT,
+    UNE_OP_LEQ_INT,
+    UNE_OP_LSS_INT,
+    UNE_OP_EQU_FLT,
+    UNE_OP_NEQ_FLT,
+    UNE_OP_GEQ_FLT,
+    UNE_OP_GTR_FLT,
+    UNE_OP_LEQ_FLT,
+    UNE_OP_LSS_FLT,
+    UNE_OP_EQU_STR,
+    UNE_OP_NEQ_STR,
+#define UNE_R_END_QUICKENED_OPCODES UNE_OP_NEQ_STR
+    UNE_OP_CONCATENATE,
+    UNE_OP_NOT,
+    UNE_OP_JUMP,
+    UNE_OP_JUMP_IF_FALSE,
+    UNE_OP_AND,
+    UNE_OP_OR,
+    UNE_OP_NULLISH,
+    UNE_OP_AS_INT,
+    UNE_OP_ASSERT,
+    UNE_OP_CALL,
+    UNE_OP_TAIL_CALL,
+    UNE_OP_BLOCK_BEGIN,
+    UNE_OP_BLOCK_END,
+    UNE_OP_STATEMENT,
+    UNE_OP_RETURN,
+    UNE_OP_EXIT,
+    UNE_OP_COVER_BEGIN,
+    UNE_OP_COVER_END,
+    UNE_OP_FOR_RANGE_BEGIN,
+    UNE_OP_FOR_RANGE_SET,
+    UNE_OP_FOR_RANGE_NEXT,
+    UNE_OP_FOR_ELEMENT_BEGIN,
+    UNE_OP_FOR_ELEMENT_SET,
+    UNE_OP_FOR_ELEMENT_NEXT,
+    UNE_OP_END,
+    UNE_OP_max__,
+} une_opcode;
+
+/*
+A single bytecode instruction.
+*/
+typedef struct une_instruction_
+{
+    uint16_t opcode;
+    uint16_t a;
+    uint16_t b;
+    uint16_t c;
+} une_instruction;
+
+/*
+Jump targets of a loop, used to resolve 'break' and 'continue'.
+*/
+typedef struct une_chunk_loop_
+{
+    size_t depth; /* Number of open blocks outside the loop. */
+    size_t registers; /* First register owned by the loop body. */
+    size_t break_target;
+    size_t continue_target;
+} une_chunk_loop;
+
+/*
+A monomorphic inline cache, remembering where the last object accessed by an instruction kept the
+member.
+*/
+typedef struct une_chunk_cache_
+{
+    une_shape *shape;
+    size_t offset;
+} une_chunk_cache;
+
+/*
+Compiled bytecode of a callable body.
+*/
+typedef struct une_chunk_
+{
+    une_instruction *code;
+    une_node **nodes; /* The node each instruction was compiled from. */
+    size_t code_size;
+    size_t code_count;
+    une_result *constants;
+    size_t constants_size;
+    size_t constants_count;
+    une_chunk_loop *loops;
+    size_t loops_size;
+    size_t loops_count;
+    une_chunk_cache *caches;
+    size_t caches_size;
+    size_t caches_count;
+    size_t registers_count;
+    size_t blocks_depth;
+    size_t covers_depth;
+} une_chunk;
+
+/*
+*** Interface.
+*/
+
+/*
+Condition to check whether a une_opcode is valid.
+*/
+#define UNE_OPCODE_IS_VALID(opcode) (opcode > UNE_OP_none__ && opcode < UNE_OP_max__)
+
+/*
+The largest value an instruction operand can hold.
+*/
+#define UNE_CHUNK_OPERAND_MAX UINT16_MAX
+
+/*
+Operand marking the absence of an enclosing loop.
+*/
+#define UNE_CHUNK_NO_LOOP UNE_CHUNK_OPERAND_MAX
+
+/*
+Get the jump target stored in the 'b' and 'c' operands of an instruction.
+*/
+#define UNE_INSTRUCTION_TARGET(instruction)                                                        \
+    ((size_t)(instruction).b | (size_t)(instruction).c << 16)
+
+/*
+The largest jump target an instruction can hold.
+*/
+#define UNE_CHUNK_TARGET_MAX UINT32_MAX
+
+une_chunk *une_chunk_create(void);
+void une_chunk_free(une_chunk *chunk);
+
+size_t une_chunk_emit(
+    une_chunk *chunk, une_opcode opcode, une_node *node, uint16_t a, uint16_t b, uint16_t c);
+void une_chunk_patch_target(une_chunk *chunk, size_t instruction, size_t target);
+size_t une_chunk_add_constant(une_chunk *chunk, une_result constant);
+size_t une_chunk_add_loop(une_chunk *chunk, size_t depth, size_t registers);
+size_t une_chunk_add_cache(une_chunk *chunk);
+
+#ifdef UNE_DEBUG
+const wchar_t *une_opcode_to_wcs(une_opcode opcode);
+void une_chunk_display(une_chunk *chunk);
+#endif /* UNE_DEBUG */
+
+#endif /* !UNE_CHUNK_H */
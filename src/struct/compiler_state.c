@@ -0,0 +1,19 @@
+/*
+compiler_state.c - Une
+*/
+
+/* Header-specific includes. */
+#include "compiler_state.h"
+
+/*
+Initialize a une_compiler_state struct.
+*/
+une_compiler_state une_compiler_state_create(void)
+{
+    return (une_compiler_state){.chunk = NULL,
+                                .loop = UNE_CHUNK_NO_LOOP,
+                                .blocks_depth = 0,
+                                .covers_depth = 0,
+                                .constructs_depth = 0,
+                                .failed = false};
+}
@@ -0,0 +1,31 @@
+/*
+compiler_state.h - Une
+*/
+
+#ifndef UNE_COMPILER_STATE_H
+#define UNE_COMPILER_STATE_H
+
+/* Header-specific includes. */
+#include "../common.h"
+#include "chunk.h"
+
+/*
+Holds the state of the compiler.
+*/
+typedef struct une_compiler_state_
+{
+    une_chunk *chunk;
+    size_t loop; /* Innermost loop, or UNE_CHUNK_NO_LOOP. */
+    size_t blocks_depth;
+    size_t covers_depth;
+    size_t constructs_depth; /* Number of enclosing bodies whose result is dereferenced. */
+    bool failed;
+} une_compiler_state;
+
+/*
+*** Interface.
+*/
+
+une_compiler_state une_compiler_state_create(void);
+
+#endif /* !UNE_COMPILER_STATE_H */
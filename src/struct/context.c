@@ -9,39 +9,82 @@ context.c - Une
 #include "../tools.h"
 
 /*
-Allocates, initializes, and returns a pointer to a transparent une_context struct.
+Initialize an empty une_contexts stack.
 */
-une_context *une_context_create_transparent(void)
+une_contexts une_contexts_create(void)
 {
-    /* Allocate une_context. */
-    une_context *context = malloc(sizeof(*context));
-    verify(context);
+    return (une_contexts){.segments_count = 0, .segment = 0, .count = 0};
+}
 
-    /* Initialize une_context. */
-    *context = (une_context){.is_transparent = true};
+/*
+Free the segments of a une_contexts stack. All contexts must have been freed.
+*/
+void une_contexts_free(une_contexts *contexts)
+{
+    assert(contexts->segment == 0 && contexts->count == 0);
+    for (size_t i = 0; i < contexts->segments_count; i++)
+        free(contexts->segments[i]);
+    contexts->segments_count = 0;
+}
+
+/*
+Initializes and returns a pointer to a transparent une_context struct on top of the stack.
+*/
+une_context *une_context_create_transparent(une_contexts *contexts)
+{
+    une_context *context = une_context_push(contexts);
+
+    /* Initialize une_context. The inline buffers are left uninitialized. */
+    context->parent = NULL;
+    context->label = UNE_SYMBOL_NONE;
+    context->module_id = 0;
+    context->callable_id = 0;
+    context->exit_position = (une_position){0};
+    context->is_transparent = true;
+    context->variables.size = 0;
+    context->variables.count = 0;
+    context->variables.buffer = NULL;
+    context->slots.count = 0;
+    context->slots.buffer = NULL;
 
     return context;
 }
 
 /*
-Allocates, initializes, and returns a pointer to a une_context struct.
+Initializes and returns a pointer to a une_context struct on top of the stack.
 */
-une_context *une_context_create(void)
+une_context *une_context_create(une_contexts *contexts)
 {
     /* Create transparent context. */
-    une_context *context = une_context_create_transparent();
+    une_context *context = une_context_create_transparent(contexts);
 
     /* Promote to full context. */
     context->is_transparent = false;
     context->variables.size = UNE_SIZE_VARIABLE_BUF;
-    context->variables.count = 0;
-    context->variables.buffer =
-        malloc(context->variables.size * sizeof(*context->variables.buffer));
-    verify(context->variables.buffer);
+    context->variables.buffer = context->variables.inline_buffer;
 
     return context;
 }
 
+/*
+Allocate the slots of a function context, see une_resolve.
+*/
+void une_context_create_slots(une_context *context, size_t count)
+{
+    assert(!context->is_transparent);
+    assert(context->slots.buffer == NULL);
+    if (count == 0)
+        return;
+    context->slots.count = count;
+    if (count <= UNE_SIZE_VARIABLE_BUF) {
+        context->slots.buffer = context->slots.inline_buffer;
+        memset(context->slots.buffer, 0, count * sizeof(*context->slots.buffer));
+        return;
+    }
+    context->slots.buffer = calloc(count, sizeof(*context->slots.buffer));
+    verify(context->slots.buffer);
+}
+
 /*
 Find and return the oldest parent of the incoming context.
 */
@@ -84,50 +127,85 @@ une_context *une_context_get_opaque_self_or_youngest_opaque_parent_or_null(une_c
 /*
 Frees all une_contexts, starting at youngest_child and up to, but not including, parent.
 */
-void une_context_free_children(une_context *parent, une_context *youngest_child)
+void une_context_free_children(une_contexts *contexts,
+                               une_context *parent,
+                               une_context *youngest_child)
 {
     une_context *context = youngest_child;
     while (context != parent) {
         une_context *older_context = context->parent;
-        une_context_free(context);
+        une_context_free(contexts, context);
         context = older_context;
     }
 }
 
 /*
-Frees a une_context and its owned members.
+Frees a une_context and its owned members. The context must be the youngest on the stack.
 */
-void une_context_free(une_context *context)
+void une_context_free(une_contexts *contexts, une_context *context)
 {
-    /* Free label. */
-    if (context->label)
-        free(context->label);
+    assert(contexts->count > 0);
+    assert(context == &contexts->segments[contexts->segment][contexts->count - 1]);
 
     /* Free une_association buffer. */
     if (!context->is_transparent) {
         assert(context->variables.buffer);
-        for (size_t i = 0; i < context->variables.count; i++)
+        size_t inline_count = context->variables.count < UNE_SIZE_VARIABLE_BUF
+                                  ? context->variables.count
+                                  : UNE_SIZE_VARIABLE_BUF;
+        for (size_t i = 0; i < inline_count; i++)
+            une_result_free(context->variables.inline_associations[i].content);
+        for (size_t i = inline_count; i < context->variables.count; i++)
             une_association_free(context->variables.buffer[i]);
-        free(context->variables.buffer);
+        if (context->variables.buffer != context->variables.inline_buffer)
+            free(context->variables.buffer);
+        if (context->slots.buffer && context->slots.buffer != context->slots.inline_buffer)
+            free(context->slots.buffer);
     }
 
-    free(context);
+    /* Pop the context. */
+    if (--contexts->count == 0 && contexts->segment > 0) {
+        contexts->segment--;
+        contexts->count = UNE_CONTEXTS_SEGMENT_SIZE(contexts->segment);
+    }
 }
 
 /*
 Free all children and return the root context.
 */
-une_context *une_context_stump(une_context *youngest_child)
+une_context *une_context_stump(une_contexts *contexts, une_context *youngest_child)
 {
     assert(youngest_child);
     do {
         une_context *parent = youngest_child->parent;
-        une_context_free(youngest_child);
+        une_context_free(contexts, youngest_child);
         youngest_child = parent;
     } while (youngest_child->parent);
     return youngest_child;
 }
 
+/*
+Move the variables of the youngest context into its opaque parent, replacing variables of the same
+name, then free it and return the parent.
+*/
+une_context *une_context_merge_into_parent(une_contexts *contexts, une_context *context)
+{
+    une_context *parent = context->parent;
+    assert(!context->is_transparent && parent && !parent->is_transparent);
+    for (size_t i = 0; i < context->variables.count; i++) {
+        une_association *variable = context->variables.buffer[i];
+        une_association *target = une_variable_find_by_name(parent, variable->name);
+        if (target)
+            une_result_free(target->content);
+        else
+            target = une_context_add_variable(parent, variable->name);
+        target->content = variable->content;
+        variable->content = une_result_create(UNE_RK_VOID);
+    }
+    une_context_free(contexts, context);
+    return parent;
+}
+
 /*
 Trace a context's lineage, ending with the root. Return the number of elements in the list.
 */
@@ -140,7 +218,7 @@ size_t une_context_get_lineage(une_context *subject, une_context ***out)
     size_t contexts_length = 0;
     une_context *context = subject;
     while (true) {
-        if (contexts_length >= UNE_SIZE_EXPECTED_TRACEBACK_DEPTH) {
+        if (contexts_length >= contexts_size) {
             contexts_size *= 2;
             contexts = realloc(contexts, contexts_size * sizeof(*contexts));
             verify(contexts);
@@ -159,14 +237,15 @@ size_t une_context_get_lineage(une_context *subject, une_context ***out)
 Find a variable.
 */
 static une_association *une_variable_find_or_create_(une_context *starting_context,
-                                                     wchar_t *name,
+                                                     une_symbol name,
                                                      une_result content,
                                                      bool global,
                                                      bool create_if_not_found)
 {
     assert(starting_context);
-    assert((name && content.kind == UNE_RK_none__) ||
-           (!name && UNE_RESULT_KIND_IS_VALID(content.kind) && !create_if_not_found));
+    assert((name != UNE_SYMBOL_NONE && content.kind == UNE_RK_none__) ||
+           (name == UNE_SYMBOL_NONE && UNE_RESULT_KIND_IS_VALID(content.kind) &&
+            !create_if_not_found));
 
     /* Return NULL by default. */
     une_association *association = NULL;
@@ -179,7 +258,7 @@ static une_association *une_variable_find_or_create_(une_context *starting_conte
     /* Find association. */
     do {
         for (size_t i = 0; i < search_context->variables.count; i++) {
-            if ((name && !wcscmp(search_context->variables.buffer[i]->name, name)) ||
+            if ((name != UNE_SYMBOL_NONE && search_context->variables.buffer[i]->name == name) ||
                 (une_result_equals_result(search_context->variables.buffer[i]->content, content))) {
                 association = search_context->variables.buffer[i];
                 break;
@@ -199,24 +278,7 @@ static une_association *une_variable_find_or_create_(une_context *starting_conte
                  : une_context_get_opaque_self_or_youngest_opaque_parent_or_null(starting_context));
         assert(target_context);
 
-        /* Ensure there is sufficient space in the association buffer. */
-        assert(target_context->variables.buffer);
-        if (target_context->variables.count >= target_context->variables.size) {
-            target_context->variables.size *= 2;
-            target_context->variables.buffer =
-                realloc(target_context->variables.buffer,
-                        target_context->variables.size * sizeof(*target_context->variables.buffer));
-            verify(target_context->variables.buffer);
-        }
-
-        /* Initialize a new association. */
-        association = une_association_create();
-        association->name = wcsdup(name);
-        verify(association->name);
-        association->content =
-            une_result_create(UNE_RK_VOID); /* Don't use UNE_RK_none__ because this will be freed
-                                               using une_result_free. */
-        target_context->variables.buffer[target_context->variables.count++] = association;
+        association = une_context_add_variable(target_context, name);
     }
 
     return association;
@@ -225,7 +287,7 @@ static une_association *une_variable_find_or_create_(une_context *starting_conte
 /*
 Initializes a new une_association in a une_context's variable buffer.
 */
-une_association *une_variable_create(une_context *context, wchar_t *name)
+une_association *une_variable_create(une_context *context, une_symbol name)
 {
     /* Find closest opaque context. */
     while (context->is_transparent) {
@@ -233,31 +295,13 @@ une_association *une_variable_create(une_context *context, wchar_t *name)
         context = context->parent;
     }
 
-    /* Ensure sufficient space in une_association buffer. */
-    assert(context->variables.buffer);
-    if (context->variables.count >= context->variables.size) {
-        context->variables.size *= 2;
-        context->variables.buffer =
-            realloc(context->variables.buffer,
-                    context->variables.size * sizeof(*context->variables.buffer));
-        verify(context->variables.buffer);
-    }
-
-    /* Initialize une_association. */
-    une_association *variable = une_association_create();
-    variable->name = wcsdup(name);
-    verify(variable->name);
-    variable->content = une_result_create(UNE_RK_VOID); /* Don't use UNE_RK_none__ because this will
-                                                           be freed using une_result_free. */
-    context->variables.buffer[context->variables.count++] = variable;
-
-    return variable;
+    return une_context_add_variable(context, name);
 }
 
 /*
 Returns a pointer to a une_association in a une_context's variable buffer or NULL.
 */
-une_association *une_variable_find_by_name(une_context *context, wchar_t *name)
+une_association *une_variable_find_by_name(une_context *context, une_symbol name)
 {
     return une_variable_find_or_create_(
         context, name, une_result_create(UNE_RK_none__), false, false);
@@ -266,7 +310,7 @@ une_association *une_variable_find_by_name(une_context *context, wchar_t *name)
 /*
 Returns a pointer to a une_association in a une_context's variable buffer and its parents or NULL.
 */
-une_association *une_variable_find_by_name_global(une_context *context, wchar_t *name)
+une_association *une_variable_find_by_name_global(une_context *context, une_symbol name)
 {
     return une_variable_find_or_create_(
         context, name, une_result_create(UNE_RK_none__), true, false);
@@ -276,7 +320,7 @@ une_association *une_variable_find_by_name_global(une_context *context, wchar_t
 Returns a pointer to a une_association in a une_context's variable buffer or creates and initializes
 it.
 */
-une_association *une_variable_find_by_name_or_create(une_context *context, wchar_t *name)
+une_association *une_variable_find_by_name_or_create(une_context *context, une_symbol name)
 {
     return une_variable_find_or_create_(
         context, name, une_result_create(UNE_RK_none__), false, true);
@@ -286,7 +330,7 @@ une_association *une_variable_find_by_name_or_create(une_context *context, wchar
 Returns a pointer to a une_association in a une_context's variable buffer and its parents or creates
 and initializes it.
 */
-une_association *une_variable_find_by_name_or_create_global(une_context *context, wchar_t *name)
+une_association *une_variable_find_by_name_or_create_global(une_context *context, une_symbol name)
 {
     return une_variable_find_or_create_(
         context, name, une_result_create(UNE_RK_none__), true, true);
@@ -298,5 +342,130 @@ parents or NULL.
 */
 une_association *une_variable_find_by_content_global(une_context *context, une_result content)
 {
-    return une_variable_find_or_create_(context, NULL, content, true, false);
+    return une_variable_find_or_create_(context, UNE_SYMBOL_NONE, content, true, false);
+}
+
+/*
+Find a variable through its NAME node, using the frame slot assigned by the resolver if possible.
+*/
+static une_association *une_variable_find_or_create_by_node_(une_context *starting_context,
+                                                             une_node *name,
+                                                             bool global,
+                                                             bool create_if_not_found)
+{
+    assert(name && name->kind == UNE_NK_NAME);
+    une_symbol symbol = (une_symbol)name->content.value._id;
+
+    /* Unresolved names are looked up by name. */
+    if (name->slot == UNE_NODE_NO_SLOT)
+        return une_variable_find_or_create_(
+            starting_context, symbol, une_result_create(UNE_RK_none__), global, create_if_not_found);
+
+    une_context *frame =
+        une_context_get_opaque_self_or_youngest_opaque_parent_or_null(starting_context);
+    assert(frame);
+    assert(name->slot < frame->slots.count);
+    une_association **slot = &frame->slots.buffer[name->slot];
+
+    /* The variable may have been created without going through this slot, so look it up by name
+    once. Associations never move, so the pointer remains valid for the lifetime of the frame. */
+    if (*slot == NULL)
+        *slot = une_variable_find_or_create_(frame,
+                                             symbol,
+                                             une_result_create(UNE_RK_none__),
+                                             false,
+                                             create_if_not_found && !global);
+
+    /* Not a local variable. */
+    if (*slot == NULL && global)
+        return une_variable_find_or_create_(
+            starting_context, symbol, une_result_create(UNE_RK_none__), true, create_if_not_found);
+
+    return *slot;
+}
+
+/*
+Returns a pointer to a une_association in a une_context's variable buffer (and its parents, if
+global) or NULL.
+*/
+une_association *une_variable_find_by_node(une_context *context, une_node *name, bool global)
+{
+    return une_variable_find_or_create_by_node_(context, name, global, false);
+}
+
+/*
+Returns a pointer to a une_association in a une_context's variable buffer (and its parents, if
+global) or creates and initializes it.
+*/
+une_association *une_variable_find_by_node_or_create(une_context *context,
+                                                     une_node *name,
+                                                     bool global)
+{
+    return une_variable_find_or_create_by_node_(context, name, global, true);
+}
+
+/*
+*** Helpers.
+*/
+
+/*
+Reserve the next une_context on the stack, allocating a new segment if needed.
+*/
+une_static__ une_context *une_context_push(une_contexts *contexts)
+{
+    /* Move on to the next segment. */
+    if (contexts->count == UNE_CONTEXTS_SEGMENT_SIZE(contexts->segment)) {
+        contexts->segment++;
+        contexts->count = 0;
+    }
+
+    /* Allocate the segment. */
+    if (contexts->segment == contexts->segments_count) {
+        assert(contexts->segments_count < sizeof(contexts->segments) / sizeof(*contexts->segments));
+        une_context *segment =
+            malloc(UNE_CONTEXTS_SEGMENT_SIZE(contexts->segment) * sizeof(*segment));
+        verify(segment);
+        contexts->segments[contexts->segments_count++] = segment;
+    }
+
+    return &contexts->segments[contexts->segment][contexts->count++];
+}
+
+/*
+Add a new variable to an opaque une_context. The first variables live inside the context itself,
+and associations never move once added.
+*/
+une_static__ une_association *une_context_add_variable(une_context *context, une_symbol name)
+{
+    assert(!context->is_transparent);
+    assert(context->variables.buffer);
+
+    /* Ensure sufficient space in une_association buffer. */
+    if (context->variables.count >= context->variables.size) {
+        size_t size = context->variables.size * 2;
+        if (context->variables.buffer == context->variables.inline_buffer) {
+            une_association **buffer = malloc(size * sizeof(*buffer));
+            verify(buffer);
+            memcpy(buffer, context->variables.buffer, context->variables.count * sizeof(*buffer));
+            context->variables.buffer = buffer;
+        } else {
+            context->variables.buffer =
+                realloc(context->variables.buffer, size * sizeof(*context->variables.buffer));
+            verify(context->variables.buffer);
+        }
+        context->variables.size = size;
+    }
+
+    /* Initialize une_association. */
+    une_association *variable;
+    if (context->variables.count < UNE_SIZE_VARIABLE_BUF)
+        variable = &context->variables.inline_associations[context->variables.count];
+    else
+        variable = une_association_create();
+    variable->name = name;
+    variable->content = une_result_create(UNE_RK_VOID); /* Don't use UNE_RK_none__ because this will
+                                                           be freed using une_result_free. */
+    context->variables.buffer[context->variables.count++] = variable;
+
+    return variable;
 }
@@ -8,6 +8,7 @@ context.h - Une
 /* Header-specific includes. */
 #include "../common.h"
 #include "association.h"
+#include "symbols.h"
 
 /*
 Holds information that changes depending on the execution context.
@@ -15,7 +16,7 @@ Holds information that changes depending on the execution context.
 typedef struct une_context_
 {
     struct une_context_ *parent;
-    wchar_t *label;
+    une_symbol label;
     size_t module_id;
     size_t callable_id;
     une_position exit_position;
@@ -24,32 +25,72 @@ typedef struct une_context_
     {
         size_t size;
         size_t count;
-        une_association **buffer;
+        une_association **buffer; /* inline_buffer until it is outgrown. */
+        une_association *inline_buffer[UNE_SIZE_VARIABLE_BUF];
+        une_association inline_associations[UNE_SIZE_VARIABLE_BUF]; /* The first variables. */
     } variables;
+    struct
+    {
+        size_t count;
+        une_association **buffer; /* Borrowed from variables, NULL until first accessed. */
+        une_association *inline_buffer[UNE_SIZE_VARIABLE_BUF];
+    } slots;
 } une_context;
 
+/*
+The stack of une_contexts. Contexts are created and freed in LIFO order and never move, so a call
+only bumps an index. Segment i holds UNE_SIZE_CONTEXTS << i contexts and is kept once allocated.
+*/
+typedef struct une_contexts_
+{
+    une_context *segments[sizeof(size_t) * 8];
+    size_t segments_count; /* Allocated segments. */
+    size_t segment; /* Segment holding the youngest context. */
+    size_t count; /* Contexts in use in segment. */
+} une_contexts;
+
+#define UNE_CONTEXTS_SEGMENT_SIZE(segment__) ((size_t)UNE_SIZE_CONTEXTS << (segment__))
+
 /*
 *** Interface.
 */
 
-une_context *une_context_create_transparent(void);
-une_context *une_context_create(void);
+une_contexts une_contexts_create(void);
+void une_contexts_free(une_contexts *contexts);
+
+une_context *une_context_create_transparent(une_contexts *contexts);
+une_context *une_context_create(une_contexts *contexts);
+void une_context_create_slots(une_context *context, size_t count);
 
 une_context *une_context_get_oldest_parent_or_self(une_context *context);
 une_context *une_context_get_opaque_self_or_oldest_opaque_parent_or_null(une_context *context);
 une_context *une_context_get_opaque_self_or_youngest_opaque_parent_or_null(une_context *context);
 
-void une_context_free_children(une_context *parent, une_context *youngest_child);
-void une_context_free(une_context *context);
-une_context *une_context_stump(une_context *youngest_child);
+void une_context_free_children(une_contexts *contexts,
+                               une_context *parent,
+                               une_context *youngest_child);
+void une_context_free(une_contexts *contexts, une_context *context);
+une_context *une_context_stump(une_contexts *contexts, une_context *youngest_child);
+une_context *une_context_merge_into_parent(une_contexts *contexts, une_context *context);
 
 size_t une_context_get_lineage(une_context *subject, une_context ***out);
 
-une_association *une_variable_create(une_context *context, wchar_t *name);
-une_association *une_variable_find_by_name(une_context *context, wchar_t *name);
-une_association *une_variable_find_by_name_global(une_context *context, wchar_t *name);
-une_association *une_variable_find_by_name_or_create(une_context *context, wchar_t *name);
-une_association *une_variable_find_by_name_or_create_global(une_context *context, wchar_t *name);
+une_association *une_variable_create(une_context *context, une_symbol name);
+une_association *une_variable_find_by_name(une_context *context, une_symbol name);
+une_association *une_variable_find_by_name_global(une_context *context, une_symbol name);
+une_association *une_variable_find_by_name_or_create(une_context *context, une_symbol name);
+une_association *une_variable_find_by_name_or_create_global(une_context *context, une_symbol name);
 une_association *une_variable_find_by_content_global(une_context *context, une_result content);
+une_association *une_variable_find_by_node(une_context *context, une_node *name, bool global);
+une_association *une_variable_find_by_node_or_create(une_context *context,
+                                                     une_node *name,
+                                                     bool global);
+
+/*
+*** Helpers.
+*/
+
+une_static__ une_context *une_context_push(une_contexts *contexts);
+une_static__ une_association *une_context_add_variable(une_context *context, une_symbol name);
 
 #endif /* !UNE_CONTEXT_H */
@@ -6,11 +6,16 @@ engine.c - Une
 #include "engine.h"
 
 /* Implementation-specific includes. */
+#include "../compiler.h"
 #include "../interpreter.h"
 #include "../lexer.h"
+#include "../natives.h"
+#include "../optimizer.h"
 #include "../parser.h"
+#include "../resolver.h"
 #include "../tools.h"
 #include "../traceback.h"
+#include "../vm.h"
 
 /*
 Globals.
@@ -24,7 +29,19 @@ Interface.
 
 une_engine une_engine_create_engine(void)
 {
-    return (une_engine){.error = une_error_create(), .is = une_interpreter_state_create(NULL)};
+    une_engine engine = {.error = une_error_create(),
+                         .is = une_interpreter_state_create(NULL),
+                         .symbols = une_symbols_create(),
+                         .shapes = une_shape_create(),
+                         .mode = UNE_EM_BYTECODE,
+                         .optimizes = true,
+                         .depth_limit = UNE_DEPTH_LIMIT,
+                         .stack_limit = une_stack_limit(),
+                         .shadowed_natives = 0,
+                         .quickened = 0,
+                         .deoptimized = 0};
+    une_native_intern_names(&engine.symbols);
+    return engine;
 }
 
 void une_engine_select_engine(une_engine *engine)
@@ -35,6 +52,8 @@ void une_engine_select_engine(une_engine *engine)
 void une_engine_free(void)
 {
     une_interpreter_state_free(&felix->is);
+    une_shape_free(felix->shapes);
+    une_symbols_free(&felix->symbols);
     felix = NULL;
 }
 
@@ -47,7 +66,7 @@ void une_engine_prepare_for_next_module(void)
 
 void une_engine_return_to_root_context(void)
 {
-    felix->is.context = une_context_stump(felix->is.context);
+    felix->is.context = une_context_stump(&felix->is.contexts, felix->is.context);
 }
 
 une_module *une_engine_new_module_from_file_or_wcs(char *path, wchar_t *wcs)
@@ -116,6 +135,11 @@ une_callable *une_engine_parse_module(une_module *module)
     une_node *ast = NULL;
 #if !defined(UNE_DEBUG) || !defined(UNE_DBG_NO_PARSE)
     ast = une_parse(&felix->error, &ps, module->tokens);
+    if (ast) {
+        if (felix->optimizes)
+            une_optimize(module, ast);
+        une_resolve(ast);
+    }
 #endif
 
 #if defined(UNE_DEBUG) && defined(UNE_DISPLAY_NODES)
@@ -133,19 +157,43 @@ une_callable *une_engine_parse_module(une_module *module)
         callable->module_id = module->id;
         callable->body = ast;
         callable->borrows_body_strings = true;
+        une_module_add_callable(module, callable->id);
     }
 
     return callable;
 }
 
-une_result une_engine_interpret_file_or_wcs_with_position(
-    char *path, wchar_t *wcs, une_position current_context_exit_position)
+/*
+Free a module and the callables registered while parsing it, unless a function result may still
+refer to one of them.
+*/
+static void une_engine_release_module(size_t module_id)
+{
+    une_module *module = une_modules_get_module_by_id(felix->is.modules, module_id);
+    assert(module);
+    for (size_t i = 0; i < module->callables_count; i++) {
+        une_callable *callable =
+            une_callables_get_callable_by_id(felix->is.callables, module->callable_ids[i]);
+        assert(callable);
+        if (callable->is_lent)
+            return;
+    }
+    for (size_t i = 0; i < module->callables_count; i++)
+        une_callables_remove_callable(&felix->is.callables, module->callable_ids[i]);
+    une_modules_remove_module(&felix->is.modules, module_id);
+}
+
+static une_result une_engine_interpret_module(char *path,
+                                              wchar_t *wcs,
+                                              une_position current_context_exit_position,
+                                              bool releases_module)
 {
     une_engine_prepare_for_next_module();
 
     une_module *module = une_engine_new_module_from_file_or_wcs(path, wcs);
+    size_t module_id = module->id;
 
-    une_context *parent = une_engine_push_context(true, current_context_exit_position, module->id);
+    une_context *parent = une_engine_push_context(true, current_context_exit_position, module_id);
 
     if (!module->tokens)
         return une_result_create(UNE_RK_ERROR);
@@ -164,11 +212,11 @@ une_result une_engine_interpret_file_or_wcs_with_position(
     wprintf(L"\n\n"); /* node_as_wcs does not add a newline. */
 #endif
 
-    une_engine_set_context_callable(callable, NULL);
+    une_engine_set_context_callable(callable, UNE_SYMBOL_NONE);
 
     une_result result = une_result_create(UNE_RK_VOID);
 #if !defined(UNE_DEBUG) || !defined(UNE_DBG_NO_INTERPRET)
-    result = une_interpret(callable->body);
+    result = une_engine_evaluate_callable(callable);
 #if defined(UNE_DEBUG) && defined(UNE_DBG_DISPLAY_RESULT)
     if (result.kind != UNE_RK_ERROR) {
         assert(UNE_RESULT_KIND_IS_TYPE(result.kind));
@@ -185,12 +233,25 @@ une_result une_engine_interpret_file_or_wcs_with_position(
 
     une_engine_pop_context(parent);
 
+    if (releases_module)
+        une_engine_release_module(module_id);
+
     return result;
 }
 
+/*
+Interpret a module from within another one (see eval() and script()). The module is freed again
+once it has run, unless it created functions.
+*/
+une_result une_engine_interpret_file_or_wcs_with_position(
+    char *path, wchar_t *wcs, une_position current_context_exit_position)
+{
+    return une_engine_interpret_module(path, wcs, current_context_exit_position, true);
+}
+
 une_result une_engine_interpret_file_or_wcs(char *path, wchar_t *wcs)
 {
-    return une_engine_interpret_file_or_wcs_with_position(path, wcs, (une_position){0});
+    return une_engine_interpret_module(path, wcs, (une_position){0}, false);
 }
 
 void une_engine_print_error(void)
@@ -217,7 +278,8 @@ une_context *une_engine_push_context(bool transparent,
 {
     une_context *parent = felix->is.context;
     parent->exit_position = position_in_current_module;
-    felix->is.context = transparent ? une_context_create_transparent() : une_context_create();
+    felix->is.context = transparent ? une_context_create_transparent(&felix->is.contexts)
+                                   : une_context_create(&felix->is.contexts);
     felix->is.context->parent = parent;
     felix->is.context->module_id = child_module_id;
     return parent;
@@ -225,16 +287,43 @@ une_context *une_engine_push_context(bool transparent,
 
 void une_engine_pop_context(une_context *context_before_push)
 {
-    une_context_free_children(context_before_push, felix->is.context);
+    une_context_free_children(&felix->is.contexts, context_before_push, felix->is.context);
     felix->is.context = context_before_push;
     context_before_push->exit_position = (une_position){0};
 }
 
-void une_engine_set_context_callable(une_callable *callable, wchar_t *optional_label)
+void une_engine_set_context_callable(une_callable *callable, une_symbol optional_label)
 {
     felix->is.context->callable_id = callable->id;
-    if (optional_label) {
-        felix->is.context->label = wcsdup(optional_label);
-        verify(felix->is.context->label);
+    felix->is.context->label = optional_label;
+}
+
+une_result une_engine_evaluate_callable(une_callable *callable)
+{
+    une_chunk *chunk = une_engine_compile_callable(callable);
+    if (!chunk)
+        return une_interpret(callable->body);
+
+    /* The callables buffer may grow during execution, so we only hold on to the chunk. */
+    return une_vm_execute(chunk);
+}
+
+une_chunk *une_engine_compile_callable(une_callable *callable)
+{
+    if (felix->mode == UNE_EM_TREE || callable->is_uncompilable)
+        return NULL;
+
+    if (!callable->chunk) {
+        callable->chunk = une_compile(callable->body);
+        if (!callable->chunk) {
+            callable->is_uncompilable = true;
+            return NULL;
+        }
+#if defined(UNE_DEBUG) && defined(UNE_DBG_DISPLAY_BYTECODE)
+        une_chunk_display(callable->chunk);
+        wprintf(L"\n");
+#endif
     }
+
+    return callable->chunk;
 }
@@ -11,6 +11,8 @@ engine.h - Une
 #include "error.h"
 #include "interpreter_state.h"
 #include "result.h"
+#include "shape.h"
+#include "symbols.h"
 
 /*
 Macros.
@@ -18,6 +20,17 @@ Macros.
 
 #define UNE_VERIFY_ENGINE assert(felix)
 
+/*
+Kind of une_engine evaluation.
+*/
+typedef enum une_engine_mode_
+{
+    UNE_EM_none__,
+    UNE_EM_BYTECODE,
+    UNE_EM_TREE,
+    UNE_EM_max__,
+} une_engine_mode;
+
 /*
 A Une engine.
 */
@@ -25,6 +38,15 @@ typedef struct une_engine_
 {
     une_error error;
     une_interpreter_state is;
+    une_symbols symbols;
+    une_shape *shapes; /* Root of the object shape tree. */
+    une_engine_mode mode;
+    bool optimizes; /* Run the optimizer over every parsed module. */
+    size_t depth_limit; /* Function calls that may be in progress at once. */
+    uintptr_t stack_limit; /* Lowest C stack address calls may begin at. */
+    uint64_t shadowed_natives; /* Bit per une_native whose name a parsed module binds. */
+    size_t quickened; /* Instructions rewritten into a variant specialized for their operands. */
+    size_t deoptimized; /* Specialized instructions reverted after seeing other operands. */
 } une_engine;
 
 /*
@@ -53,6 +75,8 @@ une_context *une_engine_push_context(bool transparent,
                                      une_position position_in_current_module,
                                      size_t child_module_id);
 void une_engine_pop_context(une_context *context_before_push);
-void une_engine_set_context_callable(une_callable *callable, wchar_t *optional_label);
+void une_engine_set_context_callable(une_callable *callable, une_symbol optional_label);
+une_result une_engine_evaluate_callable(une_callable *callable);
+une_chunk *une_engine_compile_callable(une_callable *callable);
 
 #endif /* !UNE_ENGINE_H */
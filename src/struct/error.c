@@ -27,6 +27,7 @@ const wchar_t *une_error_message_table[] = {
     L"Assertion not met.",
     L"Misplaced 'any' or 'all'.",
     L"System error.",
+    L"Recursion too deep.",
     L"Unknown error! (Internal Error)",
 };
 
@@ -30,6 +30,7 @@ typedef enum une_error_kind_
     UNE_EK_ASSERTION_NOT_MET,
     UNE_EK_MISPLACED_ANY_OR_ALL,
     UNE_EK_SYSTEM,
+    UNE_EK_RECURSION,
     UNE_EK_max__,
 } une_error_kind;
 
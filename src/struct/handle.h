@@ -0,0 +1,25 @@
+/*
+handle.h - Une
+*/
+
+#ifndef UNE_HANDLE_H
+#define UNE_HANDLE_H
+
+/* Header-specific includes. */
+#include "../common.h"
+
+/*
+A generational handle into a registry.
+
+The low half stores the slot index plus one, so no valid handle is 0. The high half stores the
+generation of the slot, which is bumped whenever the slot is reclaimed, so that handles to the
+previous occupant no longer match.
+*/
+#define UNE_HANDLE_INDEX_BITS (sizeof(size_t) * 4)
+#define UNE_HANDLE_INDEX_MASK (((size_t)1 << UNE_HANDLE_INDEX_BITS) - 1)
+#define UNE_HANDLE_CREATE(index__, generation__)                                                   \
+    (((size_t)(generation__) << UNE_HANDLE_INDEX_BITS) | ((size_t)(index__) + 1))
+#define UNE_HANDLE_INDEX(handle__) (((handle__)&UNE_HANDLE_INDEX_MASK) - 1)
+#define UNE_HANDLE_GENERATION(handle__) ((handle__) >> UNE_HANDLE_INDEX_BITS)
+
+#endif /* !UNE_HANDLE_H */
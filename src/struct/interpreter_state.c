@@ -14,14 +14,25 @@ Initialize a une_interpreter_state struct.
 */
 une_interpreter_state une_interpreter_state_create(char *creation_file)
 {
-    return (une_interpreter_state){.context = une_context_create(),
-                                   .callables = une_callables_create(),
-                                   .modules = une_modules_create(),
-                                   .should_return = false,
-                                   .should_exit = false,
-                                   .this_contestant = une_result_create(UNE_RK_VOID),
-                                   .this = une_result_create(UNE_RK_VOID),
-                                   .holding = (une_holding){.buffer = NULL, .size = 0, .count = 0}};
+    une_interpreter_state is = {.contexts = une_contexts_create(),
+                                .context = NULL,
+                                .callables = une_callables_create(),
+                                .modules = une_modules_create(),
+                                .depth = 0,
+                                .should_return = false,
+                                .should_exit = false,
+                                .this_contestant = une_result_create(UNE_RK_VOID),
+                                .this = une_result_create(UNE_RK_VOID),
+                                .holding = (une_holding){.segments_count = 0,
+                                                         .segment = 0,
+                                                         .offset = 0,
+                                                         .count = 0,
+                                                         .watermark = 0,
+                                                         .blocks = 0},
+                                .vm_stack = (une_vm_stack){
+                                    .segments_count = 0, .segment = 0, .offset = 0}};
+    is.context = une_context_create(&is.contexts);
+    return is;
 }
 
 /*
@@ -30,7 +41,8 @@ Free all members of a une_interpreter_state struct.
 void une_interpreter_state_free(une_interpreter_state *is)
 {
     /* Context. */
-    une_context_free_children(NULL, is->context);
+    une_context_free_children(&is->contexts, NULL, is->context);
+    une_contexts_free(&is->contexts);
 
     /* Callables. */
     une_callables_free(&is->callables);
@@ -40,72 +52,83 @@ void une_interpreter_state_free(une_interpreter_state *is)
 
     /* 'this' contestant. */
     une_result_free(is->this_contestant);
+
+    /* Holding. */
+    assert(is->holding.blocks == 0 && is->holding.count == 0);
+    for (size_t i = 0; i < is->holding.segments_count; i++)
+        free(is->holding.segments[i]);
+
+    /* VM stack. */
+    assert(is->vm_stack.segment == 0 && is->vm_stack.offset == 0);
+    for (size_t i = 0; i < is->vm_stack.segments_count; i++)
+        free(is->vm_stack.segments[i]);
 }
 
 /*
-Strip the current holding, replacing it with a new one.
+Begin a block, returning the watermark of the enclosing one.
 */
-une_holding une_interpreter_state_holding_strip(une_interpreter_state *is)
+size_t une_interpreter_state_holding_strip(une_interpreter_state *is)
 {
-    /* Preserve current holding. */
-    une_holding old = is->holding;
-
-    /* Replace holding with new one. */
-    une_result *buffer = malloc(UNE_SIZE_HOLDING * sizeof(*buffer));
-    verify(buffer);
-    for (size_t i = 0; i < UNE_SIZE_HOLDING; i++)
-        buffer[i] = une_result_create(UNE_RK_none__);
-    is->holding = (une_holding){.buffer = buffer, .size = UNE_SIZE_HOLDING, .count = 0};
-
-    /* Return old holding. */
-    return old;
+    size_t watermark = is->holding.watermark;
+    is->holding.watermark = is->holding.count;
+    is->holding.blocks++;
+    return watermark;
 }
 
 /*
-Drop all held results.
+End a block, dropping its held results and reinstating the watermark of the enclosing one.
 */
-void une_interpreter_state_holding_reinstate(une_interpreter_state *is, une_holding old)
+void une_interpreter_state_holding_reinstate(une_interpreter_state *is, size_t watermark)
 {
-    /* Empty current holding's buffer. */
+    assert(is->holding.blocks > 0);
     une_interpreter_state_holding_purge(is);
-    free(is->holding.buffer);
-
-    /* Reinstate old holding. */
-    is->holding = old;
+    is->holding.watermark = watermark;
+    is->holding.blocks--;
 }
 
 /*
-Hold a result in the interpreter state.
+Hold a result in the interpreter state until the innermost block drops it.
 */
 une_result *une_interpreter_state_holding_add(une_interpreter_state *is, une_result result)
 {
-    /* Ensure buffer is big enough. */
-    if (is->holding.count >= is->holding.size) {
-        is->holding.size *= 2;
-        is->holding.buffer =
-            realloc(is->holding.buffer, is->holding.size * sizeof(*is->holding.buffer));
-        verify(is->holding.buffer);
-        for (size_t i = is->holding.count; i < is->holding.size; i++)
-            is->holding.buffer[i] = une_result_create(UNE_RK_none__);
+    une_holding *holding = &is->holding;
+    assert(holding->blocks > 0);
+
+    /* Move on to the next segment. */
+    if (holding->offset == UNE_HOLDING_SEGMENT_SIZE(holding->segment)) {
+        holding->segment++;
+        holding->offset = 0;
     }
 
-    /* Hold result. */
-    is->holding.buffer[is->holding.count++] = result;
+    /* Allocate the segment. */
+    if (holding->segment == holding->segments_count) {
+        assert(holding->segments_count < sizeof(holding->segments) / sizeof(*holding->segments));
+        une_result *segment = malloc(UNE_HOLDING_SEGMENT_SIZE(holding->segment) * sizeof(*segment));
+        verify(segment);
+        holding->segments[holding->segments_count++] = segment;
+    }
 
-    /* Return pointer to held result. */
-    return is->holding.buffer + is->holding.count - 1;
+    /* Hold result. */
+    une_result *held = &holding->segments[holding->segment][holding->offset++];
+    *held = result;
+    holding->count++;
+    return held;
 }
 
 /*
-Free the contents of a holding, without freeing the holding itself.
+Drop the results held by the innermost block.
 */
 void une_interpreter_state_holding_purge(une_interpreter_state *is)
 {
-    for (size_t i = 0; i < is->holding.count; i++) {
-        une_result_free(is->holding.buffer[i]);
-        is->holding.buffer[i] = une_result_create(UNE_RK_none__);
+    une_holding *holding = &is->holding;
+    while (holding->count > holding->watermark) {
+        if (holding->offset == 0) {
+            holding->segment--;
+            holding->offset = UNE_HOLDING_SEGMENT_SIZE(holding->segment);
+        }
+        une_result_free(holding->segments[holding->segment][--holding->offset]);
+        holding->count--;
     }
-    is->holding.count = 0;
 }
 
 /*
@@ -113,9 +136,9 @@ Check if a result matches the interpreter state's 'this'.
 */
 bool une_result_is_reference_to_foreign_object(une_interpreter_state *is, une_result subject)
 {
-    if (subject.kind != UNE_RK_REFERENCE || subject.reference.kind != UNE_FK_SINGLE)
+    if (subject.kind != UNE_RK_REFERENCE || subject.reference_kind != UNE_FK_SINGLE)
         return false;
-    une_result *referenced = (une_result *)subject.reference.root;
+    une_result *referenced = (une_result *)subject.reference_root;
     assert(referenced);
     if (referenced->kind != UNE_RK_OBJECT)
         return false;
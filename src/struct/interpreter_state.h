@@ -12,28 +12,56 @@ interpreter_state.h - Une
 #include "module.h"
 
 /*
-A temporary result buffer.
+A region of temporary results, used as a stack. Each block pushes a watermark when it begins and
+drops the results above it when it ends; the interpreter also drops them after every statement.
+Segment i holds UNE_SIZE_HOLDING << i results and is kept once allocated, so held results never
+move.
 */
 typedef struct une_holding_
 {
-    une_result *buffer;
-    size_t size;
-    size_t count;
+    une_result *segments[sizeof(size_t) * 8];
+    size_t segments_count; /* Allocated segments. */
+    size_t segment; /* Segment holding the youngest result. */
+    size_t offset; /* Results in use in segment. */
+    size_t count; /* Results in use. */
+    size_t watermark; /* First result held by the innermost block. */
+    size_t blocks; /* Open blocks. */
 } une_holding;
 
+#define UNE_HOLDING_SEGMENT_SIZE(segment__) ((size_t)UNE_SIZE_HOLDING << (segment__))
+
+/*
+The memory une_vm_execute carves its frames out of. Each frame takes one run of cells for itself,
+its registers, the watermarks of its open blocks and its active covers, and frames are pushed and
+popped in LIFO order, so a call only bumps an offset. Segment i holds UNE_SIZE_VM_STACK << i cells
+and is kept once allocated, so growing the stack never moves a live frame.
+*/
+typedef struct une_vm_stack_
+{
+    une_result *segments[sizeof(size_t) * 8];
+    size_t segments_count; /* Allocated segments. */
+    size_t segment; /* Segment holding the youngest frame. */
+    size_t offset; /* Cells in use in segment. */
+} une_vm_stack;
+
+#define UNE_VM_STACK_SEGMENT_SIZE(segment__) ((size_t)UNE_SIZE_VM_STACK << (segment__))
+
 /*
 Holds the state of the interpreter.
 */
 typedef struct une_interpreter_state_
 {
+    une_contexts contexts;
     une_context *context;
     une_callables callables;
     une_modules modules;
+    size_t depth; /* Function calls in progress. */
     bool should_return;
     bool should_exit;
     une_result this_contestant;
     une_result this;
     une_holding holding;
+    une_vm_stack vm_stack;
 } une_interpreter_state;
 
 /*
@@ -42,8 +70,8 @@ typedef struct une_interpreter_state_
 
 une_interpreter_state une_interpreter_state_create(char *creation_file);
 void une_interpreter_state_free(une_interpreter_state *is);
-une_holding une_interpreter_state_holding_strip(une_interpreter_state *is);
-void une_interpreter_state_holding_reinstate(une_interpreter_state *is, une_holding old);
+size_t une_interpreter_state_holding_strip(une_interpreter_state *is);
+void une_interpreter_state_holding_reinstate(une_interpreter_state *is, size_t watermark);
 une_result *une_interpreter_state_holding_add(une_interpreter_state *is, une_result result);
 void une_interpreter_state_holding_purge(une_interpreter_state *is);
 bool une_result_is_reference_to_foreign_object(une_interpreter_state *is, une_result subject);
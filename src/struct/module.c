@@ -24,6 +24,14 @@ static void une_module_clear(une_module *module)
     if (module->tokens)
         une_tokens_free(module->tokens);
 
+    for (size_t i = 0; i < module->strings_count; i++)
+        free(module->strings[i]);
+    if (module->strings)
+        free(module->strings);
+
+    if (module->callable_ids)
+        free(module->callable_ids);
+
     module->id = 0;
 }
 
@@ -33,10 +41,17 @@ une_modules une_modules_create(void)
 
     une_module *buffer = malloc(size * sizeof(*buffer));
     verify(buffer);
-    for (size_t i = 0; i < size; i++)
-        buffer[i] = (une_module){.id = 0};
-
-    return (une_modules){.size = size, .buffer = buffer, .next_unused_id = 1};
+    size_t *generations = malloc(size * sizeof(*generations));
+    verify(generations);
+    size_t *free_indices = malloc(size * sizeof(*free_indices));
+    verify(free_indices);
+
+    return (une_modules){.size = size,
+                         .buffer = buffer,
+                         .generations = generations,
+                         .free_indices = free_indices,
+                         .free_count = 0,
+                         .count = 0};
 }
 
 une_module *une_modules_add_module(une_modules *modules)
@@ -45,19 +60,26 @@ une_module *une_modules_add_module(une_modules *modules)
     assert(modules->buffer);
 
     size_t index;
-    for (index = 0; index < modules->size; index++) {
-        if (modules->buffer[index].id == 0)
-            break;
-    }
-    if (index == modules->size) {
-        modules->size *= 2;
-        modules->buffer = realloc(modules->buffer, modules->size * sizeof(*modules->buffer));
-        verify(modules->buffer);
-        for (size_t i = index; i < modules->size; i++)
-            modules->buffer[i] = (une_module){.id = 0};
+    if (modules->free_count > 0) {
+        index = modules->free_indices[--modules->free_count];
+    } else {
+        if (modules->count == modules->size) {
+            modules->size *= 2;
+            modules->buffer = realloc(modules->buffer, modules->size * sizeof(*modules->buffer));
+            verify(modules->buffer);
+            modules->generations =
+                realloc(modules->generations, modules->size * sizeof(*modules->generations));
+            verify(modules->generations);
+            modules->free_indices =
+                realloc(modules->free_indices, modules->size * sizeof(*modules->free_indices));
+            verify(modules->free_indices);
+        }
+        index = modules->count++;
+        modules->generations[index] = 0;
     }
 
-    modules->buffer[index] = (une_module){.id = modules->next_unused_id++};
+    modules->buffer[index] =
+        (une_module){.id = UNE_HANDLE_CREATE(index, modules->generations[index])};
 
     return modules->buffer + index;
 }
@@ -66,12 +88,25 @@ une_module *une_modules_get_module_by_id(une_modules modules, size_t id)
 {
     assert(modules.buffer);
 
-    for (size_t i = 0; i < modules.size; i++) {
-        if (modules.buffer[i].id == id)
-            return modules.buffer + i;
-    }
+    /* An id of 0 wraps around to an out-of-range index. */
+    size_t index = UNE_HANDLE_INDEX(id);
+    if (index >= modules.count || modules.buffer[index].id != id)
+        return NULL;
+
+    return modules.buffer + index;
+}
+
+void une_modules_remove_module(une_modules *modules, size_t id)
+{
+    assert(modules);
 
-    return NULL;
+    une_module *module = une_modules_get_module_by_id(*modules, id);
+    assert(module);
+
+    size_t index = (size_t)(module - modules->buffer);
+    une_module_clear(module);
+    modules->generations[index] = (modules->generations[index] + 1) & UNE_HANDLE_INDEX_MASK;
+    modules->free_indices[modules->free_count++] = index;
 }
 
 void une_modules_free(une_modules *modules)
@@ -79,11 +114,42 @@ void une_modules_free(une_modules *modules)
     assert(modules);
 
     assert(modules->buffer);
-    for (size_t i = 0; i < modules->size; i++)
+    for (size_t i = 0; i < modules->count; i++)
         une_module_clear(modules->buffer + i);
     free(modules->buffer);
+    free(modules->generations);
+    free(modules->free_indices);
 
     modules->buffer = NULL;
     modules->size = 0;
-    modules->next_unused_id = 0;
+    modules->count = 0;
+    modules->free_count = 0;
+}
+
+void une_module_add_string(une_module *module, wchar_t *string)
+{
+    assert(module);
+    assert(string);
+
+    size_t size = (module->strings_count + 1) * sizeof(*module->strings);
+    if (module->strings)
+        module->strings = realloc(module->strings, size);
+    else
+        module->strings = malloc(size);
+    verify(module->strings);
+    module->strings[module->strings_count++] = string;
+}
+
+void une_module_add_callable(une_module *module, size_t callable_id)
+{
+    assert(module);
+    assert(callable_id);
+
+    size_t size = (module->callables_count + 1) * sizeof(*module->callable_ids);
+    if (module->callable_ids)
+        module->callable_ids = realloc(module->callable_ids, size);
+    else
+        module->callable_ids = malloc(size);
+    verify(module->callable_ids);
+    module->callable_ids[module->callables_count++] = callable_id;
 }
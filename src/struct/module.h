@@ -7,6 +7,7 @@ module.h - Une
 
 /* Header-specific includes. */
 #include "../common.h"
+#include "handle.h"
 #include "node.h"
 #include "token.h"
 
@@ -15,21 +16,28 @@ A module.
 */
 typedef struct une_module_
 {
-    size_t id;
+    size_t id; /* A generational handle, 0 marks an unused slot. */
     bool originates_from_file;
     char *path;
     wchar_t *source;
     une_token *tokens;
+    wchar_t **strings; /* Strings created by the optimizer, freed alongside the tokens. */
+    size_t strings_count;
+    size_t *callable_ids; /* Callables registered while parsing the module. */
+    size_t callables_count;
 } une_module;
 
 /*
-A module buffer.
+A registry of modules, indexed by their handles.
 */
 typedef struct une_modules_
 {
     size_t size;
     une_module *buffer;
-    size_t next_unused_id;
+    size_t *generations; /* Current generation of each slot. */
+    size_t *free_indices; /* Reclaimed slots, reused before new ones. */
+    size_t free_count;
+    size_t count; /* Slots handed out so far. */
 } une_modules;
 
 /*
@@ -39,6 +47,10 @@ typedef struct une_modules_
 une_modules une_modules_create(void);
 une_module *une_modules_add_module(une_modules *modules);
 une_module *une_modules_get_module_by_id(une_modules modules, size_t id);
+void une_modules_remove_module(une_modules *modules, size_t id);
 void une_modules_free(une_modules *modules);
 
+void une_module_add_string(une_module *module, wchar_t *string);
+void une_module_add_callable(une_module *module, size_t callable_id);
+
 #endif /* !UNE_MODULE_H */
@@ -7,6 +7,7 @@ node.c - Une
 
 /* Implementation-specific includes. */
 #include "../natives.h"
+#include "engine.h"
 #include "../tools.h"
 
 /*
@@ -56,6 +57,7 @@ une_node *une_node_create(une_node_kind kind)
     /* Initialize new une_node. */
     *node = (une_node){.kind = kind,
                        .pos = (une_position){0},
+                       .slot = UNE_NODE_NO_SLOT,
                        .content.branch.a = NULL,
                        .content.branch.b = NULL,
                        .content.branch.c = NULL,
@@ -81,6 +83,7 @@ une_node *une_node_copy(une_node *src)
 
     /* Populate destination une_node. */
     dest->pos = src->pos;
+    dest->slot = src->slot;
     switch (src->kind) {
 
     /* Stack data. */
@@ -93,12 +96,12 @@ une_node *une_node_copy(une_node *src)
     case UNE_NK_ID:
     case UNE_NK_NATIVE:
     case UNE_NK_THIS:
+    case UNE_NK_NAME:
         dest->content.value = src->content.value;
         break;
 
     /* Heap data. */
     case UNE_NK_STR:
-    case UNE_NK_NAME:
         dest->content.value._wcs = wcsdup(src->content.value._wcs);
         verify(dest->content.value._wcs);
         break;
@@ -153,11 +156,11 @@ void une_node_free(une_node *node, bool free_wcs)
     case UNE_NK_SIZE:
     case UNE_NK_ID:
     case UNE_NK_THIS:
+    case UNE_NK_NAME:
         break;
 
     /* Heap data. */
     case UNE_NK_STR:
-    case UNE_NK_NAME:
         /* DOC: Memory Management
         We don't normally free the WCS pointers because they are pointing at data stored in the
         tokens, which may still be needed after the parse. This memory is freed alongside the
@@ -350,7 +353,7 @@ wchar_t *une_node_to_wcs(une_node *node)
                                       L"s" UNE_COLOR_RESET L":" UNE_COLOR_NODE_DATUM_VALUE L"%l"
                                                                                            L"s" UNE_COLOR_RESET,
             une_node_kind_to_wcs(node->kind),
-            node->content.value._wcs);
+            une_symbols_name(&felix->symbols, (une_symbol)node->content.value._id));
         break;
 
     /* Native functions. */
@@ -94,6 +94,7 @@ typedef struct une_node_
 {
     une_node_kind kind;
     une_position pos;
+    size_t slot; /* Frame slot assigned to a UNE_NK_NAME by the resolver. */
     union content_
     {
         une_value value;
@@ -111,6 +112,11 @@ typedef struct une_node_
 *** Interface.
 */
 
+/*
+Slot of a UNE_NK_NAME that was not resolved to a frame slot.
+*/
+#define UNE_NODE_NO_SLOT SIZE_MAX
+
 /*
 Condition to check whether une_node_kind is valid.
 */
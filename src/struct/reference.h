@@ -17,11 +17,14 @@ typedef enum une_reference_kind_
     UNE_FK_SINGLE,
     UNE_FK_LISTVIEW,
     UNE_FK_STRVIEW,
+    UNE_FK_NARROW_STRVIEW,
+    UNE_FK_INT_ITEM,
+    UNE_FK_FLT_ITEM,
     UNE_FK_max__,
 } une_reference_kind;
 
 /*
-Refers to data.
+Refers to data. une_result stores references packed, see UNE_RESULT_REFERENCE.
 */
 typedef struct une_reference_
 {
@@ -0,0 +1,53 @@
+/*
+resolver_state.c - Une
+*/
+
+/* Header-specific includes. */
+#include "resolver_state.h"
+
+/* Implementation-specific includes. */
+#include "../tools.h"
+
+/*
+Initialize a une_resolver_state struct.
+*/
+une_resolver_state une_resolver_state_create(void)
+{
+    une_resolver_state rs = {.names = NULL, .size = UNE_SIZE_SLOTS, .count = 0};
+    rs.names = malloc(rs.size * sizeof(*rs.names));
+    verify(rs.names);
+    return rs;
+}
+
+/*
+Free all members of a une_resolver_state struct.
+*/
+void une_resolver_state_free(une_resolver_state *rs)
+{
+    free(rs->names);
+}
+
+/*
+Assign the next free slot to a name.
+*/
+size_t une_resolver_state_add(une_resolver_state *rs, une_symbol name)
+{
+    if (rs->count >= rs->size) {
+        rs->size *= 2;
+        rs->names = realloc(rs->names, rs->size * sizeof(*rs->names));
+        verify(rs->names);
+    }
+    rs->names[rs->count] = name;
+    return rs->count++;
+}
+
+/*
+Return the slot of a name, assigning the next free slot if the name is new.
+*/
+size_t une_resolver_state_slot(une_resolver_state *rs, une_symbol name)
+{
+    for (size_t i = 0; i < rs->count; i++)
+        if (rs->names[i] == name)
+            return i;
+    return une_resolver_state_add(rs, name);
+}
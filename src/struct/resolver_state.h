@@ -0,0 +1,31 @@
+/*
+resolver_state.h - Une
+*/
+
+#ifndef UNE_RESOLVER_STATE_H
+#define UNE_RESOLVER_STATE_H
+
+/* Header-specific includes. */
+#include "../common.h"
+#include "symbols.h"
+
+/*
+Holds the state of the resolver, i.e. the slots of the function body being resolved.
+*/
+typedef struct une_resolver_state_
+{
+    une_symbol *names;
+    size_t size;
+    size_t count;
+} une_resolver_state;
+
+/*
+*** Interface.
+*/
+
+une_resolver_state une_resolver_state_create(void);
+void une_resolver_state_free(une_resolver_state *rs);
+size_t une_resolver_state_add(une_resolver_state *rs, une_symbol name);
+size_t une_resolver_state_slot(une_resolver_state *rs, une_symbol name);
+
+#endif /* !UNE_RESOLVER_STATE_H */
@@ -20,6 +20,9 @@ const wchar_t *une_result_table[] = {
     L"FLT",
     L"STR",
     L"LIST",
+    L"ARRAY",
+    L"MAP",
+    L"RANGE",
     L"OBJECT",
     L"FUNCTION",
     L"NATIVE",
@@ -41,7 +44,8 @@ une_result une_result_create(une_result_kind kind)
 }
 
 /*
-Return a duplicate une_result.
+Return a duplicate une_result. Strings, lists, arrays, maps, ranges, and objects share their storage
+with the original.
 */
 une_result une_result_copy(une_result original)
 {
@@ -65,13 +69,55 @@ void une_result_free(une_result result)
             UNE_TYPE_FOR_RESULT(result).free_members(result);
 }
 
+/*
+Give a une_result sole ownership of its storage before it is written to.
+*/
+void une_result_unshare(une_result *result)
+{
+    assert(result);
+    assert(UNE_RESULT_KIND_IS_VALID(result->kind));
+    if (UNE_RESULT_KIND_IS_TYPE(result->kind))
+        if (UNE_TYPE_FOR_RESULT(*result).unshare != NULL)
+            UNE_TYPE_FOR_RESULT(*result).unshare(result);
+}
+
+/*
+Check if slot is container or lies within the storage of container.
+*/
+bool une_result_holds(une_result *container, une_result *slot)
+{
+    assert(container);
+    if (container == slot)
+        return true;
+    if (container->kind == UNE_RK_LIST) {
+        UNE_UNPACK_RESULT_LIST((*container), list, list_size);
+        UNE_FOR_RESULT_LIST_ITEM(i, list_size)
+        if (une_result_holds(list + i, slot))
+            return true;
+    } else if (container->kind == UNE_RK_MAP) {
+        une_map *map = UNE_MAP(*container);
+        for (size_t i = 0; i < map->count; i++)
+            if (une_result_holds(&map->entries[i].value, slot))
+                return true;
+    } else if (container->kind == UNE_RK_OBJECT) {
+        une_object *object = (une_object *)container->value._vp;
+        UNE_FOR_OBJECT_MEMBER(i, object)
+        if (une_result_holds(object->members + i, slot))
+            return true;
+    }
+    return false;
+}
+
 /*
 Return a list of uninitialized une_results.
 */
 une_result *une_result_list_create(size_t items)
 {
-    une_result *list = malloc((items + 1) * sizeof(*list));
-    verify(list);
+    une_shared *shared = malloc(sizeof(*shared) + (items + 1) * sizeof(une_result));
+    verify(shared);
+    shared->references = 1;
+    shared->capacity = items;
+    une_result *list = (une_result *)(void *)(shared + 1);
     list[0] = (une_result){.kind = UNE_RK_SIZE, .value._int = (une_int)items};
     return list;
 }
@@ -184,33 +230,37 @@ Dereference reference results.
 une_result une_result_dereference(une_result result)
 {
     if (result.kind == UNE_RK_OBJECT) {
-        ((une_object *)result.value._vp)->owner = felix->is.context;
+        une_type_object_claim(&result);
         return result;
     }
     if (result.kind != UNE_RK_REFERENCE)
         return result;
-    assert(UNE_REFERENCE_KIND_IS_VALID(result.reference.kind));
-    switch (result.reference.kind) {
-    case UNE_FK_STRVIEW: {
-        wchar_t *strview = (wchar_t *)result.reference.root;
-        wchar_t *string = malloc((result.reference.width + 1) * sizeof(*string));
-        verify(string);
-        wcsncpy(string, strview, result.reference.width);
-        string[result.reference.width] = L'\0';
-        return (une_result){.kind = UNE_RK_STR, .value._wcs = string};
+    assert(UNE_REFERENCE_KIND_IS_VALID(result.reference_kind));
+    switch (result.reference_kind) {
+    case UNE_FK_STRVIEW:
+        return une_type_str_from_wcs_with_length((wchar_t *)result.reference_root,
+                                                 result.reference_width);
+    case UNE_FK_NARROW_STRVIEW: {
+        une_str *string = une_type_str_create(result.reference_width, true);
+        une_type_str_write(string, 0, result.reference_root, true, result.reference_width);
+        return (une_result){.kind = UNE_RK_STR, .value._vp = string};
     }
+    case UNE_FK_INT_ITEM:
+        return (une_result){.kind = UNE_RK_INT, .value._int = *(une_int *)result.reference_root};
+    case UNE_FK_FLT_ITEM:
+        return (une_result){.kind = UNE_RK_FLT, .value._flt = *(une_flt *)result.reference_root};
     case UNE_FK_LISTVIEW: {
-        une_result *listview = (une_result *)result.reference.root;
-        une_result *list = une_result_list_create(result.reference.width);
-        UNE_FOR_RESULT_LIST_ITEM(i, result.reference.width)
+        une_result *listview = (une_result *)result.reference_root;
+        une_result *list = une_result_list_create(result.reference_width);
+        UNE_FOR_RESULT_LIST_ITEM(i, result.reference_width)
         list[i] = une_result_copy(listview[i - 1]) /* Listviews don't know their size. */;
         return (une_result){.kind = UNE_RK_LIST, .value._vp = (void *)list};
     }
     default:
         break;
     }
-    assert(result.reference.kind == UNE_FK_SINGLE);
-    une_result *referenced = (une_result *)result.reference.root;
+    assert(result.reference_kind == UNE_FK_SINGLE);
+    une_result *referenced = (une_result *)result.reference_root;
     assert(referenced);
     assert(UNE_RESULT_KIND_IS_TYPE(referenced->kind));
     return une_result_copy(*referenced);
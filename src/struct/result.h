@@ -22,6 +22,9 @@ typedef enum une_result_kind_
     UNE_RK_FLT,
     UNE_RK_STR,
     UNE_RK_LIST,
+    UNE_RK_ARRAY,
+    UNE_RK_MAP,
+    UNE_RK_RANGE,
     UNE_RK_OBJECT,
     UNE_RK_FUNCTION,
     UNE_RK_NATIVE,
@@ -35,17 +38,170 @@ typedef enum une_result_kind_
 
 /*
 Holds data resulting from interpretation.
+Results are passed by value and fill every list slot, so they are kept to 16 bytes: a reference
+packs its kind and width next to the result kind and keeps its root in place of the value.
 */
 typedef struct une_result_
 {
-    une_result_kind kind;
+    uint8_t kind; /* une_result_kind. */
+    uint8_t reference_kind; /* une_reference_kind, if kind is UNE_RK_REFERENCE. */
+    uint32_t reference_width; /* Width of a view. */
     union
     {
         une_value value;
-        une_reference reference;
+        void *reference_root;
     };
 } une_result;
 
+_Static_assert(UNE_RK_max__ <= UINT8_MAX, "une_result_kind must fit une_result.kind.");
+
+/*
+Widest view a une_result can refer to. Wider views are copied, and cannot be assigned to.
+*/
+#if !defined(UNE_DEBUG) || !defined(UNE_DBG_SIZES)
+#define UNE_REFERENCE_WIDTH_MAX UINT32_MAX
+#else
+#define UNE_REFERENCE_WIDTH_MAX 64
+#endif
+
+/*
+Unpack a UNE_RK_REFERENCE une_result into a une_reference.
+*/
+#define UNE_RESULT_REFERENCE(result)                                                               \
+    ((une_reference){.kind = (une_reference_kind)(result).reference_kind,                          \
+                     .root = (result).reference_root,                                              \
+                     .width = (size_t)(result).reference_width})
+
+/*
+Header in front of the storage of a list, which results share until one of them writes to it.
+*/
+typedef union une_shared_
+{
+    struct
+    {
+        size_t references;
+        size_t capacity; /* Items that fit, not counting the size in front of them. */
+    };
+    max_align_t alignment__;
+} une_shared;
+
+/*
+Get the header of shared storage.
+*/
+#define UNE_SHARED(storage) ((une_shared *)(void *)(storage)-1)
+
+/*
+A string. Strings whose characters all fit in a single byte (Latin-1) are stored narrow, with one
+unsigned char per character, and all others with one wchar_t per character. Characters are not
+terminated.
+
+A string either has its own storage, which directly follows it, or shares the storage of an owner
+(see une_type_str_add). Strings that share storage never write to it, except to append characters
+beyond all those in use.
+*/
+typedef struct une_str_
+{
+    size_t references;
+    size_t length;
+    size_t hash; /* UNE_STR_NO_HASH until computed. */
+    bool is_narrow;
+    bool grows; /* Whether it was made by appending, and is likely to be appended to again. */
+    void *characters;
+    struct une_str_ *owner; /* String whose storage it shares, or NULL. */
+    size_t capacity; /* Characters that fit in its own storage. */
+    size_t used; /* Characters of its own storage in use, by it or by strings that share it. */
+} une_str;
+
+/*
+A packed array of INTs or FLTs. Its items are stored contiguously right after it, without a
+une_result around each of them.
+*/
+typedef struct une_array_
+{
+    size_t references;
+    size_t length;
+    bool is_flt;
+} une_array;
+
+/*
+Get the array of a UNE_RK_ARRAY une_result.
+*/
+#define UNE_ARRAY(result) ((une_array *)(result).value._vp)
+
+/*
+Get the items of an array.
+*/
+#define UNE_ARRAY_INTS(array) ((une_int *)(void *)((array) + 1))
+#define UNE_ARRAY_FLTS(array) ((une_flt *)(void *)((array) + 1))
+
+/*
+A key of a map, the value it maps to and the hash of the key.
+*/
+typedef struct une_map_entry_
+{
+    size_t hash;
+    une_result key;
+    une_result value;
+} une_map_entry;
+
+/*
+A hash map with INT, FLT and STR keys. Its entries are stored contiguously in the order they were
+added, and found through a table of positions in that order using open addressing.
+*/
+typedef struct une_map_
+{
+    size_t references;
+    size_t count;
+    size_t capacity; /* Entries that fit without growing. */
+    une_map_entry *entries;
+    size_t *slots; /* Position of an entry plus one, or 0 if empty. There are 2 * capacity. */
+} une_map;
+
+/*
+Get the map of a UNE_RK_MAP une_result.
+*/
+#define UNE_MAP(result) ((une_map *)(result).value._vp)
+
+/*
+A range of INTs from start up to (but excluding) stop, spaced step apart. Its INTs are produced when
+they are needed instead of being stored.
+*/
+typedef struct une_int_range_
+{
+    size_t references;
+    une_int start;
+    une_int stop;
+    une_int step; /* Never 0. */
+    size_t length;
+} une_int_range;
+
+/*
+Get the range of a UNE_RK_RANGE une_result.
+*/
+#define UNE_INT_RANGE(result) ((une_int_range *)(result).value._vp)
+
+/*
+Hash of a string whose hash has not been computed yet.
+*/
+#define UNE_STR_NO_HASH 0
+
+/*
+Position returned by une_type_str_find if the string was not found.
+*/
+#define UNE_STR_NOT_FOUND SIZE_MAX
+
+/*
+Get the string of a UNE_RK_STR une_result.
+*/
+#define UNE_STR(result) ((une_str *)(result).value._vp)
+
+/*
+Get a character of a string.
+*/
+#define UNE_STR_CHARACTER(str, index)                                                              \
+    ((str)->is_narrow ? (wchar_t)((unsigned char *)(str)->characters)[index]                       \
+                      : ((wchar_t *)(str)->characters)[index])
+
 /*
 *** Interface.
 */
@@ -59,11 +215,11 @@ Unpack a une_result list into its name and size.
     size_t listsize = (size_t)listname[0].value._int
 
 /*
-Unpack a une_result string into its string pointer and size.
+Unpack a une_result string into its une_str and size.
 */
 #define UNE_UNPACK_RESULT_STR(strresult, strname, strsize)                                         \
-    wchar_t *strname = strresult.value._wcs;                                                       \
-    size_t strsize = wcslen(strname)
+    une_str *strname = UNE_STR(strresult);                                                         \
+    size_t strsize = strname->length
 
 /*
 Iterate over every item in a une_result list.
@@ -89,6 +245,8 @@ Condition to check whether une_result_kind is data kind.
 une_result une_result_create(une_result_kind kind);
 une_result une_result_copy(une_result original);
 void une_result_free(une_result result);
+void une_result_unshare(une_result *result);
+bool une_result_holds(une_result *container, une_result *slot);
 
 une_result *une_result_list_create(size_t size);
 
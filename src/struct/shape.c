@@ -0,0 +1,83 @@
+/*
+shape.c - Une
+*/
+
+/* Header-specific includes. */
+#include "shape.h"
+
+/* Implementation-specific includes. */
+#include "../tools.h"
+
+/*
+Allocate, initialize, and return a pointer to an empty une_shape, i.e. the root of a shape tree.
+*/
+une_shape *une_shape_create(void)
+{
+    une_shape *shape = malloc(sizeof(*shape));
+    verify(shape);
+    *shape = (une_shape){.parent = NULL, .names = NULL, .count = 0};
+    shape->transitions.size = UNE_SIZE_SHAPE_TRANSITIONS;
+    shape->transitions.count = 0;
+    shape->transitions.buffer =
+        malloc(shape->transitions.size * sizeof(*shape->transitions.buffer));
+    verify(shape->transitions.buffer);
+    return shape;
+}
+
+/*
+Free a une_shape and all shapes reachable from it.
+*/
+void une_shape_free(une_shape *shape)
+{
+    for (size_t i = 0; i < shape->transitions.count; i++)
+        une_shape_free(shape->transitions.buffer[i]);
+    free(shape->transitions.buffer);
+    if (shape->names)
+        free(shape->names);
+    free(shape);
+}
+
+/*
+Return the shape that results from adding a member to a shape, creating it if necessary.
+*/
+une_shape *une_shape_add_member(une_shape *shape, une_symbol name)
+{
+    assert(une_shape_find_member(shape, name) == UNE_SHAPE_NO_MEMBER);
+
+    /* Follow existing transition. */
+    for (size_t i = 0; i < shape->transitions.count; i++)
+        if (shape->transitions.buffer[i]->names[shape->count] == name)
+            return shape->transitions.buffer[i];
+
+    /* Create child. */
+    une_shape *child = une_shape_create();
+    child->parent = shape;
+    child->count = shape->count + 1;
+    child->names = malloc(child->count * sizeof(*child->names));
+    verify(child->names);
+    if (shape->count > 0)
+        memcpy(child->names, shape->names, shape->count * sizeof(*shape->names));
+    child->names[shape->count] = name;
+
+    /* Register transition. */
+    if (shape->transitions.count >= shape->transitions.size) {
+        shape->transitions.size *= 2;
+        shape->transitions.buffer = realloc(
+            shape->transitions.buffer, shape->transitions.size * sizeof(*shape->transitions.buffer));
+        verify(shape->transitions.buffer);
+    }
+    shape->transitions.buffer[shape->transitions.count++] = child;
+
+    return child;
+}
+
+/*
+Return the offset of a member, or UNE_SHAPE_NO_MEMBER.
+*/
+size_t une_shape_find_member(une_shape *shape, une_symbol name)
+{
+    for (size_t i = 0; i < shape->count; i++)
+        if (shape->names[i] == name)
+            return i;
+    return UNE_SHAPE_NO_MEMBER;
+}
@@ -0,0 +1,43 @@
+/*
+shape.h - Une
+*/
+
+#ifndef UNE_SHAPE_H
+#define UNE_SHAPE_H
+
+/* Header-specific includes. */
+#include "../common.h"
+#include "symbols.h"
+
+/*
+The layout of an object's members, shared by all objects with the same members in the same order.
+Shapes form a tree: each shape is reached from its parent by adding one member.
+*/
+typedef struct une_shape_
+{
+    struct une_shape_ *parent;
+    une_symbol *names; /* Member names, indexed by offset. */
+    size_t count;
+    struct
+    {
+        struct une_shape_ **buffer;
+        size_t size;
+        size_t count;
+    } transitions;
+} une_shape;
+
+/*
+Offset returned for names that are not a member of a shape.
+*/
+#define UNE_SHAPE_NO_MEMBER SIZE_MAX
+
+/*
+*** Interface.
+*/
+
+une_shape *une_shape_create(void);
+void une_shape_free(une_shape *shape);
+une_shape *une_shape_add_member(une_shape *shape, une_symbol name);
+size_t une_shape_find_member(une_shape *shape, une_symbol name);
+
+#endif /* !UNE_SHAPE_H */
@@ -0,0 +1,120 @@
+/*
+symbols.c - Une
+*/
+
+/* Header-specific includes. */
+#include "symbols.h"
+
+/* Implementation-specific includes. */
+#include "../tools.h"
+
+/*
+Hash an identifier (FNV-1a).
+*/
+static size_t une_symbols_hash_(wchar_t *name)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (; *name; name++) {
+        hash ^= (uint64_t)*name;
+        hash *= 1099511628211ULL;
+    }
+    return (size_t)hash;
+}
+
+/*
+Insert a symbol into an index that is known not to contain it.
+*/
+static void une_symbols_index_(une_symbol *index, size_t index_size, size_t hash, une_symbol symbol)
+{
+    size_t mask = index_size - 1;
+    size_t bucket = hash & mask;
+    while (index[bucket] != UNE_SYMBOL_NONE)
+        bucket = (bucket + 1) & mask;
+    index[bucket] = symbol;
+}
+
+/*
+Initialize a une_symbols struct.
+*/
+une_symbols une_symbols_create(void)
+{
+    une_symbols symbols = {.names = NULL,
+                           .size = UNE_SIZE_SYMBOLS + 1,
+                           .count = 1, /* UNE_SYMBOL_NONE. */
+                           .index = NULL,
+                           .index_size = 2};
+    while (symbols.index_size < 2 * symbols.size)
+        symbols.index_size *= 2;
+
+    symbols.names = malloc(symbols.size * sizeof(*symbols.names));
+    verify(symbols.names);
+    symbols.names[UNE_SYMBOL_NONE] = NULL;
+
+    symbols.index = calloc(symbols.index_size, sizeof(*symbols.index));
+    verify(symbols.index);
+
+    return symbols;
+}
+
+/*
+Free all members of a une_symbols struct.
+*/
+void une_symbols_free(une_symbols *symbols)
+{
+    for (size_t i = 1; i < symbols->count; i++)
+        free(symbols->names[i]);
+    free(symbols->names);
+    free(symbols->index);
+}
+
+/*
+Return the symbol of an identifier, interning it if it is new.
+*/
+une_symbol une_symbols_intern(une_symbols *symbols, wchar_t *name)
+{
+    assert(name);
+    size_t hash = une_symbols_hash_(name);
+
+    /* Find existing symbol. */
+    size_t mask = symbols->index_size - 1;
+    for (size_t bucket = hash & mask; symbols->index[bucket] != UNE_SYMBOL_NONE;
+         bucket = (bucket + 1) & mask)
+        if (!wcscmp(symbols->names[symbols->index[bucket]], name))
+            return symbols->index[bucket];
+
+    /* Ensure there is sufficient space in the name buffer. */
+    if (symbols->count >= symbols->size) {
+        symbols->size *= 2;
+        symbols->names = realloc(symbols->names, symbols->size * sizeof(*symbols->names));
+        verify(symbols->names);
+    }
+
+    /* Intern identifier. */
+    une_symbol symbol = symbols->count++;
+    symbols->names[symbol] = wcsdup(name);
+    verify(symbols->names[symbol]);
+
+    /* Keep the index at most half full. */
+    if (2 * symbols->count > symbols->index_size) {
+        size_t index_size = symbols->index_size * 2;
+        une_symbol *index = calloc(index_size, sizeof(*index));
+        verify(index);
+        for (une_symbol i = 1; i < symbol; i++)
+            une_symbols_index_(index, index_size, une_symbols_hash_(symbols->names[i]), i);
+        free(symbols->index);
+        symbols->index = index;
+        symbols->index_size = index_size;
+    }
+    une_symbols_index_(symbols->index, symbols->index_size, hash, symbol);
+
+    return symbol;
+}
+
+/*
+Return the identifier of a symbol.
+*/
+wchar_t *une_symbols_name(une_symbols *symbols, une_symbol symbol)
+{
+    assert(symbol != UNE_SYMBOL_NONE && symbol < symbols->count);
+    return symbols->names[symbol];
+}
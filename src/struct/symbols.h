@@ -0,0 +1,42 @@
+/*
+symbols.h - Une
+*/
+
+#ifndef UNE_SYMBOLS_H
+#define UNE_SYMBOLS_H
+
+/* Header-specific includes. */
+#include "../common.h"
+
+/*
+An interned identifier.
+*/
+typedef size_t une_symbol;
+
+/*
+The symbol that no identifier is interned as.
+*/
+#define UNE_SYMBOL_NONE ((une_symbol)0)
+
+/*
+A table of interned identifiers.
+*/
+typedef struct une_symbols_
+{
+    wchar_t **names; /* Indexed by une_symbol. */
+    size_t size;
+    size_t count;
+    une_symbol *index; /* Open addressing hash table, UNE_SYMBOL_NONE marks empty buckets. */
+    size_t index_size; /* A power of two. */
+} une_symbols;
+
+/*
+*** Interface.
+*/
+
+une_symbols une_symbols_create(void);
+void une_symbols_free(une_symbols *symbols);
+une_symbol une_symbols_intern(une_symbols *symbols, wchar_t *name);
+wchar_t *une_symbols_name(une_symbols *symbols, une_symbol symbol);
+
+#endif /* !UNE_SYMBOLS_H */
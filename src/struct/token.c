@@ -6,7 +6,7 @@ token.c - Une
 #include "token.h"
 
 /* Implementation-specific includes. */
-#include "../natives.h"
+#include "engine.h"
 #include "../tools.h"
 
 /*
@@ -19,7 +19,6 @@ const wchar_t *une_token_table[] = {
     L"\"{",
     L"}\"",
     L"name",
-    L"native",
     L"EOF",
     /* Begin keyword tokens. */
     L"True",
@@ -102,7 +101,6 @@ void une_token_free(une_token token)
 
     /* Free members. */
     switch (token.kind) {
-    case UNE_TK_NAME:
     case UNE_TK_STR:
         free(token.value._wcs);
         break;
@@ -198,15 +196,7 @@ une_static__ wchar_t *une_token_to_wcs(une_token token)
         str_len += swprintf(str + wcslen(str),
                             UNE_SIZE_TOKEN_AS_WCS,
                             L":" UNE_COLOR_TOKEN_VALUE L"%ls" UNE_COLOR_RESET,
-                            token.value._wcs);
-        break;
-
-    /* Native function. */
-    case UNE_TK_NATIVE:
-        str_len += swprintf(str + wcslen(str),
-                            UNE_SIZE_TOKEN_AS_WCS,
-                            L":" UNE_COLOR_TOKEN_VALUE L"%ls" UNE_COLOR_RESET,
-                            une_native_to_wcs((une_native)token.value._int));
+                            une_symbols_name(&felix->symbols, (une_symbol)token.value._id));
         break;
 
     /* No token value. */
@@ -20,7 +20,6 @@ typedef enum une_token_kind_
     UNE_TK_STR_EXPRESSION_BEGIN,
     UNE_TK_STR_EXPRESSION_END,
     UNE_TK_NAME,
-    UNE_TK_NATIVE,
     UNE_TK_EOF,
 #define UNE_R_BGN_KEYWORD_TOKENS UNE_TK_TRUE
     UNE_TK_TRUE,
@@ -7,6 +7,7 @@ tools.c - Une
 
 /* Implementation-specific includes. */
 #include <errno.h>
+#include <float.h>
 #include <limits.h>
 #include <string.h>
 #include <time.h>
@@ -16,9 +17,20 @@ tools.c - Une
 #define PATH_MAX MAX_PATH /* MinGW defines both of these for compatibility. */
 #else
 #include <ctype.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(UNE_NO_SIMD)
+#include <immintrin.h>
+#define UNE_FILE_READ_AVX2
+#endif
+#if defined(__GNUC__) && defined(__SSE2__) && !defined(UNE_NO_SIMD)
+#include <emmintrin.h>
+#define UNE_FILE_READ_SSE2
+#endif
 #include "lexer.h"
 
 /*
@@ -31,14 +43,14 @@ une_flt (*une_flt_floor)(une_flt) = floor;
 une_flt (*une_flt_mod)(une_flt, une_flt) = fmod;
 
 /*
-Convert a wchar_t string into a une_int integer.
+Convert a wchar_t string of the given length into a une_int integer.
 */
-bool une_wcs_to_une_int(wchar_t *wcs, une_int *dest)
+bool une_wcs_to_une_int(wchar_t *wcs, size_t length, une_int *dest)
 {
-    assert(wcs);
+    assert(wcs && wcs[length] == L'\0');
     une_lexer_state ls = une_lexer_state_create();
     ls.text = wcs;
-    ls.text_length = wcslen(ls.text);
+    ls.text_length = length;
     une_error error = une_error_create();
     une_token token = une_lex_number(&error, &ls, true);
     if (token.kind != UNE_TK_INT)
@@ -48,25 +60,97 @@ bool une_wcs_to_une_int(wchar_t *wcs, une_int *dest)
 }
 
 /*
-Convert a wchar_t string into a une_flt floating pointer number.
+Convert a wchar_t string of the given length into a une_flt floating pointer number.
 */
-bool une_wcs_to_une_flt(wchar_t *wcs, une_flt *dest)
+bool une_wcs_to_une_flt(wchar_t *wcs, size_t length, une_flt *dest)
 {
-    assert(wcs);
+    assert(wcs && wcs[length] == L'\0');
     une_lexer_state ls = une_lexer_state_create();
     ls.text = wcs;
-    ls.text_length = wcslen(ls.text);
+    ls.text_length = length;
     une_error error = une_error_create();
     une_token token = une_lex_number(&error, &ls, true);
     if (token.kind == UNE_TK_FLT)
         *dest = token.value._flt;
-    else if (token.kind == UNE_TK_INT)
-        *dest = (une_flt)token.value._int;
-    else
+    else if (token.kind != UNE_TK_INT)
         return false;
+    else if (wcs[0] == L'0' && UNE_LEXER_WC_CAN_BEGIN_NAME(wcs[1]))
+        *dest = (une_flt)token.value._int; /* Binary, octal or hexadecimal. */
+    else
+        /* Decimal integers are converted from their text, since they may not fit une_int. */
+        *dest = une_decimal_wcs_to_une_flt(wcs + token.pos.start, token.pos.end - token.pos.start);
     return true;
 }
 
+/*
+Convert a decimal number the lexer has validated (an optional '-', digits, an optional fraction and
+an optional exponent marked by 'E') into the nearest une_flt.
+*/
+une_flt une_decimal_wcs_to_une_flt(wchar_t *wcs, size_t length)
+{
+    static const une_flt powers_of_ten[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                            1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                            1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    size_t i = 0;
+    bool is_negative = wcs[i] == L'-';
+    if (is_negative)
+        i++;
+
+    /* Gather the significant digits. Up to 19 of them always fit in 64 bits. */
+    while (i < length && wcs[i] == L'0')
+        i++;
+    uint64_t mantissa = 0;
+    size_t first_digit = i;
+    for (; i < length && wcs[i] >= L'0' && wcs[i] <= L'9'; i++)
+        mantissa = mantissa * 10 + (uint64_t)(wcs[i] - L'0');
+    size_t significant_digits = i - first_digit;
+    int64_t exponent = 0;
+    if (i < length && wcs[i] == L'.') {
+        i++;
+        if (mantissa == 0)
+            for (; i < length && wcs[i] == L'0'; i++)
+                exponent--;
+        size_t first_fraction_digit = i;
+        for (; i < length && wcs[i] >= L'0' && wcs[i] <= L'9'; i++)
+            mantissa = mantissa * 10 + (uint64_t)(wcs[i] - L'0');
+        significant_digits += i - first_fraction_digit;
+        exponent -= (int64_t)(i - first_fraction_digit);
+    }
+    if (i < length && wcs[i] == L'E') {
+        i++;
+        bool exponent_is_negative = wcs[i] == L'-';
+        if (exponent_is_negative)
+            i++;
+        int64_t explicit_exponent = 0;
+        for (; i < length && explicit_exponent < 100000; i++)
+            explicit_exponent = explicit_exponent * 10 + (wcs[i] - L'0');
+        exponent += exponent_is_negative ? -explicit_exponent : explicit_exponent;
+    }
+
+    /* Both the mantissa and the power of ten are exact, so a single operation rounds correctly. */
+    une_flt flt;
+    if (mantissa == 0) {
+        flt = UNE_NEW_FLT(0.0);
+    } else if (significant_digits <= 19 && mantissa <= (UINT64_C(1) << 53) && exponent >= -22 &&
+               exponent <= 22) {
+        flt = exponent < 0 ? (une_flt)mantissa / powers_of_ten[-exponent]
+                           : (une_flt)mantissa * powers_of_ten[exponent];
+    } else {
+        /* Rare cases are left to strtod, which also rounds correctly. */
+        char buffer[UNE_SIZE_NUMBER_AS_STRING];
+        char *str = length < UNE_SIZE_NUMBER_AS_STRING ? buffer : malloc(length + 1);
+        verify(str);
+        size_t start = is_negative ? 1 : 0;
+        for (size_t j = start; j < length; j++)
+            str[j - start] = (char)wcs[j];
+        str[length - start] = '\0';
+        flt = strtod(str, NULL);
+        if (str != buffer)
+            free(str);
+    }
+    return is_negative ? -flt : flt;
+}
+
 /*
 Create a wchar_t string from a char string.
 */
@@ -104,20 +188,147 @@ Create a wchar_t string representation of a une_flt.
 */
 wchar_t *une_flt_to_wcs(une_flt flt)
 {
-    /* Try to strip imprecise digits. */
     wchar_t *wcs = malloc(UNE_SIZE_NUMBER_AS_STRING * sizeof(*wcs));
     verify(wcs);
-    swprintf(wcs, UNE_SIZE_NUMBER_AS_STRING, UNE_PRINTF_UNE_FLT, UNE_FLT_PRECISION, flt);
+    une_flt_to_wcs_buffer(flt, wcs);
+    return wcs;
+}
 
-    /* Strip trailing zeros. */
-    size_t wcs_length = wcslen(wcs);
-    for (size_t i = wcs_length - 1; i > wcs_length - UNE_FLT_PRECISION; i--) {
-        if (wcs[i] != L'0')
-            break;
-        wcs[i] = L'\0';
+/*
+Write the representation of a une_flt into wcs, which holds UNE_SIZE_NUMBER_AS_STRING characters,
+and return its length. The value is rounded to UNE_FLT_PRECISION decimals as UNE_PRINTF_UNE_FLT
+would, and trailing zeros are stripped down to one.
+*/
+size_t une_flt_to_wcs_buffer(une_flt flt, wchar_t *wcs)
+{
+    if (!isfinite(flt)) {
+        int length =
+            swprintf(wcs, UNE_SIZE_NUMBER_AS_STRING, UNE_PRINTF_UNE_FLT, UNE_FLT_PRECISION, flt);
+        assert(length > 0);
+        return (size_t)length;
     }
 
-    return wcs;
+    /* flt is mantissa * 2^exponent, so flt * 10^UNE_FLT_PRECISION is
+    mantissa * 5^UNE_FLT_PRECISION * 2^(exponent + UNE_FLT_PRECISION), which is computed exactly in
+    32-bit limbs. */
+    int exponent;
+    uint64_t mantissa = (uint64_t)ldexp(frexp(fabs(flt), &exponent), DBL_MANT_DIG);
+    exponent -= DBL_MANT_DIG;
+    uint32_t limbs[(DBL_MAX_EXP + 4 * UNE_FLT_PRECISION) / 32 + 2];
+    size_t count = 0;
+    for (; mantissa; mantissa >>= 32)
+        limbs[count++] = (uint32_t)mantissa;
+    uint64_t carry = 0;
+    uint32_t power_of_five = 1;
+    for (int i = 0; i < UNE_FLT_PRECISION; i++)
+        power_of_five *= 5;
+    for (size_t i = 0; i < count; i++) {
+        carry += (uint64_t)limbs[i] * power_of_five;
+        limbs[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    if (carry)
+        limbs[count++] = (uint32_t)carry;
+
+    int shift = exponent + UNE_FLT_PRECISION;
+    if (shift > 0 && count) {
+        size_t limb_shift = (size_t)shift / 32;
+        int bit_shift = shift % 32;
+        limbs[count] = 0;
+        for (size_t i = count + 1; i-- > 0;) {
+            uint64_t wide = (uint64_t)limbs[i] << bit_shift;
+            if (bit_shift && i > 0)
+                wide |= limbs[i - 1] >> (32 - bit_shift);
+            limbs[i + limb_shift] = (uint32_t)wide;
+        }
+        for (size_t i = 0; i < limb_shift; i++)
+            limbs[i] = 0;
+        count += limb_shift + 1;
+    } else if (shift < 0) {
+        /* Round half to even, like printf. */
+        size_t half = (size_t)-shift - 1;
+        bool is_half = half / 32 < count && (limbs[half / 32] >> half % 32 & 1);
+        bool is_above_half = false;
+        for (size_t i = 0; i < count && i <= half / 32 && !is_above_half; i++) {
+            uint32_t below = i < half / 32 ? limbs[i] : limbs[i] & ((UINT32_C(1) << half % 32) - 1);
+            is_above_half = below != 0;
+        }
+        size_t limb_shift = (size_t)-shift / 32;
+        int bit_shift = -shift % 32;
+        size_t remaining = count > limb_shift ? count - limb_shift : 0;
+        for (size_t i = 0; i < remaining; i++) {
+            uint64_t wide = limbs[i + limb_shift] >> bit_shift;
+            if (bit_shift && i + limb_shift + 1 < count)
+                wide |= (uint64_t)limbs[i + limb_shift + 1] << (32 - bit_shift);
+            limbs[i] = (uint32_t)wide;
+        }
+        count = remaining;
+        if (is_half && (is_above_half || (count && limbs[0] & 1))) {
+            size_t i = 0;
+            for (; i < count && ++limbs[i] == 0; i++)
+                ;
+            if (i == count)
+                limbs[count++] = 1;
+        }
+    }
+    while (count && !limbs[count - 1])
+        count--;
+
+    /* Collect the decimal digits, least significant first, nine at a time. */
+    char digits[UNE_SIZE_NUMBER_AS_STRING];
+    size_t digits_count = 0;
+    while (count) {
+        uint64_t remainder = 0;
+        for (size_t i = count; i-- > 0;) {
+            uint64_t current = remainder << 32 | limbs[i];
+            limbs[i] = (uint32_t)(current / 1000000000);
+            remainder = current % 1000000000;
+        }
+        while (count && !limbs[count - 1])
+            count--;
+        for (int i = 0; i < 9 && (count || remainder); i++) {
+            digits[digits_count++] = (char)('0' + remainder % 10);
+            remainder /= 10;
+        }
+    }
+    while (digits_count <= UNE_FLT_PRECISION)
+        digits[digits_count++] = '0';
+
+    size_t length = 0;
+    if (signbit(flt))
+        wcs[length++] = L'-';
+    for (size_t i = digits_count; i-- > UNE_FLT_PRECISION;)
+        wcs[length++] = (wchar_t)digits[i];
+    wcs[length++] = L'.';
+    size_t last = 0;
+    while (last < UNE_FLT_PRECISION - 1 && digits[last] == '0')
+        last++;
+    for (size_t i = UNE_FLT_PRECISION; i-- > last;)
+        wcs[length++] = (wchar_t)digits[i];
+    wcs[length] = L'\0';
+    return length;
+}
+
+/*
+Write the representation of a une_int into wcs, which holds UNE_SIZE_NUMBER_AS_STRING characters,
+and return its length.
+*/
+size_t une_int_to_wcs_buffer(une_int int_, wchar_t *wcs)
+{
+    une_uint magnitude = int_ < 0 ? (une_uint)0 - (une_uint)int_ : (une_uint)int_;
+    size_t length = int_ < 0 ? 1 : 0;
+    for (une_uint rest = magnitude; rest >= 10; rest /= 10)
+        length++;
+    length++;
+    wcs[length] = L'\0';
+    size_t i = length;
+    do {
+        wcs[--i] = (wchar_t)(L'0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+    if (int_ < 0)
+        wcs[0] = L'-';
+    return length;
 }
 
 /*
@@ -187,58 +398,336 @@ bool une_file_or_folder_exists(char *path)
 }
 
 /*
-Open a UTF-8 file at 'path' and return its text contents as wchar_t string.
+Read a file into a buffer, for files that cannot be mapped (e.g. pipes or empty files).
 */
-wchar_t *une_file_read(char *path, bool normalize_line_endings, size_t convert_tabs_to_spaces)
+static bool read_file_bytes(char *path, une_file_bytes *file)
 {
-    if (path == NULL)
-        return NULL;
-
-    FILE *stream = fopen(path, UNE_FOPEN_RFLAGS);
+    FILE *stream = fopen(path, "rb");
     if (stream == NULL)
-        return NULL;
+        return false;
+    size_t capacity = UNE_SIZE_FILE_BUFFER;
+    unsigned char *bytes = malloc(capacity);
+    verify(bytes);
+    size_t size = 0;
+    size_t count;
+    while ((count = fread(bytes + size, 1, capacity - size, stream)) > 0) {
+        size += count;
+        if (size == capacity) {
+            capacity *= 2;
+            bytes = realloc(bytes, capacity);
+            verify(bytes);
+        }
+    }
+    fclose(stream);
+    *file = (une_file_bytes){.bytes = bytes, .size = size, .is_mapped = false};
+    return true;
+}
 
-    size_t content_size = UNE_SIZE_FILE_BUFFER;
-    wchar_t *content = malloc(content_size * sizeof(*content));
-    verify(content);
+/*
+Get the bytes of a file, mapping it into memory where possible so that it is not copied.
+*/
+bool une_file_bytes_open(char *path, une_file_bytes *file)
+{
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(path,
+                                GENERIC_READ,
+                                FILE_SHARE_READ,
+                                NULL,
+                                OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                NULL);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size;
+    void *view = NULL;
+    if (GetFileSizeEx(handle, &size) && size.QuadPart > 0 && (uint64_t)size.QuadPart <= SIZE_MAX) {
+        HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping); /* The view keeps the mapping alive. */
+        }
+    }
+    CloseHandle(handle);
+    if (view) {
+        *file = (une_file_bytes){.bytes = view, .size = (size_t)size.QuadPart, .is_mapped = true};
+        return true;
+    }
+#else
+    int descriptor = open(path, O_RDONLY);
+    if (descriptor == -1)
+        return false;
+    struct stat status;
+    void *view = MAP_FAILED;
+    if (fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0 &&
+        (uint64_t)status.st_size <= SIZE_MAX) {
+        int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+        flags |= MAP_POPULATE; /* Fault all pages in at once, since all of them are read. */
+#endif
+        view = mmap(NULL, (size_t)status.st_size, PROT_READ, flags, descriptor, 0);
+    }
+    close(descriptor);
+    if (view != MAP_FAILED) {
+        *file = (une_file_bytes){.bytes = view, .size = (size_t)status.st_size, .is_mapped = true};
+        return true;
+    }
+#endif
+    return read_file_bytes(path, file);
+}
 
-    size_t index = 0;
-    wint_t current_character; /* DOC: Can represent any Unicode character + WEOF (!).
-                             This is important when using fgetwc(), as otherwise,
-                             WEOF will overflow and be indistinguishable from an
-                             actual character. */
+/*
+Release the bytes of a file.
+*/
+void une_file_bytes_close(une_file_bytes *file)
+{
+    if (!file->is_mapped) {
+        free((void *)file->bytes);
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(file->bytes);
+#else
+    munmap((void *)file->bytes, file->size);
+#endif
+}
 
-    while (true) {
-        current_character = fgetwc(stream);
+/*
+Get the length of the byte order mark at the start of UTF-8 bytes, if there is one.
+*/
+static size_t byte_order_mark_length(const unsigned char *bytes, size_t size)
+{
+    return size >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF ? 3 : 0;
+}
 
-        if (normalize_line_endings && current_character == L'\r')
-            continue;
+/*
+Decode the UTF-8 sequence at the start of bytes into a code point, and return the number of bytes
+it spans. Overlong, surrogate, out-of-range, and truncated sequences decode to U+FFFD and span one
+byte, so that decoding resumes at the next byte.
+*/
+static size_t decode_utf8(const unsigned char *bytes, size_t size, uint32_t *code_point)
+{
+    static const uint32_t minimums[] = {0, 0, 0x80, 0x800, 0x10000};
+    unsigned char lead = bytes[0];
+    if (lead < 0x80) {
+        *code_point = lead;
+        return 1;
+    }
+    *code_point = 0xFFFD;
+    size_t length = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 1;
+    if (length == 1 || lead > 0xF4 || length > size)
+        return 1;
+    uint32_t decoded = lead & (0x7F >> length);
+    for (size_t i = 1; i < length; i++) {
+        if ((bytes[i] & 0xC0) != 0x80)
+            return 1;
+        decoded = (decoded << 6) | (bytes[i] & 0x3F);
+    }
+    bool is_surrogate = decoded >= 0xD800 && decoded <= 0xDFFF;
+    if (decoded < minimums[length] || decoded > 0x10FFFF || is_surrogate)
+        return 1;
+    *code_point = decoded;
+    return length;
+}
 
-        size_t insertion_length = 1;
-        if (convert_tabs_to_spaces > 0 && current_character == L'\t')
-            insertion_length = convert_tabs_to_spaces;
+/*
+Get the number of bytes at the start of bytes that are ASCII, and neither CR if stop_at_cr is true
+nor a tab if stop_at_tab is true, so that they can be copied as they are.
+*/
+static size_t plain_prefix_scalar(
+    const unsigned char *bytes, size_t size, bool stop_at_cr, bool stop_at_tab)
+{
+    size_t position = 0;
+    for (; position < size; position++) {
+        unsigned char byte = bytes[position];
+        if (byte >= 0x80 || (stop_at_cr && byte == '\r') || (stop_at_tab && byte == '\t'))
+            break;
+    }
+    return position;
+}
 
-        if (index + insertion_length > content_size) {
-            content_size *= 2;
-            content = realloc(content, content_size * sizeof(*content));
-            verify(content);
-        }
+#ifdef UNE_FILE_READ_SSE2
+static size_t plain_prefix_sse2(
+    const unsigned char *bytes, size_t size, bool stop_at_cr, bool stop_at_tab)
+{
+    /* Bytes that are not stopped at are compared to 0x80, which is stopped at anyway. */
+    __m128i cr = _mm_set1_epi8(stop_at_cr ? '\r' : (char)0x80);
+    __m128i tab = _mm_set1_epi8(stop_at_tab ? '\t' : (char)0x80);
+    size_t position = 0;
+    for (; position + 16 <= size; position += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(bytes + position));
+        __m128i stops = _mm_or_si128(_mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, tab));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_or_si128(chunk, stops));
+        if (mask)
+            return position + (size_t)__builtin_ctz(mask);
+    }
+    size_t rest = size - position;
+    return position + plain_prefix_scalar(bytes + position, rest, stop_at_cr, stop_at_tab);
+}
+#endif /* UNE_FILE_READ_SSE2 */
 
-        if (convert_tabs_to_spaces > 0 && current_character == L'\t') {
-            for (size_t i = 0; i < convert_tabs_to_spaces; i++)
-                content[index + i] = L' ';
-        } else if (current_character == WEOF) {
-            content[index] = L'\0';
-            break;
+#ifdef UNE_FILE_READ_AVX2
+__attribute__((target("avx2"))) static size_t
+plain_prefix_avx2(const unsigned char *bytes, size_t size, bool stop_at_cr, bool stop_at_tab)
+{
+    /* Bytes that are not stopped at are compared to 0x80, which is stopped at anyway. */
+    __m256i cr = _mm256_set1_epi8(stop_at_cr ? '\r' : (char)0x80);
+    __m256i tab = _mm256_set1_epi8(stop_at_tab ? '\t' : (char)0x80);
+    size_t position = 0;
+    for (; position + 32 <= size; position += 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i *)(bytes + position));
+        __m256i stops =
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, cr), _mm256_cmpeq_epi8(chunk, tab));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_or_si256(chunk, stops));
+        if (mask)
+            return position + (size_t)__builtin_ctz(mask);
+    }
+    size_t rest = size - position;
+    return position + plain_prefix_scalar(bytes + position, rest, stop_at_cr, stop_at_tab);
+}
+#endif /* UNE_FILE_READ_AVX2 */
+
+/*
+The fastest scan the processor supports, chosen on first use.
+*/
+static size_t (*plain_prefix)(const unsigned char *, size_t, bool, bool) = NULL;
+
+static void choose_plain_prefix(void)
+{
+    plain_prefix = &plain_prefix_scalar;
+#ifdef UNE_FILE_READ_SSE2
+    plain_prefix = &plain_prefix_sse2;
+#endif
+#ifdef UNE_FILE_READ_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        plain_prefix = &plain_prefix_avx2;
+#endif
+}
+
+/*
+Check if UTF-8 bytes only encode characters that fit in a single byte (Latin-1).
+*/
+bool une_utf8_fits_narrow(const unsigned char *bytes, size_t size)
+{
+    if (!plain_prefix)
+        choose_plain_prefix();
+    size_t position = byte_order_mark_length(bytes, size);
+    while (true) {
+        position += plain_prefix(bytes + position, size - position, false, false);
+        if (position == size)
+            return true;
+        /* Only valid two-byte sequences with a lead of 0xC2 or 0xC3 encode U+0080 to U+00FF. */
+        if ((bytes[position] != 0xC2 && bytes[position] != 0xC3) || position + 1 == size ||
+            (bytes[position + 1] & 0xC0) != 0x80)
+            return false;
+        position += 2;
+    }
+}
+
+/*
+Decode UTF-8 bytes into text, stored narrow if is_narrow is true (see une_utf8_fits_narrow) or with
+one wchar_t per character otherwise. CRs are dropped if normalize_line_endings is true, and tabs are
+replaced by tab_width spaces if it is not 0. text must fit every byte plus the extra spaces. Return
+the number of characters written. Runs of plain ASCII, which make up most text, are found in vector
+steps and copied in bulk.
+*/
+size_t une_utf8_decode(const unsigned char *bytes,
+                       size_t size,
+                       void *text,
+                       bool is_narrow,
+                       bool normalize_line_endings,
+                       size_t tab_width)
+{
+    if (!plain_prefix)
+        choose_plain_prefix();
+    unsigned char *narrow = text;
+    wchar_t *wide = text;
+    size_t position = byte_order_mark_length(bytes, size);
+    size_t written = 0;
+
+    while (position < size) {
+        size_t plain = plain_prefix(
+            bytes + position, size - position, normalize_line_endings, tab_width > 0);
+        if (is_narrow) {
+            memcpy(narrow + written, bytes + position, plain);
         } else {
-            content[index] = (wchar_t)current_character;
+            for (size_t i = 0; i < plain; i++)
+                wide[written + i] = (wchar_t)bytes[position + i];
         }
+        position += plain;
+        written += plain;
+        if (position == size)
+            break;
 
-        index += insertion_length;
+        unsigned char byte = bytes[position];
+        if (byte == '\r' && normalize_line_endings) {
+            position++;
+            continue;
+        }
+        if (byte == '\t' && tab_width > 0) {
+            for (size_t i = 0; i < tab_width; i++, written++)
+                if (is_narrow)
+                    narrow[written] = ' ';
+                else
+                    wide[written] = L' ';
+            position++;
+            continue;
+        }
+
+        /* Decode the run of multi-byte sequences. */
+        do {
+            uint32_t code_point;
+            position += decode_utf8(bytes + position, size - position, &code_point);
+            if (is_narrow) {
+                assert(code_point <= 0xFF);
+                narrow[written++] = (unsigned char)code_point;
+                continue;
+            }
+#if WCHAR_MAX <= 0xFFFF
+            if (code_point > 0xFFFF) {
+                code_point -= 0x10000;
+                wide[written++] = (wchar_t)(0xD800 + (code_point >> 10));
+                wide[written++] = (wchar_t)(0xDC00 + (code_point & 0x3FF));
+                continue;
+            }
+#endif
+            wide[written++] = (wchar_t)code_point;
+        } while (position < size && bytes[position] >= 0x80);
     }
+    return written;
+}
 
-    fclose(stream);
+/*
+Open a UTF-8 file at 'path' and return its text contents as wchar_t string.
+*/
+wchar_t *une_file_read(char *path, bool normalize_line_endings, size_t convert_tabs_to_spaces)
+{
+    if (path == NULL)
+        return NULL;
+
+    une_file_bytes file;
+    if (!une_file_bytes_open(path, &file))
+        return NULL;
+
+    /* Every byte becomes at most one wchar_t, except tabs. */
+    size_t capacity = file.size;
+    if (convert_tabs_to_spaces > 1) {
+        const unsigned char *tab = file.bytes;
+        const unsigned char *end = file.bytes + file.size;
+        while ((tab = memchr(tab, '\t', (size_t)(end - tab)))) {
+            capacity += convert_tabs_to_spaces - 1;
+            tab++;
+        }
+    }
+
+    wchar_t *content = malloc((capacity + 1) * sizeof(*content));
+    verify(content);
+    size_t length = une_utf8_decode(
+        file.bytes, file.size, content, false, normalize_line_endings, convert_tabs_to_spaces);
+    assert(length <= capacity);
+    content[length] = L'\0';
 
+    une_file_bytes_close(&file);
     return content;
 }
 
@@ -346,6 +835,29 @@ char *une_path_get_label(char *path)
     return label;
 }
 
+/*
+Get the lowest address the C stack of the calling thread may grow to before UNE_STACK_RESERVE bytes
+remain. Assumes the stack grows downward, and that the caller is near its top.
+*/
+uintptr_t une_stack_limit(void)
+{
+    char marker;
+    uintptr_t top = (uintptr_t)&marker;
+#ifdef _WIN32
+    MEMORY_BASIC_INFORMATION info;
+    if (VirtualQuery(&marker, &info, sizeof(info)) == 0)
+        return 0;
+    size_t size = (size_t)(top - (uintptr_t)info.AllocationBase);
+#else
+    size_t size = UNE_STACK_SIZE_UNLIMITED;
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_STACK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+        size = (size_t)limit.rlim_cur;
+#endif
+    size_t reserve = UNE_STACK_RESERVE < size / 2 ? UNE_STACK_RESERVE : size / 2;
+    return size < top ? top - size + reserve : reserve;
+}
+
 /*
 Halt execution for the specified number of miliseconds.
 */
@@ -21,6 +21,16 @@ typedef struct une_range_
     size_t length;
 } une_range;
 
+/*
+The bytes of a file, either mapped into memory or read into a buffer.
+*/
+typedef struct une_file_bytes_
+{
+    const unsigned char *bytes;
+    size_t size;
+    bool is_mapped;
+} une_file_bytes;
+
 /*
 *** Interface.
 */
@@ -41,18 +51,30 @@ extern une_flt (*une_flt_abs)(une_flt);
 extern une_flt (*une_flt_floor)(une_flt);
 extern une_flt (*une_flt_mod)(une_flt, une_flt);
 
-bool une_wcs_to_une_int(wchar_t *wcs, une_int *dest);
-bool une_wcs_to_une_flt(wchar_t *wcs, une_flt *dest);
+bool une_wcs_to_une_int(wchar_t *wcs, size_t length, une_int *dest);
+bool une_wcs_to_une_flt(wchar_t *wcs, size_t length, une_flt *dest);
+une_flt une_decimal_wcs_to_une_flt(wchar_t *wcs, size_t length);
 
 wchar_t *une_str_to_wcs(char *str);
 char *une_wcs_to_str(wchar_t *wcs);
 
 wchar_t *une_flt_to_wcs(une_flt flt);
+size_t une_flt_to_wcs_buffer(une_flt flt, wchar_t *wcs);
+size_t une_int_to_wcs_buffer(une_int int_, wchar_t *wcs);
 
 char *une_resolve_path(char *path);
 
 bool une_file_exists(char *path);
 bool une_file_or_folder_exists(char *path);
+bool une_file_bytes_open(char *path, une_file_bytes *file);
+void une_file_bytes_close(une_file_bytes *file);
+bool une_utf8_fits_narrow(const unsigned char *bytes, size_t size);
+size_t une_utf8_decode(const unsigned char *bytes,
+                       size_t size,
+                       void *text,
+                       bool is_narrow,
+                       bool normalize_line_endings,
+                       size_t tab_width);
 wchar_t *une_file_read(char *path, bool normalize_line_endings, size_t convert_tabs_to_spaces);
 bool une_file_extension_matches(char *path, char *extension);
 
@@ -61,6 +83,8 @@ bool une_set_working_directory(wchar_t *path);
 
 char *une_path_get_label(char *path);
 
+uintptr_t une_stack_limit(void);
+
 void une_sleep_ms(int ms);
 
 bool une_play_wav(wchar_t *path);
@@ -39,8 +39,10 @@ void une_traceback_print_trace(une_context *context)
              UNE_COLOR_TRACEBACK_LOCATION L"File \"%hs\", line %zu",
              module_name,
              position.line);
-    if (context->label)
-        fwprintf(UNE_ERROR_STREAM, L", in %ls", context->label);
+    if (context->label != UNE_SYMBOL_NONE)
+        fwprintf(UNE_ERROR_STREAM,
+                 L", in %ls",
+                 une_symbols_name(&felix->symbols, context->label));
     fwprintf(UNE_ERROR_STREAM, ":\n" UNE_COLOR_RESET);
 
     /* Print extract. */
@@ -93,9 +95,20 @@ void une_traceback_print(void)
     une_context **lineage;
     size_t lineage_length = une_context_get_lineage(felix->is.context, &lineage);
 
+    une_context *previous = NULL;
+    size_t repetitions = 0;
     for (size_t i = 0; i < lineage_length; i++) {
         une_context *context = lineage[lineage_length - 1 - i];
 
+        /* Collapse traces repeated by recursion. */
+        if (previous && une_traceback_traces_equal(previous, context)) {
+            repetitions++;
+            continue;
+        }
+        une_traceback_print_repetitions(repetitions);
+        repetitions = 0;
+        previous = context;
+
 #if defined(UNE_DEBUG) && defined(UNE_DBG_DISPLAY_EXTENDED_ERROR)
         fwprintf(UNE_ERROR_STREAM, UNE_COLOR_HINT L"--- Generation: %zu" UNE_COLOR_RESET L"\n", i);
         if (context->is_transparent)
@@ -111,6 +124,31 @@ void une_traceback_print(void)
         }
 #endif
     }
+    une_traceback_print_repetitions(repetitions);
 
     free(lineage);
 }
+
+/*
+Check whether two contexts produce the same trace.
+*/
+une_static__ bool une_traceback_traces_equal(une_context *left, une_context *right)
+{
+    return left->module_id == right->module_id && left->label == right->label &&
+           left->is_transparent == right->is_transparent &&
+           left->exit_position.start == right->exit_position.start &&
+           left->exit_position.end == right->exit_position.end;
+}
+
+/*
+Print how many times the previous trace was repeated.
+*/
+une_static__ void une_traceback_print_repetitions(size_t repetitions)
+{
+    if (repetitions == 0)
+        return;
+    fwprintf(UNE_ERROR_STREAM,
+             UNE_COLOR_HINT L"[Previous trace repeated %zu more time%ls.]" UNE_COLOR_RESET L"\n",
+             repetitions,
+             repetitions == 1 ? L"" : L"s");
+}
@@ -13,4 +13,7 @@ traceback.h - Une
 void une_traceback_print_trace(une_context *context);
 void une_traceback_print(void);
 
+une_static__ bool une_traceback_traces_equal(une_context *left, une_context *right);
+une_static__ void une_traceback_print_repetitions(size_t repetitions);
+
 #endif /* !UNE_TRACEBACK_H */
@@ -0,0 +1,894 @@
+/*
+array.c - Une
+*/
+
+/* Header-specific includes. */
+#include "array.h"
+
+/* Implementation-specific includes. */
+#include "../tools.h"
+#include "flt.h"
+#include "int.h"
+#include <string.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(UNE_NO_SIMD)
+#define UNE_ARRAY_KERNELS_AVX2
+#endif
+
+/*
+*** Helpers.
+*/
+
+/*
+Element-wise operations.
+*/
+typedef enum operation_
+{
+    OPERATION_ADD,
+    OPERATION_SUB,
+    OPERATION_MUL,
+    OPERATION_DIV,
+} operation;
+
+/*
+Kernels are plain loops over contiguous items, which the compiler vectorizes. They are written once
+and compiled for the baseline instruction set (SSE2 on x86-64) and for AVX2.
+*/
+#ifdef __GNUC__
+#define KERNEL__ static inline __attribute__((always_inline))
+#else
+#define KERNEL__ static inline
+#endif
+
+/*
+Number of partial results kept by reductions, so that they can be held in vector registers. They
+are combined in the same order for every instruction set, so the result does not depend on the
+processor.
+*/
+#define LANES 8
+
+/*
+Apply an operation to every item of left and the item of right at the same position, or scalar if
+right is NULL. out may be left. INTs wrap around on overflow.
+*/
+#define FOR_EACH_ITEM__(expression__)                                                              \
+    for (size_t i = 0; i < length; i++)                                                            \
+    out[i] = (expression__)
+
+KERNEL__ void operate_ints(operation op,
+                           une_int *out,
+                           const une_int *left,
+                           const une_int *right,
+                           une_int scalar,
+                           size_t length)
+{
+    assert(op != OPERATION_DIV);
+    if (right) {
+        if (op == OPERATION_ADD)
+            FOR_EACH_ITEM__((une_int)((uint64_t)left[i] + (uint64_t)right[i]));
+        else if (op == OPERATION_SUB)
+            FOR_EACH_ITEM__((une_int)((uint64_t)left[i] - (uint64_t)right[i]));
+        else
+            FOR_EACH_ITEM__((une_int)((uint64_t)left[i] * (uint64_t)right[i]));
+        return;
+    }
+    if (op == OPERATION_ADD)
+        FOR_EACH_ITEM__((une_int)((uint64_t)left[i] + (uint64_t)scalar));
+    else if (op == OPERATION_SUB)
+        FOR_EACH_ITEM__((une_int)((uint64_t)left[i] - (uint64_t)scalar));
+    else
+        FOR_EACH_ITEM__((une_int)((uint64_t)left[i] * (uint64_t)scalar));
+}
+
+KERNEL__ void operate_flts(operation op,
+                           une_flt *out,
+                           const une_flt *left,
+                           const une_flt *right,
+                           une_flt scalar,
+                           size_t length)
+{
+    if (right) {
+        if (op == OPERATION_ADD)
+            FOR_EACH_ITEM__(left[i] + right[i]);
+        else if (op == OPERATION_SUB)
+            FOR_EACH_ITEM__(left[i] - right[i]);
+        else if (op == OPERATION_MUL)
+            FOR_EACH_ITEM__(left[i] * right[i]);
+        else
+            FOR_EACH_ITEM__(left[i] / right[i]);
+        return;
+    }
+    if (op == OPERATION_ADD)
+        FOR_EACH_ITEM__(left[i] + scalar);
+    else if (op == OPERATION_SUB)
+        FOR_EACH_ITEM__(left[i] - scalar);
+    else if (op == OPERATION_MUL)
+        FOR_EACH_ITEM__(left[i] * scalar);
+    else
+        FOR_EACH_ITEM__(left[i] / scalar);
+}
+
+#undef FOR_EACH_ITEM__
+
+KERNEL__ une_int sum_ints(const une_int *items, size_t length)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < length; i++)
+        sum += (uint64_t)items[i];
+    return (une_int)sum;
+}
+
+KERNEL__ une_flt sum_flts(const une_flt *items, size_t length)
+{
+    une_flt partial[LANES] = {0};
+    size_t i = 0;
+    for (; i + LANES <= length; i += LANES)
+        for (size_t lane = 0; lane < LANES; lane++)
+            partial[lane] += items[i + lane];
+    une_flt sum = 0.0;
+    for (size_t lane = 0; lane < LANES; lane++)
+        sum += partial[lane];
+    for (; i < length; i++)
+        sum += items[i];
+    return sum;
+}
+
+KERNEL__ une_int dot_ints(const une_int *left, const une_int *right, size_t length)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < length; i++)
+        sum += (uint64_t)left[i] * (uint64_t)right[i];
+    return (une_int)sum;
+}
+
+KERNEL__ une_flt dot_flts(const une_flt *left, const une_flt *right, size_t length)
+{
+    une_flt partial[LANES] = {0};
+    size_t i = 0;
+    for (; i + LANES <= length; i += LANES)
+        for (size_t lane = 0; lane < LANES; lane++)
+            partial[lane] += left[i + lane] * right[i + lane];
+    une_flt sum = 0.0;
+    for (size_t lane = 0; lane < LANES; lane++)
+        sum += partial[lane];
+    for (; i < length; i++)
+        sum += left[i] * right[i];
+    return sum;
+}
+
+KERNEL__ une_int extreme_ints(const une_int *items, size_t length, bool greatest)
+{
+    assert(length > 0);
+    une_int extreme = items[0];
+    if (greatest) {
+        for (size_t i = 1; i < length; i++)
+            extreme = items[i] > extreme ? items[i] : extreme;
+    } else {
+        for (size_t i = 1; i < length; i++)
+            extreme = items[i] < extreme ? items[i] : extreme;
+    }
+    return extreme;
+}
+
+KERNEL__ une_flt extreme_flts(const une_flt *items, size_t length, bool greatest)
+{
+    assert(length > 0);
+    une_flt partial[LANES];
+    for (size_t lane = 0; lane < LANES; lane++)
+        partial[lane] = items[0];
+    size_t i = 0;
+    if (greatest) {
+        for (; i + LANES <= length; i += LANES)
+            for (size_t lane = 0; lane < LANES; lane++)
+                partial[lane] = items[i + lane] > partial[lane] ? items[i + lane] : partial[lane];
+    } else {
+        for (; i + LANES <= length; i += LANES)
+            for (size_t lane = 0; lane < LANES; lane++)
+                partial[lane] = items[i + lane] < partial[lane] ? items[i + lane] : partial[lane];
+    }
+    une_flt extreme = partial[0];
+    for (size_t lane = 1; lane < LANES; lane++)
+        if (greatest ? partial[lane] > extreme : partial[lane] < extreme)
+            extreme = partial[lane];
+    for (; i < length; i++)
+        if (greatest ? items[i] > extreme : items[i] < extreme)
+            extreme = items[i];
+    return extreme;
+}
+
+/*
+Check if every item of left equals the item of right at the same position, like
+une_flts_equal, whose distance is below the smallest FLT only if it is 0.
+*/
+KERNEL__ bool equal_flts(const une_flt *left, const une_flt *right, size_t length)
+{
+    size_t i = 0;
+    for (; i + LANES * 4 <= length; i += LANES * 4) {
+        bool different = false;
+        for (size_t j = i; j < i + LANES * 4; j++)
+            different |= !(left[j] - right[j] == 0.0);
+        if (different)
+            return false;
+    }
+    for (; i < length; i++)
+        if (!(left[i] - right[i] == 0.0))
+            return false;
+    return true;
+}
+
+/*
+The kernels compiled for one instruction set.
+*/
+typedef struct kernels_
+{
+    void (*operate_ints)(
+        operation, une_int *, const une_int *, const une_int *, une_int, size_t);
+    void (*operate_flts)(
+        operation, une_flt *, const une_flt *, const une_flt *, une_flt, size_t);
+    une_int (*sum_ints)(const une_int *, size_t);
+    une_flt (*sum_flts)(const une_flt *, size_t);
+    une_int (*dot_ints)(const une_int *, const une_int *, size_t);
+    une_flt (*dot_flts)(const une_flt *, const une_flt *, size_t);
+    une_int (*extreme_ints)(const une_int *, size_t, bool);
+    une_flt (*extreme_flts)(const une_flt *, size_t, bool);
+    bool (*equal_flts)(const une_flt *, const une_flt *, size_t);
+} kernels;
+
+#define KERNELS__(suffix__, target__)                                                              \
+    target__ static void operate_ints_##suffix__(operation op,                                     \
+                                                 une_int *out,                                     \
+                                                 const une_int *left,                              \
+                                                 const une_int *right,                             \
+                                                 une_int scalar,                                   \
+                                                 size_t length)                                    \
+    {                                                                                              \
+        operate_ints(op, out, left, right, scalar, length);                                        \
+    }                                                                                              \
+    target__ static void operate_flts_##suffix__(operation op,                                     \
+                                                 une_flt *out,                                     \
+                                                 const une_flt *left,                              \
+                                                 const une_flt *right,                             \
+                                                 une_flt scalar,                                   \
+                                                 size_t length)                                    \
+    {                                                                                              \
+        operate_flts(op, out, left, right, scalar, length);                                        \
+    }                                                                                              \
+    target__ static une_int sum_ints_##suffix__(const une_int *items, size_t length)               \
+    {                                                                                              \
+        return sum_ints(items, length);                                                            \
+    }                                                                                              \
+    target__ static une_flt sum_flts_##suffix__(const une_flt *items, size_t length)               \
+    {                                                                                              \
+        return sum_flts(items, length);                                                            \
+    }                                                                                              \
+    target__ static une_int dot_ints_##suffix__(                                                   \
+        const une_int *left, const une_int *right, size_t length)                                  \
+    {                                                                                              \
+        return dot_ints(left, right, length);                                                      \
+    }                                                                                              \
+    target__ static une_flt dot_flts_##suffix__(                                                   \
+        const une_flt *left, const une_flt *right, size_t length)                                  \
+    {                                                                                              \
+        return dot_flts(left, right, length);                                                      \
+    }                                                                                              \
+    target__ static une_int extreme_ints_##suffix__(                                               \
+        const une_int *items, size_t length, bool greatest)                                        \
+    {                                                                                              \
+        return extreme_ints(items, length, greatest);                                              \
+    }                                                                                              \
+    target__ static une_flt extreme_flts_##suffix__(                                               \
+        const une_flt *items, size_t length, bool greatest)                                        \
+    {                                                                                              \
+        return extreme_flts(items, length, greatest);                                              \
+    }                                                                                              \
+    target__ static bool equal_flts_##suffix__(                                                    \
+        const une_flt *left, const une_flt *right, size_t length)                                  \
+    {                                                                                              \
+        return equal_flts(left, right, length);                                                    \
+    }                                                                                              \
+    static const kernels kernels_##suffix__ = {                                                    \
+        .operate_ints = &operate_ints_##suffix__,                                                  \
+        .operate_flts = &operate_flts_##suffix__,                                                  \
+        .sum_ints = &sum_ints_##suffix__,                                                          \
+        .sum_flts = &sum_flts_##suffix__,                                                          \
+        .dot_ints = &dot_ints_##suffix__,                                                          \
+        .dot_flts = &dot_flts_##suffix__,                                                          \
+        .extreme_ints = &extreme_ints_##suffix__,                                                  \
+        .extreme_flts = &extreme_flts_##suffix__,                                                  \
+        .equal_flts = &equal_flts_##suffix__,                                                      \
+    };
+
+KERNELS__(baseline, )
+#ifdef UNE_ARRAY_KERNELS_AVX2
+KERNELS__(avx2, __attribute__((target("avx2"))))
+#endif /* UNE_ARRAY_KERNELS_AVX2 */
+
+#undef KERNELS__
+
+/*
+The fastest kernels the processor supports, chosen on first use.
+*/
+static const kernels *chosen_kernels = NULL;
+
+static const kernels *get_kernels(void)
+{
+    if (chosen_kernels)
+        return chosen_kernels;
+    chosen_kernels = &kernels_baseline;
+#ifdef UNE_ARRAY_KERNELS_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        chosen_kernels = &kernels_avx2;
+#endif
+    return chosen_kernels;
+}
+
+/*
+Get the array a result holds or refers to.
+*/
+static une_array *result_as_array(une_result subject)
+{
+    if (subject.kind == UNE_RK_REFERENCE) {
+        assert(subject.reference_kind == UNE_FK_SINGLE);
+        subject = *(une_result *)subject.reference_root;
+    }
+    assert(subject.kind == UNE_RK_ARRAY);
+    return UNE_ARRAY(subject);
+}
+
+/*
+Check if a result can be an operand of an element-wise operation with an array.
+*/
+static bool is_number(une_result result)
+{
+    return result.kind == UNE_RK_INT || result.kind == UNE_RK_FLT;
+}
+
+/*
+Check if an operand of an element-wise operation is or holds FLTs.
+*/
+static bool is_flt_operand(une_result operand)
+{
+    if (operand.kind == UNE_RK_ARRAY)
+        return UNE_ARRAY(operand)->is_flt;
+    return operand.kind == UNE_RK_FLT;
+}
+
+/*
+Check if an operand of an element-wise operation is or holds zero.
+*/
+static bool is_zero_operand(une_result operand)
+{
+    if (operand.kind == UNE_RK_INT)
+        return operand.value._int == 0;
+    if (operand.kind == UNE_RK_FLT)
+        return operand.value._flt == 0.0;
+    une_array *array = UNE_ARRAY(operand);
+    for (size_t i = 0; i < array->length; i++)
+        if (array->is_flt ? UNE_ARRAY_FLTS(array)[i] == 0.0 : UNE_ARRAY_INTS(array)[i] == 0)
+            return true;
+    return false;
+}
+
+/*
+Write an operand of an element-wise operation into items as FLTs, repeating it if it is a number.
+*/
+static void write_as_flts(une_result operand, une_flt *items, size_t length)
+{
+    if (operand.kind == UNE_RK_ARRAY) {
+        une_array *array = UNE_ARRAY(operand);
+        assert(array->length == length);
+        if (array->is_flt) {
+            memmove(items, UNE_ARRAY_FLTS(array), length * sizeof(*items));
+            return;
+        }
+        for (size_t i = 0; i < length; i++)
+            items[i] = (une_flt)UNE_ARRAY_INTS(array)[i];
+        return;
+    }
+    une_flt value = operand.kind == UNE_RK_INT ? (une_flt)operand.value._int : operand.value._flt;
+    for (size_t i = 0; i < length; i++)
+        items[i] = value;
+}
+
+/*
+Apply an operation to left and right, at least one of which is an array, writing the outcome into
+out. out may be left.
+*/
+static void operate_into(une_array *out, operation op, une_result left, une_result right)
+{
+    const kernels *kernels = get_kernels();
+    size_t length = out->length;
+
+    /* INTs. */
+    if (!out->is_flt) {
+        une_int *items = UNE_ARRAY_INTS(out);
+        const une_int *left_items = items;
+        if (left.kind == UNE_RK_ARRAY)
+            left_items = UNE_ARRAY_INTS(UNE_ARRAY(left));
+        else
+            for (size_t i = 0; i < length; i++)
+                items[i] = left.value._int;
+        if (right.kind == UNE_RK_ARRAY)
+            kernels->operate_ints(
+                op, items, left_items, UNE_ARRAY_INTS(UNE_ARRAY(right)), 0, length);
+        else
+            kernels->operate_ints(op, items, left_items, NULL, right.value._int, length);
+        return;
+    }
+
+    /* FLTs. Operands holding INTs are converted first. */
+    une_flt *items = UNE_ARRAY_FLTS(out);
+    const une_flt *left_items = items;
+    if (left.kind == UNE_RK_ARRAY && UNE_ARRAY(left)->is_flt)
+        left_items = UNE_ARRAY_FLTS(UNE_ARRAY(left));
+    else
+        write_as_flts(left, items, length);
+    if (right.kind != UNE_RK_ARRAY) {
+        une_flt scalar = right.kind == UNE_RK_INT ? (une_flt)right.value._int : right.value._flt;
+        kernels->operate_flts(op, items, left_items, NULL, scalar, length);
+    } else if (UNE_ARRAY(right)->is_flt) {
+        kernels->operate_flts(op, items, left_items, UNE_ARRAY_FLTS(UNE_ARRAY(right)), 0.0, length);
+    } else {
+        une_array *converted = une_type_array_create(length, true);
+        write_as_flts(right, UNE_ARRAY_FLTS(converted), length);
+        kernels->operate_flts(op, items, left_items, UNE_ARRAY_FLTS(converted), 0.0, length);
+        free(converted);
+    }
+}
+
+/*
+Apply an operation to left and right, at least one of which is an array. The outcome holds FLTs if
+either operand does, or if it is a division.
+*/
+static une_result operate(operation op, une_result left, une_result right)
+{
+    assert(left.kind == UNE_RK_ARRAY || right.kind == UNE_RK_ARRAY);
+    if ((left.kind != UNE_RK_ARRAY && !is_number(left)) ||
+        (right.kind != UNE_RK_ARRAY && !is_number(right)))
+        return une_result_create(UNE_RK_ERROR);
+    size_t length = left.kind == UNE_RK_ARRAY ? UNE_ARRAY(left)->length : UNE_ARRAY(right)->length;
+    if (right.kind == UNE_RK_ARRAY && UNE_ARRAY(right)->length != length)
+        return une_result_create(UNE_RK_ERROR);
+
+    /* Like scalar division, return INFINITY on zero division. */
+    if (op == OPERATION_DIV && is_zero_operand(right))
+        return (une_result){.kind = UNE_RK_FLT, .value._flt = UNE_INFINITY};
+
+    bool is_flt = op == OPERATION_DIV || is_flt_operand(left) || is_flt_operand(right);
+    une_array *out = une_type_array_create(length, is_flt);
+    operate_into(out, op, left, right);
+    return (une_result){.kind = UNE_RK_ARRAY, .value._vp = out};
+}
+
+/*
+*** Interface.
+*/
+
+/*
+Allocate an array of a given length holding FLTs if is_flt is true, or INTs otherwise. The caller
+fills it.
+*/
+une_array *une_type_array_create(size_t length, bool is_flt)
+{
+    assert(sizeof(une_int) == sizeof(une_flt));
+    une_array *array = malloc(sizeof(*array) + length * sizeof(une_int));
+    verify(array);
+    array->references = 1;
+    array->length = length;
+    array->is_flt = is_flt;
+    return array;
+}
+
+/*
+Pack a list of INTs and FLTs into an array. The array holds FLTs if any item is one. Return an
+ERROR result if an item is neither.
+*/
+une_result une_type_array_from_list(une_result list)
+{
+    assert(list.kind == UNE_RK_LIST);
+    UNE_UNPACK_RESULT_LIST(list, items, count);
+    bool is_flt = false;
+    UNE_FOR_RESULT_LIST_ITEM(i, count)
+    {
+        if (!is_number(items[i]))
+            return une_result_create(UNE_RK_ERROR);
+        is_flt = is_flt || items[i].kind == UNE_RK_FLT;
+    }
+    une_array *array = une_type_array_create(count, is_flt);
+    UNE_FOR_RESULT_LIST_ITEM(i, count)
+    {
+        if (!is_flt)
+            UNE_ARRAY_INTS(array)[i - 1] = items[i].value._int;
+        else if (items[i].kind == UNE_RK_INT)
+            UNE_ARRAY_FLTS(array)[i - 1] = (une_flt)items[i].value._int;
+        else
+            UNE_ARRAY_FLTS(array)[i - 1] = items[i].value._flt;
+    }
+    return (une_result){.kind = UNE_RK_ARRAY, .value._vp = array};
+}
+
+/*
+Unpack an array into a list.
+*/
+une_result une_type_array_to_list(une_result result)
+{
+    une_array *array = result_as_array(result);
+    une_result *list = une_result_list_create(array->length);
+    for (size_t i = 0; i < array->length; i++) {
+        if (array->is_flt)
+            list[i + 1] = (une_result){.kind = UNE_RK_FLT, .value._flt = UNE_ARRAY_FLTS(array)[i]};
+        else
+            list[i + 1] = (une_result){.kind = UNE_RK_INT, .value._int = UNE_ARRAY_INTS(array)[i]};
+    }
+    return (une_result){.kind = UNE_RK_LIST, .value._vp = (void *)list};
+}
+
+/*
+Add up the items of an array. INTs wrap around on overflow.
+*/
+une_result une_type_array_sum(une_result result)
+{
+    une_array *array = result_as_array(result);
+    const kernels *kernels = get_kernels();
+    if (array->is_flt)
+        return (une_result){.kind = UNE_RK_FLT,
+                            .value._flt = kernels->sum_flts(UNE_ARRAY_FLTS(array), array->length)};
+    return (une_result){.kind = UNE_RK_INT,
+                        .value._int = kernels->sum_ints(UNE_ARRAY_INTS(array), array->length)};
+}
+
+/*
+Get the greatest or least item of an array that is not empty.
+*/
+une_result une_type_array_extreme(une_result result, bool greatest)
+{
+    une_array *array = result_as_array(result);
+    assert(array->length > 0);
+    if (array->is_flt)
+        return (une_result){.kind = UNE_RK_FLT,
+                            .value._flt = get_kernels()->extreme_flts(
+                                UNE_ARRAY_FLTS(array), array->length, greatest)};
+    return (une_result){
+        .kind = UNE_RK_INT,
+        .value._int = get_kernels()->extreme_ints(UNE_ARRAY_INTS(array), array->length, greatest)};
+}
+
+/*
+Get the dot product of two arrays of the same length. It is a FLT if either holds FLTs.
+*/
+une_result une_type_array_dot(une_result left, une_result right)
+{
+    une_array *left_array = result_as_array(left);
+    une_array *right_array = result_as_array(right);
+    size_t length = left_array->length;
+    assert(right_array->length == length);
+    const kernels *kernels = get_kernels();
+
+    if (!left_array->is_flt && !right_array->is_flt)
+        return (une_result){
+            .kind = UNE_RK_INT,
+            .value._int =
+                kernels->dot_ints(UNE_ARRAY_INTS(left_array), UNE_ARRAY_INTS(right_array), length)};
+
+    /* Convert an array holding INTs first. */
+    une_array *converted = NULL;
+    if (!left_array->is_flt || !right_array->is_flt) {
+        converted = une_type_array_create(length, true);
+        une_result other = left_array->is_flt ? right : left;
+        write_as_flts(
+            (une_result){.kind = UNE_RK_ARRAY, .value._vp = result_as_array(other)},
+            UNE_ARRAY_FLTS(converted),
+            length);
+    }
+    une_flt dot = kernels->dot_flts(
+        left_array->is_flt ? UNE_ARRAY_FLTS(left_array) : UNE_ARRAY_FLTS(converted),
+        right_array->is_flt ? UNE_ARRAY_FLTS(right_array) : UNE_ARRAY_FLTS(converted),
+        length);
+    free(converted);
+    return (une_result){.kind = UNE_RK_FLT, .value._flt = dot};
+}
+
+/*
+Print a text representation to file.
+*/
+void une_type_array_represent(FILE *file, une_result result)
+{
+    assert(result.kind == UNE_RK_ARRAY);
+    une_array *array = UNE_ARRAY(result);
+    fputws(L"array([", file);
+    for (size_t i = 0; i < array->length; i++) {
+        if (i > 0)
+            fputws(L", ", file);
+        if (array->is_flt)
+            une_type_flt_represent(
+                file, (une_result){.kind = UNE_RK_FLT, .value._flt = UNE_ARRAY_FLTS(array)[i]});
+        else
+            une_type_int_represent(
+                file, (une_result){.kind = UNE_RK_INT, .value._int = UNE_ARRAY_INTS(array)[i]});
+    }
+    fputws(L"])", file);
+}
+
+/*
+Check for truth.
+*/
+une_int une_type_array_is_true(une_result result)
+{
+    assert(result.kind == UNE_RK_ARRAY);
+    return UNE_ARRAY(result)->length == 0 ? 0 : 1;
+}
+
+/*
+Check if subject is equal to comparison.
+*/
+une_int une_type_array_is_equal(une_result subject, une_result comparison)
+{
+    assert(subject.kind == UNE_RK_ARRAY);
+    if (comparison.kind != UNE_RK_ARRAY)
+        return 0;
+    une_array *subject_array = UNE_ARRAY(subject);
+    une_array *comparison_array = UNE_ARRAY(comparison);
+    size_t length = subject_array->length;
+    if (comparison_array->length != length)
+        return 0;
+    if (!subject_array->is_flt && !comparison_array->is_flt)
+        return memcmp(UNE_ARRAY_INTS(subject_array),
+                      UNE_ARRAY_INTS(comparison_array),
+                      length * sizeof(une_int)) == 0;
+    if (subject_array->is_flt && comparison_array->is_flt)
+        return get_kernels()->equal_flts(
+            UNE_ARRAY_FLTS(subject_array), UNE_ARRAY_FLTS(comparison_array), length);
+    une_array *ints = subject_array->is_flt ? comparison_array : subject_array;
+    une_array *flts = subject_array->is_flt ? subject_array : comparison_array;
+    for (size_t i = 0; i < length; i++)
+        if (!une_flts_equal((une_flt)UNE_ARRAY_INTS(ints)[i], UNE_ARRAY_FLTS(flts)[i]))
+            return 0;
+    return 1;
+}
+
+/*
+Check if subject is greater than comparison.
+*/
+une_int une_type_array_is_greater(une_result subject, une_result comparison)
+{
+    assert(subject.kind == UNE_RK_ARRAY);
+    if (comparison.kind == UNE_RK_ARRAY)
+        return UNE_ARRAY(subject)->length > UNE_ARRAY(comparison)->length;
+    return -1;
+}
+
+/*
+Check if subject is greater than or equal to comparison.
+*/
+une_int une_type_array_is_greater_or_equal(une_result subject, une_result comparison)
+{
+    assert(subject.kind == UNE_RK_ARRAY);
+    if (comparison.kind == UNE_RK_ARRAY)
+        return UNE_ARRAY(subject)->length >= UNE_ARRAY(comparison)->length;
+    return -1;
+}
+
+/*
+Check is subject is less than comparison.
+*/
+une_int une_type_array_is_less(une_result subject, une_result comparison)
+{
+    assert(subject.kind == UNE_RK_ARRAY);
+    if (comparison.kind == UNE_RK_ARRAY)
+        return UNE_ARRAY(subject)->length < UNE_ARRAY(comparison)->length;
+    return -1;
+}
+
+/*
+Check if subject is less than or equal to comparison.
+*/
+une_int une_type_array_is_less_or_equal(une_result subject, une_result comparison)
+{
+    assert(subject.kind == UNE_RK_ARRAY);
+    if (comparison.kind == UNE_RK_ARRAY)
+        return UNE_ARRAY(subject)->length <= UNE_ARRAY(comparison)->length;
+    return -1;
+}
+
+/*
+Add right to left item by item. Either may be a number, which is added to every item.
+*/
+une_result une_type_array_add(une_result left, une_result right)
+{
+    return operate(OPERATION_ADD, left, right);
+}
+
+/*
+Subtract right from left item by item. Either may be a number.
+*/
+une_result une_type_array_sub(une_result left, une_result right)
+{
+    return operate(OPERATION_SUB, left, right);
+}
+
+/*
+Multiply left by right item by item. Either may be a number.
+*/
+une_result une_type_array_mul(une_result left, une_result right)
+{
+    return operate(OPERATION_MUL, left, right);
+}
+
+/*
+Divide left by right item by item. Either may be a number. The outcome always holds FLTs. Returns
+INFINITY if right is or holds zero.
+*/
+une_result une_type_array_div(une_result left, une_result right)
+{
+    return operate(OPERATION_DIV, left, right);
+}
+
+/*
+Negate the result.
+*/
+une_result une_type_array_negate(une_result result)
+{
+    assert(result.kind == UNE_RK_ARRAY);
+    if (UNE_ARRAY(result)->is_flt)
+        return operate(OPERATION_MUL, result, (une_result){.kind = UNE_RK_FLT, .value._flt = -1.0});
+    return operate(OPERATION_SUB, (une_result){.kind = UNE_RK_INT, .value._int = 0}, result);
+}
+
+/*
+Add right to left where left is stored, item by item, if the outcome can be stored there. Return
+false otherwise.
+*/
+bool une_type_array_add_in_place(une_result *left, une_result right)
+{
+    assert(left->kind == UNE_RK_ARRAY);
+    if (right.kind != UNE_RK_ARRAY && !is_number(right))
+        return false;
+    if (right.kind == UNE_RK_ARRAY && UNE_ARRAY(right)->length != UNE_ARRAY(*left)->length)
+        return false;
+    if (!UNE_ARRAY(*left)->is_flt && is_flt_operand(right))
+        return false;
+    une_type_array_unshare(left);
+    operate_into(UNE_ARRAY(*left), OPERATION_ADD, *left, right);
+    return true;
+}
+
+/*
+Get the length.
+*/
+size_t une_type_array_get_len(une_result result)
+{
+    return result_as_array(result)->length;
+}
+
+/*
+Check if an index is valid.
+*/
+bool une_type_array_is_valid_index(une_result subject, une_result index)
+{
+    if (index.kind != UNE_RK_INT)
+        return false;
+    return une_range_from_relative_index(index, result_as_array(subject)->length).valid;
+}
+
+/*
+Refer to an item.
+*/
+une_result une_type_array_refer_to_index(une_result subject, une_result index)
+{
+    une_array *array = result_as_array(subject);
+    une_range range = une_range_from_relative_index(index, array->length);
+    return (une_result){.kind = UNE_RK_REFERENCE,
+                        .reference_kind = array->is_flt ? UNE_FK_FLT_ITEM : UNE_FK_INT_ITEM,
+                        .reference_root = UNE_ARRAY_INTS(array) + range.first};
+}
+
+/*
+Get an item.
+*/
+une_result une_type_array_get_index(une_result subject, une_result index)
+{
+    une_array *array = result_as_array(subject);
+    une_range range = une_range_from_relative_index(index, array->length);
+    if (array->is_flt)
+        return (une_result){.kind = UNE_RK_FLT, .value._flt = UNE_ARRAY_FLTS(array)[range.first]};
+    return (une_result){.kind = UNE_RK_INT, .value._int = UNE_ARRAY_INTS(array)[range.first]};
+}
+
+/*
+Check if a range is valid.
+*/
+bool une_type_array_is_valid_range(une_result subject, une_result begin, une_result end)
+{
+    if (begin.kind != UNE_RK_INT)
+        return false;
+    if (end.kind != UNE_RK_INT && end.kind != UNE_RK_VOID)
+        return false;
+    return true;
+}
+
+/*
+Get a range of items as a new array.
+*/
+une_result une_type_array_get_range(une_result subject, une_result begin, une_result end)
+{
+    une_array *array = result_as_array(subject);
+    une_range range = une_range_from_relative_indices(begin, end, array->length);
+    une_array *slice = une_type_array_create(range.length, array->is_flt);
+    memcpy(UNE_ARRAY_INTS(slice),
+           UNE_ARRAY_INTS(array) + range.first,
+           range.length * sizeof(une_int));
+    return (une_result){.kind = UNE_RK_ARRAY, .value._vp = slice};
+}
+
+/*
+Check if a value can be assigned to a reference. Items holding INTs can only be assigned INTs.
+*/
+bool une_type_array_can_assign(une_reference subject, une_result value)
+{
+    if (subject.kind == UNE_FK_SINGLE) {
+        assert(UNE_RESULT_KIND_IS_TYPE(value.kind));
+        return true;
+    }
+    assert(subject.kind == UNE_FK_INT_ITEM || subject.kind == UNE_FK_FLT_ITEM);
+    if (subject.kind == UNE_FK_INT_ITEM)
+        return value.kind == UNE_RK_INT;
+    return is_number(value);
+}
+
+/*
+Assign a value to a reference.
+*/
+void une_type_array_assign(une_reference subject, une_result value)
+{
+    if (subject.kind == UNE_FK_SINGLE) {
+        une_result *root = (une_result *)subject.root;
+        une_result_free(*root); /* Free the old value. */
+        *root = une_result_copy(value);
+        return;
+    }
+    if (subject.kind == UNE_FK_INT_ITEM) {
+        assert(value.kind == UNE_RK_INT);
+        *(une_int *)subject.root = value.value._int;
+        return;
+    }
+    assert(subject.kind == UNE_FK_FLT_ITEM);
+    *(une_flt *)subject.root =
+        value.kind == UNE_RK_INT ? (une_flt)value.value._int : value.value._flt;
+}
+
+/*
+Create a duplicate.
+*/
+une_result une_type_array_copy(une_result original)
+{
+    assert(original.kind == UNE_RK_ARRAY);
+    UNE_ARRAY(original)->references++;
+    return original;
+}
+
+/*
+Give the result its own copy of shared storage.
+*/
+void une_type_array_unshare(une_result *result)
+{
+    assert(result->kind == UNE_RK_ARRAY);
+    une_array *array = UNE_ARRAY(*result);
+    if (array->references == 1)
+        return;
+    array->references--;
+    une_array *copy = une_type_array_create(array->length, array->is_flt);
+    memcpy(UNE_ARRAY_INTS(copy), UNE_ARRAY_INTS(array), array->length * sizeof(une_int));
+    result->value._vp = copy;
+}
+
+/*
+Free all members.
+*/
+void une_type_array_free_members(une_result result)
+{
+    assert(result.kind == UNE_RK_ARRAY);
+    une_array *array = UNE_ARRAY(result);
+    if (--array->references > 0)
+        return;
+    free(array);
+}
@@ -0,0 +1,49 @@
+/*
+array.h - Une
+*/
+
+#ifndef UNE_TYPES_ARRAY_H
+#define UNE_TYPES_ARRAY_H
+
+/* Header-specific includes. */
+#include "../common.h"
+#include "../struct/result.h"
+
+une_array *une_type_array_create(size_t length, bool is_flt);
+une_result une_type_array_from_list(une_result list);
+une_result une_type_array_to_list(une_result result);
+une_result une_type_array_sum(une_result result);
+une_result une_type_array_extreme(une_result result, bool greatest);
+une_result une_type_array_dot(une_result left, une_result right);
+
+void une_type_array_represent(FILE *file, une_result result);
+
+une_int une_type_array_is_true(une_result result);
+une_int une_type_array_is_equal(une_result subject, une_result comparison);
+une_int une_type_array_is_greater(une_result subject, une_result comparison);
+une_int une_type_array_is_greater_or_equal(une_result subject, une_result comparison);
+une_int une_type_array_is_less(une_result subject, une_result comparison);
+une_int une_type_array_is_less_or_equal(une_result subject, une_result comparison);
+
+une_result une_type_array_add(une_result left, une_result right);
+une_result une_type_array_sub(une_result left, une_result right);
+une_result une_type_array_mul(une_result left, une_result right);
+une_result une_type_array_div(une_result left, une_result right);
+une_result une_type_array_negate(une_result result);
+bool une_type_array_add_in_place(une_result *left, une_result right);
+
+size_t une_type_array_get_len(une_result result);
+
+bool une_type_array_is_valid_index(une_result subject, une_result index);
+une_result une_type_array_refer_to_index(une_result subject, une_result index);
+une_result une_type_array_get_index(une_result subject, une_result index);
+bool une_type_array_is_valid_range(une_result subject, une_result begin, une_result end);
+une_result une_type_array_get_range(une_result subject, une_result begin, une_result end);
+bool une_type_array_can_assign(une_reference subject, une_result value);
+void une_type_array_assign(une_reference subject, une_result value);
+
+une_result une_type_array_copy(une_result result);
+void une_type_array_unshare(une_result *result);
+void une_type_array_free_members(une_result result);
+
+#endif /* UNE_TYPES_ARRAY_H */
@@ -7,6 +7,8 @@ flt.c - Une
 
 /* Implementation-specific includes. */
 #include "../tools.h"
+#include "array.h"
+#include "str.h"
 #include <math.h>
 
 /*
@@ -33,7 +35,9 @@ Convert to STR.
 une_result une_type_flt_as_str(une_result result)
 {
     assert(result.kind == UNE_RK_FLT);
-    return (une_result){.kind = UNE_RK_STR, .value._wcs = une_flt_to_wcs(result.value._flt)};
+    wchar_t out[UNE_SIZE_NUMBER_AS_STRING];
+    size_t length = une_flt_to_wcs_buffer(result.value._flt, out);
+    return une_type_str_from_wcs_with_length(out, length);
 }
 
 /*
@@ -42,9 +46,9 @@ Print a text representation to file.
 void une_type_flt_represent(FILE *file, une_result result)
 {
     assert(result.kind == UNE_RK_FLT);
-    wchar_t *flt_as_wcs = une_flt_to_wcs(result.value._flt);
-    fwprintf(file, L"%ls", flt_as_wcs);
-    free(flt_as_wcs);
+    wchar_t out[UNE_SIZE_NUMBER_AS_STRING];
+    une_flt_to_wcs_buffer(result.value._flt, out);
+    fputws(out, file);
 }
 
 /*
@@ -132,6 +136,8 @@ une_result une_type_flt_add(une_result left, une_result right)
                             .value._flt = left.value._flt + (une_flt)right.value._int};
     if (right.kind == UNE_RK_FLT)
         return (une_result){.kind = UNE_RK_FLT, .value._flt = left.value._flt + right.value._flt};
+    if (right.kind == UNE_RK_ARRAY)
+        return une_type_array_add(left, right);
     return une_result_create(UNE_RK_ERROR);
 }
 
@@ -146,6 +152,8 @@ une_result une_type_flt_sub(une_result left, une_result right)
                             .value._flt = left.value._flt - (une_flt)right.value._int};
     if (right.kind == UNE_RK_FLT)
         return (une_result){.kind = UNE_RK_FLT, .value._flt = left.value._flt - right.value._flt};
+    if (right.kind == UNE_RK_ARRAY)
+        return une_type_array_sub(left, right);
     return une_result_create(UNE_RK_ERROR);
 }
 
@@ -160,6 +168,8 @@ une_result une_type_flt_mul(une_result left, une_result right)
                             .value._flt = left.value._flt * (une_flt)right.value._int};
     if (right.kind == UNE_RK_FLT)
         return (une_result){.kind = UNE_RK_FLT, .value._flt = left.value._flt * right.value._flt};
+    if (right.kind == UNE_RK_ARRAY)
+        return une_type_array_mul(left, right);
     return une_result_create(UNE_RK_ERROR);
 }
 
@@ -177,6 +187,8 @@ une_result une_type_flt_div(une_result left, une_result right)
     if (right.kind == UNE_RK_FLT) {
         return (une_result){.kind = UNE_RK_FLT, .value._flt = left.value._flt / right.value._flt};
     }
+    if (right.kind == UNE_RK_ARRAY)
+        return une_type_array_div(left, right);
     return une_result_create(UNE_RK_ERROR);
 }
 
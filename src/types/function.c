@@ -44,7 +44,7 @@ une_int une_type_function_is_equal(une_result subject, une_result comparison)
 Call result.
 */
 une_result
-une_type_function_call(une_node *call, une_result function, une_result args, wchar_t *label)
+une_type_function_call(une_node *call, une_result function, une_result args, une_symbol label)
 {
     /* Get function. */
     assert(function.kind == UNE_RK_FUNCTION);
@@ -52,27 +52,111 @@ une_type_function_call(une_node *call, une_result function, une_result args, wch
         une_callables_get_callable_by_id(felix->is.callables, function.value._id);
     assert(callable);
 
+    /* Every call made here nests on the C stack, which is smaller than the heap. */
+    char marker;
+    if ((uintptr_t)&marker < felix->stack_limit) {
+        felix->error = UNE_ERROR_SET(UNE_EK_RECURSION, call->pos);
+        return une_result_create(UNE_RK_ERROR);
+    }
+
+    une_context *parent = une_type_function_enter(call, callable, args, label);
+    if (!parent)
+        return une_result_create(UNE_RK_ERROR);
+
+    /* Evaluate body. */
+    une_result result = une_engine_evaluate_callable(callable);
+
+    return une_type_function_leave(parent, result);
+}
+
+/*
+Check the arguments of a call, push the function context and define the parameters. Return the
+context of the caller, or NULL if an error occurred.
+*/
+une_context *une_type_function_enter(une_node *call,
+                                     une_callable *callable,
+                                     une_result args,
+                                     une_symbol label)
+{
     /* Ensure number of arguments matches number of required parameters. */
     UNE_UNPACK_RESULT_LIST(args, args_p, args_count);
     if (callable->parameters.count != args_count) {
         felix->error = UNE_ERROR_SET(UNE_EK_CALLABLE_ARG_COUNT, call->pos);
-        return une_result_create(UNE_RK_ERROR);
+        return NULL;
+    }
+
+    /* Ensure the call does not nest too deeply. */
+    if (felix->is.depth >= felix->depth_limit) {
+        felix->error = UNE_ERROR_SET(UNE_EK_RECURSION, call->pos);
+        return NULL;
     }
+    felix->is.depth++;
 
     /* Push function context. */
     une_context *parent = une_engine_push_context(false, call->pos, callable->module_id);
     une_engine_set_context_callable(callable, label);
+    une_context_create_slots(felix->is.context, callable->slots_count);
 
-    /* Define parameters. */
+    /* Define parameters. The resolver assigns them the first slots. */
+    assert(callable->parameters.count <= callable->slots_count);
     for (size_t i = 0; i < callable->parameters.count; i++) {
         une_association *var =
             une_variable_create(felix->is.context, (callable->parameters.names)[i]);
         var->content = une_result_copy(args_p[i + 1]);
+        felix->is.context->slots.buffer[i] = var;
     }
 
-    /* Interpret body. */
-    une_result result = une_interpret(callable->body);
+    return parent;
+}
+
+/*
+Enter a function called in tail position by the function whose caller's context is parent. Since
+the callee may still look up the variables of its caller, they are kept in a single context below
+the callee's, which later calls in tail position merge their variables into.
+*/
+void une_type_function_reenter(une_node *call,
+                               une_callable *callable,
+                               une_result args,
+                               une_symbol label,
+                               une_context *parent)
+{
+    /* Arguments were checked by the caller, and the depth does not change. */
+    une_context *context = felix->is.context;
+    assert(!context->is_transparent);
+    if (context->parent != parent) {
+        assert(context->parent->parent == parent);
+        felix->is.context = une_context_merge_into_parent(&felix->is.contexts, context);
+    }
+    felix->is.depth--;
+    une_context *caller = une_type_function_enter(call, callable, args, label);
+    assert(caller && caller->parent == parent);
+    (void)caller;
+}
+
+/*
+Leave a function entered with une_type_function_enter, returning its result. After an error, the
+function context is kept for the traceback.
+*/
+une_result une_type_function_leave(une_context *parent, une_result result)
+{
     felix->is.should_return = false;
+    assert(felix->is.depth > 0);
+    felix->is.depth--;
+
+    /* A reference to a foreign object is returned as is. Since results share storage across
+    contexts, it may still point into a variable of this call (including those kept by calls in tail
+    position), so it is resolved before they go. */
+    for (une_context *context = felix->is.context;
+         result.kind == UNE_RK_REFERENCE && context != parent;
+         context = context->parent) {
+        for (size_t i = 0; i < context->variables.count; i++) {
+            if (une_result_holds(&context->variables.buffer[i]->content,
+                                 (une_result *)result.reference_root)) {
+                result = une_result_dereference(result);
+                break;
+            }
+        }
+    }
 
     /* Return to parent context. */
     if (result.kind != UNE_RK_ERROR) {
@@ -19,6 +19,16 @@ une_int une_type_function_is_true(une_result result);
 une_int une_type_function_is_equal(une_result subject, une_result comparison);
 
 une_result
-une_type_function_call(une_node *call, une_result function, une_result args, wchar_t *label);
+une_type_function_call(une_node *call, une_result function, une_result args, une_symbol label);
+une_context *une_type_function_enter(une_node *call,
+                                     une_callable *callable,
+                                     une_result args,
+                                     une_symbol label);
+void une_type_function_reenter(une_node *call,
+                               une_callable *callable,
+                               une_result args,
+                               une_symbol label,
+                               une_context *parent);
+une_result une_type_function_leave(une_context *parent, une_result result);
 
 #endif /* UNE_TYPES_FUNCTION_H */
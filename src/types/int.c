@@ -7,6 +7,7 @@ int.c - Une
 
 /* Implementation-specific includes. */
 #include "../tools.h"
+#include "array.h"
 #include "list.h"
 #include "str.h"
 #include <math.h>
@@ -35,10 +36,9 @@ Convert to STR.
 une_result une_type_int_as_str(une_result result)
 {
     assert(result.kind == UNE_RK_INT);
-    wchar_t *out = malloc(UNE_SIZE_NUMBER_AS_STRING * sizeof(*out));
-    verify(out);
-    swprintf(out, UNE_SIZE_NUMBER_AS_STRING, UNE_PRINTF_UNE_INT, result.value._int);
-    return (une_result){.kind = UNE_RK_STR, .value._wcs = out};
+    wchar_t out[UNE_SIZE_NUMBER_AS_STRING];
+    size_t length = une_int_to_wcs_buffer(result.value._int, out);
+    return une_type_str_from_wcs_with_length(out, length);
 }
 
 /*
@@ -47,7 +47,9 @@ Print a text representation to file.
 void une_type_int_represent(FILE *file, une_result result)
 {
     assert(result.kind == UNE_RK_INT);
-    fwprintf(file, UNE_PRINTF_UNE_INT, result.value._int);
+    wchar_t out[UNE_SIZE_NUMBER_AS_STRING];
+    une_int_to_wcs_buffer(result.value._int, out);
+    fputws(out, file);
 }
 
 /*
@@ -135,6 +137,8 @@ une_result une_type_int_add(une_result left, une_result right)
     if (right.kind == UNE_RK_FLT)
         return (une_result){.kind = UNE_RK_FLT,
                             .value._flt = (une_flt)left.value._int + right.value._flt};
+    if (right.kind == UNE_RK_ARRAY)
+        return une_type_array_add(left, right);
     return une_result_create(UNE_RK_ERROR);
 }
 
@@ -149,6 +153,8 @@ une_result une_type_int_sub(une_result left, une_result right)
     if (right.kind == UNE_RK_FLT)
         return (une_result){.kind = UNE_RK_FLT,
                             .value._flt = (une_flt)left.value._int - right.value._flt};
+    if (right.kind == UNE_RK_ARRAY)
+        return une_type_array_sub(left, right);
     return une_result_create(UNE_RK_ERROR);
 }
 
@@ -167,6 +173,8 @@ une_result une_type_int_mul(une_result left, une_result right)
         return une_type_str_mul(right, left);
     if (right.kind == UNE_RK_LIST)
         return une_type_list_mul(right, left);
+    if (right.kind == UNE_RK_ARRAY)
+        return une_type_array_mul(left, right);
     return une_result_create(UNE_RK_ERROR);
 }
 
@@ -190,6 +198,8 @@ une_result une_type_int_div(une_result left, une_result right)
     if (right.kind == UNE_RK_FLT)
         return (une_result){.kind = UNE_RK_FLT,
                             .value._flt = (une_flt)left.value._int / right.value._flt};
+    if (right.kind == UNE_RK_ARRAY)
+        return une_type_array_div(left, right);
     return une_result_create(UNE_RK_ERROR);
 }
 
@@ -7,6 +7,7 @@ list.c - Une
 
 /* Implementation-specific includes. */
 #include "../tools.h"
+#include <string.h>
 
 /*
 *** Helpers.
@@ -16,10 +17,10 @@ static une_reference result_as_listview(une_result subject)
 {
     une_result *container;
     if (subject.kind == UNE_RK_REFERENCE) {
-        if (subject.reference.kind == UNE_FK_LISTVIEW)
-            return subject.reference;
-        assert(subject.reference.kind == UNE_FK_SINGLE);
-        container = (une_result *)subject.reference.root;
+        if (subject.reference_kind == UNE_FK_LISTVIEW)
+            return UNE_RESULT_REFERENCE(subject);
+        assert(subject.reference_kind == UNE_FK_SINGLE);
+        container = (une_result *)subject.reference_root;
     } else {
         assert(subject.kind == UNE_RK_LIST);
         container = &subject;
@@ -164,6 +165,26 @@ une_result une_type_list_add(une_result left, une_result right)
     return (une_result){.kind = UNE_RK_LIST, .value._vp = (void *)new};
 }
 
+/*
+Add right to left where left is stored, taking over its storage if it is not shared. Return false
+if right is not a list.
+*/
+bool une_type_list_add_in_place(une_result *left, une_result right)
+{
+    assert(left->kind == UNE_RK_LIST);
+    if (right.kind != UNE_RK_LIST)
+        return false;
+    UNE_UNPACK_RESULT_LIST(right, right_list, right_size);
+    une_type_list_unshare(left);
+    size_t left_size = une_type_list_get_len(*left);
+    une_type_list_reserve(left, left_size + right_size);
+    une_result *left_list = (une_result *)left->value._vp;
+    UNE_FOR_RESULT_LIST_ITEM(i, right_size)
+    left_list[left_size + i] = une_result_copy(right_list[i]);
+    left_list[0].value._int = (une_int)(left_size + right_size);
+    return true;
+}
+
 /*
 Multiply left by right.
 */
@@ -200,6 +221,56 @@ size_t une_type_list_get_len(une_result result)
     return result_size;
 }
 
+/*
+Make room for at least size items in a list that does not share its storage. The capacity is at
+least doubled, so that adding items one by one takes amortized constant time. This moves the items.
+*/
+void une_type_list_reserve(une_result *result, size_t size)
+{
+    assert(result->kind == UNE_RK_LIST);
+    une_shared *shared = UNE_SHARED(result->value._vp);
+    assert(shared->references == 1);
+    if (size <= shared->capacity)
+        return;
+    size_t capacity = shared->capacity * 2;
+    if (capacity < size)
+        capacity = size;
+    shared = realloc(shared, sizeof(*shared) + (capacity + 1) * sizeof(une_result));
+    verify(shared);
+    shared->capacity = capacity;
+    result->value._vp = (void *)(shared + 1);
+}
+
+/*
+Insert item before the item at position, taking it over.
+*/
+void une_type_list_insert(une_result *result, size_t position, une_result item)
+{
+    une_type_list_unshare(result);
+    size_t size = une_type_list_get_len(*result);
+    assert(position <= size);
+    une_type_list_reserve(result, size + 1);
+    une_result *list = (une_result *)result->value._vp;
+    memmove(list + position + 2, list + position + 1, (size - position) * sizeof(*list));
+    list[position + 1] = item;
+    list[0].value._int = (une_int)(size + 1);
+}
+
+/*
+Remove the item at position and return it.
+*/
+une_result une_type_list_remove(une_result *result, size_t position)
+{
+    une_type_list_unshare(result);
+    size_t size = une_type_list_get_len(*result);
+    assert(position < size);
+    une_result *list = (une_result *)result->value._vp;
+    une_result item = list[position + 1];
+    memmove(list + position + 1, list + position + 2, (size - position - 1) * sizeof(*list));
+    list[0].value._int = (une_int)(size - 1);
+    return item;
+}
+
 /*
 Check if an index is valid.
 */
@@ -220,9 +291,8 @@ une_result une_type_list_refer_to_index(une_result subject, une_result index)
     une_reference listview = result_as_listview(subject);
     une_range range = une_range_from_relative_index(index, listview.width);
     return (une_result){.kind = UNE_RK_REFERENCE,
-                        .reference =
-                            (une_reference){.kind = UNE_FK_SINGLE,
-                                            .root = (une_result *)listview.root + range.first}};
+                        .reference_kind = UNE_FK_SINGLE,
+                        .reference_root = (une_result *)listview.root + range.first};
 }
 
 /*
@@ -238,17 +308,24 @@ bool une_type_list_is_valid_range(une_result subject, une_result begin, une_resu
 }
 
 /*
-Refer to a range of elements.
+Refer to a range of elements. Ranges wider than a une_result can refer to are copied into a list of
+their own instead.
 */
 une_result une_type_list_refer_to_range(une_result subject, une_result begin, une_result end)
 {
     une_reference listview = result_as_listview(subject);
     une_range range = une_range_from_relative_indices(begin, end, listview.width);
+    if (range.length > UNE_REFERENCE_WIDTH_MAX) {
+        une_result *items = (une_result *)listview.root + range.first;
+        une_result *list = une_result_list_create(range.length);
+        UNE_FOR_RESULT_LIST_ITEM(i, range.length)
+        list[i] = une_result_copy(items[i - 1]);
+        return (une_result){.kind = UNE_RK_LIST, .value._vp = (void *)list};
+    }
     return (une_result){.kind = UNE_RK_REFERENCE,
-                        .reference =
-                            (une_reference){.kind = UNE_FK_LISTVIEW,
-                                            .root = (une_result *)listview.root + range.first,
-                                            .width = range.length}};
+                        .reference_kind = UNE_FK_LISTVIEW,
+                        .reference_width = (uint32_t)range.length,
+                        .reference_root = (une_result *)listview.root + range.first};
 }
 
 /*
@@ -295,11 +372,25 @@ Create a duplicate.
 une_result une_type_list_copy(une_result original)
 {
     assert(original.kind == UNE_RK_LIST);
-    UNE_UNPACK_RESULT_LIST(original, original_list, size);
+    UNE_SHARED(original.value._vp)->references++;
+    return original;
+}
+
+/*
+Give the result its own copy of shared storage. The elements are shared with the original.
+*/
+void une_type_list_unshare(une_result *result)
+{
+    assert(result->kind == UNE_RK_LIST);
+    une_shared *shared = UNE_SHARED(result->value._vp);
+    if (shared->references == 1)
+        return;
+    shared->references--;
+    UNE_UNPACK_RESULT_LIST((*result), original_list, size);
     une_result *copy = une_result_list_create(size);
     UNE_FOR_RESULT_LIST_ITEM(i, size)
     copy[i] = une_result_copy(original_list[i]);
-    return (une_result){.kind = UNE_RK_LIST, .value._vp = (void *)copy};
+    result->value._vp = (void *)copy;
 }
 
 /*
@@ -308,8 +399,11 @@ Free all members.
 void une_type_list_free_members(une_result result)
 {
     assert(result.kind == UNE_RK_LIST);
+    une_shared *shared = UNE_SHARED(result.value._vp);
+    if (--shared->references > 0)
+        return;
     UNE_UNPACK_RESULT_LIST(result, list, list_size);
     UNE_FOR_RESULT_LIST_INDEX(i, list_size)
     une_result_free(list[i]);
-    free(list);
+    free(shared);
 }
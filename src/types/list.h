@@ -19,9 +19,13 @@ une_int une_type_list_is_less(une_result subject, une_result comparison);
 une_int une_type_list_is_less_or_equal(une_result subject, une_result comparison);
 
 une_result une_type_list_add(une_result left, une_result right);
+bool une_type_list_add_in_place(une_result *left, une_result right);
 une_result une_type_list_mul(une_result left, une_result right);
 
 size_t une_type_list_get_len(une_result result);
+void une_type_list_reserve(une_result *result, size_t size);
+void une_type_list_insert(une_result *result, size_t position, une_result item);
+une_result une_type_list_remove(une_result *result, size_t position);
 
 bool une_type_list_is_valid_index(une_result subject, une_result index);
 une_result une_type_list_refer_to_index(une_result subject, une_result index);
@@ -31,6 +35,7 @@ bool une_type_list_can_assign(une_reference subject, une_result value);
 void une_type_list_assign(une_reference subject, une_result value);
 
 une_result une_type_list_copy(une_result result);
+void une_type_list_unshare(une_result *result);
 void une_type_list_free_members(une_result result);
 
 #endif /* UNE_TYPES_LIST_H */
@@ -0,0 +1,463 @@
+/*
+map.c - Une
+*/
+
+/* Header-specific includes. */
+#include "map.h"
+
+/* Implementation-specific includes. */
+#include "../tools.h"
+#include "str.h"
+#include <math.h>
+#include <string.h>
+
+/*
+*** Helpers.
+*/
+
+/*
+Capacity of a map when its first entry is added.
+*/
+#define INITIAL_CAPACITY 8
+
+/*
+Get the map a result holds or refers to.
+*/
+static une_map *result_as_map(une_result subject)
+{
+    if (subject.kind == UNE_RK_REFERENCE) {
+        assert(subject.reference_kind == UNE_FK_SINGLE);
+        subject = *(une_result *)subject.reference_root;
+    }
+    assert(subject.kind == UNE_RK_MAP);
+    return UNE_MAP(subject);
+}
+
+/*
+Spread the bits of a number over the whole hash, so that its low bits can be used as a slot.
+*/
+static size_t mix(uint64_t bits)
+{
+    bits ^= bits >> 30;
+    bits *= 0xbf58476d1ce4e5b9ULL;
+    bits ^= bits >> 27;
+    bits *= 0x94d049bb133111ebULL;
+    bits ^= bits >> 31;
+    return (size_t)bits;
+}
+
+/*
+Check if a FLT key holds an INT, in which case it is the same key as that INT.
+*/
+static bool flt_is_int(une_flt flt)
+{
+    return flt == floor(flt) && flt >= -9223372036854775808.0 && flt < 9223372036854775808.0;
+}
+
+/*
+Get the hash of a valid key. Strings cache their hash.
+*/
+static size_t hash_key(une_result key)
+{
+    if (key.kind == UNE_RK_STR)
+        return mix((uint64_t)une_type_str_hash(key));
+    if (key.kind == UNE_RK_FLT && !flt_is_int(key.value._flt)) {
+        uint64_t bits;
+        memcpy(&bits, &key.value._flt, sizeof(bits));
+        return mix(bits);
+    }
+    une_int value = key.kind == UNE_RK_INT ? key.value._int : (une_int)key.value._flt;
+    return mix((uint64_t)value);
+}
+
+/*
+Check if two valid keys are the same key.
+*/
+static bool keys_equal(une_result left, une_result right)
+{
+    if (left.kind == UNE_RK_STR || right.kind == UNE_RK_STR)
+        return left.kind == right.kind && une_type_str_is_equal(left, right);
+    if (left.kind == UNE_RK_INT && right.kind == UNE_RK_INT)
+        return left.value._int == right.value._int;
+    if (left.kind == UNE_RK_FLT && right.kind == UNE_RK_FLT)
+        return left.value._flt == right.value._flt;
+    une_result flt = left.kind == UNE_RK_FLT ? left : right;
+    une_result other = left.kind == UNE_RK_FLT ? right : left;
+    return flt_is_int(flt.value._flt) && (une_int)flt.value._flt == other.value._int;
+}
+
+/*
+Get the slot holding a key, or the empty slot it would be stored in. The map must have a capacity.
+*/
+static size_t find_slot(une_map *map, une_result key, size_t hash)
+{
+    assert(map->capacity > 0);
+    size_t mask = 2 * map->capacity - 1;
+    size_t slot = hash & mask;
+    while (map->slots[slot] != 0) {
+        une_map_entry *entry = &map->entries[map->slots[slot] - 1];
+        if (entry->hash == hash && keys_equal(entry->key, key))
+            break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/*
+Rebuild the slots of a map for a new capacity, which is a power of two.
+*/
+static void resize(une_map *map, size_t capacity)
+{
+    assert(capacity >= map->count && (capacity & (capacity - 1)) == 0);
+    if (map->entries) {
+        map->entries = realloc(map->entries, capacity * sizeof(*map->entries));
+        free(map->slots);
+    } else {
+        map->entries = malloc(capacity * sizeof(*map->entries));
+    }
+    verify(map->entries);
+    map->slots = calloc(2 * capacity, sizeof(*map->slots));
+    verify(map->slots);
+    map->capacity = capacity;
+    size_t mask = 2 * capacity - 1;
+    for (size_t i = 0; i < map->count; i++) {
+        size_t slot = map->entries[i].hash & mask;
+        while (map->slots[slot] != 0)
+            slot = (slot + 1) & mask;
+        map->slots[slot] = i + 1;
+    }
+}
+
+/*
+Empty a slot, moving the slots after it that would be reached sooner from their ideal slot into its
+place, so that every entry stays reachable without marking removed slots.
+*/
+static void empty_slot(une_map *map, size_t slot)
+{
+    size_t mask = 2 * map->capacity - 1;
+    size_t next = slot;
+    while (true) {
+        next = (next + 1) & mask;
+        if (map->slots[next] == 0)
+            break;
+        size_t ideal = map->entries[map->slots[next] - 1].hash & mask;
+        /* Skip entries whose ideal slot lies cyclically in (slot, next]. */
+        if (slot <= next ? (slot < ideal && ideal <= next) : (slot < ideal || ideal <= next))
+            continue;
+        map->slots[slot] = map->slots[next];
+        slot = next;
+    }
+    map->slots[slot] = 0;
+}
+
+/*
+Get the value a valid key maps to, adding the key with a VOID value if it is not in the map yet.
+*/
+static une_result *insert(une_map *map, une_result key)
+{
+    size_t hash = hash_key(key);
+    if (map->capacity > 0) {
+        size_t slot = find_slot(map, key, hash);
+        if (map->slots[slot] != 0)
+            return &map->entries[map->slots[slot] - 1].value;
+    }
+    if (map->count == map->capacity)
+        resize(map, map->capacity == 0 ? INITIAL_CAPACITY : 2 * map->capacity);
+    size_t slot = find_slot(map, key, hash);
+    assert(map->slots[slot] == 0);
+    map->entries[map->count] = (une_map_entry){
+        .hash = hash,
+        .key = une_result_copy(key),
+        .value = une_result_create(UNE_RK_VOID),
+    };
+    map->slots[slot] = ++map->count;
+    return &map->entries[map->count - 1].value;
+}
+
+/*
+*** Interface.
+*/
+
+/*
+Create an empty map.
+*/
+une_result une_type_map_create(void)
+{
+    une_map *map = malloc(sizeof(*map));
+    verify(map);
+    *map = (une_map){.references = 1, .count = 0, .capacity = 0, .entries = NULL, .slots = NULL};
+    return (une_result){.kind = UNE_RK_MAP, .value._vp = map};
+}
+
+/*
+Create a map from a list of [key, value] pairs. Later pairs replace earlier ones with the same key.
+Return an ERROR result if an item is not a pair with a valid key.
+*/
+une_result une_type_map_from_pairs(une_result list)
+{
+    assert(list.kind == UNE_RK_LIST);
+    UNE_UNPACK_RESULT_LIST(list, pairs, count);
+    UNE_FOR_RESULT_LIST_ITEM(i, count)
+    {
+        if (pairs[i].kind != UNE_RK_LIST)
+            return une_result_create(UNE_RK_ERROR);
+        UNE_UNPACK_RESULT_LIST(pairs[i], pair, pair_size);
+        if (pair_size != 2 || !une_type_map_is_valid_key(pair[1]))
+            return une_result_create(UNE_RK_ERROR);
+    }
+    une_result map = une_type_map_create();
+    UNE_FOR_RESULT_LIST_ITEM(i, count)
+    {
+        une_result *pair = (une_result *)pairs[i].value._vp;
+        une_result *value = une_type_map_insert(&map, pair[1]);
+        une_result_free(*value);
+        *value = une_result_copy(pair[2]);
+    }
+    return map;
+}
+
+/*
+Check if a result can be a key.
+*/
+bool une_type_map_is_valid_key(une_result key)
+{
+    if (key.kind == UNE_RK_FLT)
+        return !isnan(key.value._flt);
+    return key.kind == UNE_RK_INT || key.kind == UNE_RK_STR;
+}
+
+/*
+Get the value a valid key maps to, or NULL if it is not in the map.
+*/
+une_result *une_type_map_find(une_result subject, une_result key)
+{
+    une_map *map = result_as_map(subject);
+    if (map->count == 0)
+        return NULL;
+    size_t slot = find_slot(map, key, hash_key(key));
+    if (map->slots[slot] == 0)
+        return NULL;
+    return &map->entries[map->slots[slot] - 1].value;
+}
+
+/*
+Get the value a valid key maps to where the map is stored, adding the key with a VOID value if it is
+not in the map yet.
+*/
+une_result *une_type_map_insert(une_result *result, une_result key)
+{
+    une_type_map_unshare(result);
+    return insert(UNE_MAP(*result), key);
+}
+
+/*
+Remove a key that is in the map where the map is stored and return the value it mapped to. The last
+entry takes the place of the removed one.
+*/
+une_result une_type_map_delete(une_result *result, une_result key)
+{
+    une_type_map_unshare(result);
+    une_map *map = UNE_MAP(*result);
+    assert(map->count > 0);
+    size_t slot = find_slot(map, key, hash_key(key));
+    assert(map->slots[slot] != 0);
+    size_t position = map->slots[slot] - 1;
+    une_result value = map->entries[position].value;
+    une_result_free(map->entries[position].key);
+    empty_slot(map, slot);
+
+    /* Move the last entry into the gap. */
+    size_t last = map->count - 1;
+    if (position != last) {
+        size_t last_slot = find_slot(map, map->entries[last].key, map->entries[last].hash);
+        assert(map->slots[last_slot] == last + 1);
+        map->slots[last_slot] = position + 1;
+        map->entries[position] = map->entries[last];
+    }
+    map->count--;
+    return value;
+}
+
+/*
+Get a list of the keys.
+*/
+une_result une_type_map_keys(une_result subject)
+{
+    une_map *map = result_as_map(subject);
+    une_result *list = une_result_list_create(map->count);
+    for (size_t i = 0; i < map->count; i++)
+        list[i + 1] = une_result_copy(map->entries[i].key);
+    return (une_result){.kind = UNE_RK_LIST, .value._vp = (void *)list};
+}
+
+/*
+Get a list of the values.
+*/
+une_result une_type_map_values(une_result subject)
+{
+    une_map *map = result_as_map(subject);
+    une_result *list = une_result_list_create(map->count);
+    for (size_t i = 0; i < map->count; i++)
+        list[i + 1] = une_result_copy(map->entries[i].value);
+    return (une_result){.kind = UNE_RK_LIST, .value._vp = (void *)list};
+}
+
+/*
+Print a text representation to file.
+*/
+void une_type_map_represent(FILE *file, une_result result)
+{
+    assert(result.kind == UNE_RK_MAP);
+    une_map *map = UNE_MAP(result);
+    fwprintf(file, L"map([");
+    for (size_t i = 0; i < map->count; i++) {
+        une_result pair[] = {map->entries[i].key, map->entries[i].value};
+        putwc(L'[', file);
+        for (size_t j = 0; j < 2; j++) {
+            if (pair[j].kind == UNE_RK_STR)
+                putwc(L'"', file);
+            une_result_represent(file, pair[j]);
+            if (pair[j].kind == UNE_RK_STR)
+                putwc(L'"', file);
+            if (j == 0)
+                fwprintf(file, L", ");
+        }
+        putwc(L']', file);
+        if (i + 1 < map->count)
+            fwprintf(file, L", ");
+    }
+    fwprintf(file, L"])");
+}
+
+/*
+Check for truth.
+*/
+une_int une_type_map_is_true(une_result result)
+{
+    assert(result.kind == UNE_RK_MAP);
+    return UNE_MAP(result)->count == 0 ? 0 : 1;
+}
+
+/*
+Check if subject is equal to comparison. The order of the keys does not matter.
+*/
+une_int une_type_map_is_equal(une_result subject, une_result comparison)
+{
+    assert(subject.kind == UNE_RK_MAP);
+    if (comparison.kind != UNE_RK_MAP)
+        return 0;
+    une_map *map = UNE_MAP(subject);
+    if (map->count != UNE_MAP(comparison)->count)
+        return 0;
+    for (size_t i = 0; i < map->count; i++) {
+        une_result *value = une_type_map_find(comparison, map->entries[i].key);
+        if (!value || !une_result_equ_result(map->entries[i].value, *value))
+            return 0;
+    }
+    return 1;
+}
+
+/*
+Get the length.
+*/
+size_t une_type_map_get_len(une_result result)
+{
+    return result_as_map(result)->count;
+}
+
+/*
+Get the key at a position, in the order the keys were added.
+*/
+une_result une_type_map_get_element(une_result subject, une_result position)
+{
+    une_map *map = result_as_map(subject);
+    assert(position.kind == UNE_RK_INT && position.value._int >= 0 &&
+           (size_t)position.value._int < map->count);
+    return une_result_copy(map->entries[position.value._int].key);
+}
+
+/*
+Check if an index is valid. Any key is, whether it is in the map or not.
+*/
+bool une_type_map_is_valid_index(une_result subject, une_result index)
+{
+    (void)subject;
+    return une_type_map_is_valid_key(index);
+}
+
+/*
+Refer to the value a key maps to, adding the key with a VOID value if it is not in the map yet.
+*/
+une_result une_type_map_refer_to_index(une_result subject, une_result index)
+{
+    return (une_result){.kind = UNE_RK_REFERENCE,
+                        .reference_kind = UNE_FK_SINGLE,
+                        .reference_root = insert(result_as_map(subject), index)};
+}
+
+/*
+Get the value a key maps to, or VOID if it is not in the map.
+*/
+une_result une_type_map_get_index(une_result subject, une_result index)
+{
+    une_result *value = une_type_map_find(subject, index);
+    if (!value)
+        return une_result_create(UNE_RK_VOID);
+    return une_result_copy(*value);
+}
+
+/*
+Create a duplicate.
+*/
+une_result une_type_map_copy(une_result original)
+{
+    assert(original.kind == UNE_RK_MAP);
+    UNE_MAP(original)->references++;
+    return original;
+}
+
+/*
+Give the result its own copy of shared storage. The keys and values are shared with the original.
+*/
+void une_type_map_unshare(une_result *result)
+{
+    assert(result->kind == UNE_RK_MAP);
+    une_map *map = UNE_MAP(*result);
+    if (map->references == 1)
+        return;
+    map->references--;
+    une_result copy = une_type_map_create();
+    une_map *copy_map = UNE_MAP(copy);
+    if (map->count > 0) {
+        resize(copy_map, map->capacity);
+        for (size_t i = 0; i < map->count; i++)
+            copy_map->entries[i] = (une_map_entry){
+                .hash = map->entries[i].hash,
+                .key = une_result_copy(map->entries[i].key),
+                .value = une_result_copy(map->entries[i].value),
+            };
+        copy_map->count = map->count;
+        memcpy(copy_map->slots, map->slots, 2 * map->capacity * sizeof(*map->slots));
+    }
+    *result = copy;
+}
+
+/*
+Free all members.
+*/
+void une_type_map_free_members(une_result result)
+{
+    assert(result.kind == UNE_RK_MAP);
+    une_map *map = UNE_MAP(result);
+    if (--map->references > 0)
+        return;
+    for (size_t i = 0; i < map->count; i++) {
+        une_result_free(map->entries[i].key);
+        une_result_free(map->entries[i].value);
+    }
+    if (map->entries) {
+        free(map->entries);
+        free(map->slots);
+    }
+    free(map);
+}
@@ -0,0 +1,37 @@
+/*
+map.h - Une
+*/
+
+#ifndef UNE_TYPES_MAP_H
+#define UNE_TYPES_MAP_H
+
+/* Header-specific includes. */
+#include "../common.h"
+#include "../struct/result.h"
+
+une_result une_type_map_create(void);
+une_result une_type_map_from_pairs(une_result list);
+bool une_type_map_is_valid_key(une_result key);
+une_result *une_type_map_find(une_result subject, une_result key);
+une_result *une_type_map_insert(une_result *result, une_result key);
+une_result une_type_map_delete(une_result *result, une_result key);
+une_result une_type_map_keys(une_result subject);
+une_result une_type_map_values(une_result subject);
+
+void une_type_map_represent(FILE *file, une_result result);
+
+une_int une_type_map_is_true(une_result result);
+une_int une_type_map_is_equal(une_result subject, une_result comparison);
+
+size_t une_type_map_get_len(une_result result);
+une_result une_type_map_get_element(une_result subject, une_result position);
+
+bool une_type_map_is_valid_index(une_result subject, une_result index);
+une_result une_type_map_refer_to_index(une_result subject, une_result index);
+une_result une_type_map_get_index(une_result subject, une_result index);
+
+une_result une_type_map_copy(une_result result);
+void une_type_map_unshare(une_result *result);
+void une_type_map_free_members(une_result result);
+
+#endif /* UNE_TYPES_MAP_H */
@@ -42,7 +42,7 @@ une_int une_type_native_is_equal(une_result subject, une_result comparison)
 Call result.
 */
 une_result
-une_type_native_call(une_node *call, une_result function, une_result args, wchar_t *label)
+une_type_native_call(une_node *call, une_result function, une_result args, une_symbol label)
 {
     /* Get native function. */
     une_native native = (une_native)function.value._int;
@@ -18,6 +18,6 @@ une_int une_type_native_is_true(une_result result);
 une_int une_type_native_is_equal(une_result subject, une_result comparison);
 
 une_result
-une_type_native_call(une_node *call, une_result function, une_result args, wchar_t *label);
+une_type_native_call(une_node *call, une_result function, une_result args, une_symbol label);
 
 #endif /* UNE_TYPES_NATIVE_H */
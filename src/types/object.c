@@ -18,16 +18,47 @@ static une_object *result_as_object_pointer(une_result subject)
 {
     if (subject.kind == UNE_RK_OBJECT)
         return (une_object *)subject.value._vp;
-    assert(subject.kind == UNE_RK_REFERENCE && subject.reference.kind == UNE_FK_SINGLE);
-    une_result *container = (une_result *)subject.reference.root;
+    assert(subject.kind == UNE_RK_REFERENCE && subject.reference_kind == UNE_FK_SINGLE);
+    une_result *container = (une_result *)subject.reference_root;
     assert(container->kind == UNE_RK_OBJECT);
     return (une_object *)container->value._vp;
 }
 
+/*
+Create an object owned by the current context, sharing the members of original.
+*/
+static une_object *object_clone(une_object *original)
+{
+    une_object *clone = une_type_object_create(original->shape);
+    UNE_FOR_OBJECT_MEMBER(i, original)
+    clone->members[i] = une_result_copy(original->members[i]);
+    return clone;
+}
+
 /*
 *** Interface.
 */
 
+/*
+Allocate an object of a given shape. Its members are initialized to Void.
+*/
+une_object *une_type_object_create(une_shape *shape)
+{
+    une_object *object = malloc(sizeof(*object));
+    verify(object);
+    object->shape = shape;
+    object->members = NULL;
+    if (shape->count > 0) {
+        object->members = malloc(shape->count * sizeof(*object->members));
+        verify(object->members);
+    }
+    UNE_FOR_OBJECT_MEMBER(i, object)
+    object->members[i] = une_result_create(UNE_RK_VOID);
+    object->owner = felix->is.context;
+    object->references = 1;
+    return object;
+}
+
 /*
 Print a text representation to file.
 */
@@ -41,15 +72,13 @@ void une_type_object_represent(FILE *file, une_result result)
     fwprintf(file, L"{");
     UNE_FOR_OBJECT_MEMBER(i, object)
     {
-        if (!object->members[i]->name)
-            continue;
-        fwprintf(file, L"%ls: ", object->members[i]->name);
-        if (object->members[i]->content.kind == UNE_RK_STR)
+        fwprintf(file, L"%ls: ", une_symbols_name(&felix->symbols, object->shape->names[i]));
+        if (object->members[i].kind == UNE_RK_STR)
             putwc(L'"', file);
-        une_result_represent(file, object->members[i]->content);
-        if (object->members[i]->content.kind == UNE_RK_STR)
+        une_result_represent(file, object->members[i]);
+        if (object->members[i].kind == UNE_RK_STR)
             putwc(L'"', file);
-        if (i < object->members_length - 1)
+        if (i < object->shape->count - 1)
             fwprintf(file, L", ");
     }
     putwc(L'}', file);
@@ -65,10 +94,7 @@ une_int une_type_object_is_true(une_result result)
     /* Extract object struct. */
     une_object *object = (une_object *)result.value._vp;
 
-    UNE_FOR_OBJECT_MEMBER(i, object)
-    if (object->members[0]->name)
-        return 1;
-    return 0;
+    return object->shape->count > 0;
 }
 
 /*
@@ -85,20 +111,20 @@ une_int une_type_object_is_equal(une_result subject, une_result comparison)
     une_object *comparison_object = (une_object *)comparison.value._vp;
 
     /* Compare sizes. */
-    if (subject_object->members_length != comparison_object->members_length)
+    if (subject_object->shape->count != comparison_object->shape->count)
         return 0;
 
-    /* Compare associations. */
+    /* Compare members. Objects of the same shape store them at the same offsets. */
     UNE_FOR_OBJECT_MEMBER(i, subject_object)
     {
-        wchar_t *name = subject_object->members[i]->name;
-        if (!name)
-            continue;
-        if (!une_type_object_member_exists(comparison, name))
-            return 0;
-        une_result member =
-            une_result_dereference(une_type_object_refer_to_member(comparison, name));
-        if (!une_result_equ_result(subject_object->members[i]->content, member))
+        size_t offset = i;
+        if (comparison_object->shape != subject_object->shape) {
+            offset =
+                une_shape_find_member(comparison_object->shape, subject_object->shape->names[i]);
+            if (offset == UNE_SHAPE_NO_MEMBER)
+                return 0;
+        }
+        if (!une_result_equ_result(subject_object->members[i], comparison_object->members[offset]))
             return 0;
     }
     return 1;
@@ -116,30 +142,32 @@ bool une_type_object_is_valid_element(une_result element)
 /*
 Check if a member exists.
 */
-bool une_type_object_member_exists(une_result subject, wchar_t *name)
+bool une_type_object_member_exists(une_result subject, une_symbol name)
 {
     une_object *object = result_as_object_pointer(subject);
-    UNE_FOR_OBJECT_MEMBER(i, object)
-    if (object->members[i]->name && !wcscmp(object->members[i]->name, name))
-        return true;
-    return false;
+    return une_shape_find_member(object->shape, name) != UNE_SHAPE_NO_MEMBER;
 }
 
 /*
 Refer to a member.
 */
-une_result une_type_object_refer_to_member(une_result subject, wchar_t *name)
+une_result une_type_object_refer_to_member(une_result subject, une_symbol name)
 {
     une_object *object = result_as_object_pointer(subject);
-    une_result *root = NULL;
-    UNE_FOR_OBJECT_MEMBER(i, object)
-    if (object->members[i]->name && !wcscmp(object->members[i]->name, name)) {
-        assert(!root);
-        root = &object->members[i]->content;
-    }
-    assert(root);
+    size_t offset = une_shape_find_member(object->shape, name);
+    assert(offset != UNE_SHAPE_NO_MEMBER);
+    return une_type_object_refer_to_offset(object, offset);
+}
+
+/*
+Refer to the member at an offset of the object's shape.
+*/
+une_result une_type_object_refer_to_offset(une_object *object, size_t offset)
+{
+    assert(offset < object->shape->count);
     return (une_result){.kind = UNE_RK_REFERENCE,
-                        .reference = (une_reference){.kind = UNE_FK_SINGLE, .root = root}};
+                        .reference_kind = UNE_FK_SINGLE,
+                        .reference_root = &object->members[offset]};
 }
 
 /*
@@ -152,27 +180,45 @@ une_result une_type_object_copy(une_result original)
     /* Extract object struct. */
     une_object *original_object = (une_object *)original.value._vp;
 
-    une_object *copy_object = malloc(sizeof(*copy_object));
-    verify(copy_object);
-    copy_object->members_length = original_object->members_length;
-    copy_object->members = malloc(copy_object->members_length * sizeof(*copy_object->members));
-    verify(copy_object->members);
-    copy_object->owner = felix->is.context;
-    UNE_FOR_OBJECT_MEMBER(i, original_object)
-    {
-        copy_object->members[i] = malloc(sizeof(*copy_object->members[i]));
-        verify(copy_object->members[i]);
-        if (original_object->members[i]->name) {
-            copy_object->members[i]->name = wcsdup(original_object->members[i]->name);
-            verify(copy_object->members[i]->name);
-        } else {
-            copy_object->members[i]->name = NULL;
-        }
-        copy_object->members[i]->content = une_result_copy(original_object->members[i]->content);
+    /* Objects are only shared within their owning context, see
+    une_result_is_reference_to_foreign_object. */
+    if (original_object->owner == felix->is.context) {
+        original_object->references++;
+        return original;
+    }
+    return (une_result){.kind = UNE_RK_OBJECT, .value._vp = (void *)object_clone(original_object)};
+}
+
+/*
+Give the result its own copy of a shared object.
+*/
+void une_type_object_unshare(une_result *result)
+{
+    assert(result->kind == UNE_RK_OBJECT);
+    une_object *object = (une_object *)result->value._vp;
+    if (object->references == 1)
+        return;
+    object->references--;
+    une_object *clone = object_clone(object);
+    clone->owner = object->owner;
+    result->value._vp = (void *)clone;
+}
+
+/*
+Make the current context the owner of an object result.
+*/
+void une_type_object_claim(une_result *result)
+{
+    assert(result->kind == UNE_RK_OBJECT);
+    une_object *object = (une_object *)result->value._vp;
+    if (object->owner == felix->is.context)
+        return;
+    if (object->references == 1) {
+        object->owner = felix->is.context;
+        return;
     }
-    une_result copy = une_result_create(UNE_RK_OBJECT);
-    copy.value._vp = (void *)copy_object;
-    return copy;
+    object->references--;
+    result->value._vp = (void *)object_clone(object);
 }
 
 /*
@@ -184,10 +230,13 @@ void une_type_object_free_members(une_result result)
 
     /* Extract object struct. */
     une_object *object = (une_object *)result.value._vp;
+    if (--object->references > 0)
+        return;
 
     UNE_FOR_OBJECT_MEMBER(i, object)
-    une_association_free(object->members[i]);
+    une_result_free(object->members[i]);
 
-    free(object->members);
+    if (object->members)
+        free(object->members);
     free(object);
 }
@@ -10,32 +10,39 @@ object.h - Une
 #include "../struct/association.h"
 #include "../struct/context.h"
 #include "../struct/result.h"
-
-void une_type_object_represent(FILE *file, une_result result);
-
-une_int une_type_object_is_true(une_result result);
-une_int une_type_object_is_equal(une_result subject, une_result comparison);
-
-bool une_type_object_is_valid_element(une_result element);
-
-bool une_type_object_member_exists(une_result subject, wchar_t *name);
-une_result une_type_object_refer_to_member(une_result subject, wchar_t *name);
-
-une_result une_type_object_copy(une_result result);
-void une_type_object_free_members(une_result result);
+#include "../struct/shape.h"
 
 /*
 Object.
 */
 
 #define UNE_FOR_OBJECT_MEMBER(iterator_, object_ptr_)                                              \
-    for (size_t iterator_ = 0; iterator_ < object_ptr_->members_length; iterator_++)
+    for (size_t iterator_ = 0; iterator_ < object_ptr_->shape->count; iterator_++)
 
 typedef struct une_object_
 {
-    une_association **members;
-    size_t members_length;
+    une_shape *shape;
+    une_result *members; /* Indexed by the member offsets of shape. */
     une_context *owner;
+    size_t references; /* Results sharing this object. */
 } une_object;
 
+une_object *une_type_object_create(une_shape *shape);
+
+void une_type_object_represent(FILE *file, une_result result);
+
+une_int une_type_object_is_true(une_result result);
+une_int une_type_object_is_equal(une_result subject, une_result comparison);
+
+bool une_type_object_is_valid_element(une_result element);
+
+bool une_type_object_member_exists(une_result subject, une_symbol name);
+une_result une_type_object_refer_to_member(une_result subject, une_symbol name);
+une_result une_type_object_refer_to_offset(une_object *object, size_t offset);
+
+une_result une_type_object_copy(une_result result);
+void une_type_object_unshare(une_result *result);
+void une_type_object_claim(une_result *result);
+void une_type_object_free_members(une_result result);
+
 #endif /* UNE_TYPES_OBJECT_H */
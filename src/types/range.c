@@ -0,0 +1,169 @@
+/*
+range.c - Une
+*/
+
+/* Header-specific includes. */
+#include "range.h"
+
+/* Implementation-specific includes. */
+#include "../tools.h"
+
+/*
+*** Helpers.
+*/
+
+/*
+Get the INT at a position of a range. INTs wrap around, so that steps past the end cannot overflow.
+*/
+static une_int int_at(une_int_range *range, size_t position)
+{
+    return (une_int)((uint64_t)range->start + (uint64_t)position * (uint64_t)range->step);
+}
+
+/*
+*** Interface.
+*/
+
+/*
+Create a range of INTs from start up to (but excluding) stop, spaced step apart. step must not be 0.
+Returns a result of kind UNE_RK_ERROR if the range would hold more INTs than len() can count.
+*/
+une_result une_type_range_create(une_int start, une_int stop, une_int step)
+{
+    assert(step != 0);
+
+    /* Differences are taken unsigned, since they can exceed the largest une_int. */
+    uint64_t length = 0;
+    if (step > 0 && start < stop)
+        length = ((uint64_t)stop - (uint64_t)start - 1) / (uint64_t)step + 1;
+    else if (step < 0 && start > stop)
+        length = ((uint64_t)start - (uint64_t)stop - 1) / -(uint64_t)step + 1;
+    if (length > (uint64_t)INT64_MAX || length > SIZE_MAX)
+        return une_result_create(UNE_RK_ERROR);
+
+    une_int_range *range = malloc(sizeof(*range));
+    verify(range);
+    *range = (une_int_range){
+        .references = 1, .start = start, .stop = stop, .step = step, .length = (size_t)length};
+    return (une_result){.kind = UNE_RK_RANGE, .value._vp = range};
+}
+
+/*
+Get a list of the INTs of a range.
+*/
+une_result une_type_range_to_list(une_result result)
+{
+    assert(result.kind == UNE_RK_RANGE);
+    une_int_range *range = UNE_INT_RANGE(result);
+    une_result *list = une_result_list_create(range->length);
+    for (size_t i = 0; i < range->length; i++)
+        list[i + 1] = (une_result){.kind = UNE_RK_INT, .value._int = int_at(range, i)};
+    return (une_result){.kind = UNE_RK_LIST, .value._vp = (void *)list};
+}
+
+/*
+Print a text representation to file.
+*/
+void une_type_range_represent(FILE *file, une_result result)
+{
+    assert(result.kind == UNE_RK_RANGE);
+    une_int_range *range = UNE_INT_RANGE(result);
+    fwprintf(file, L"range(%lld, %lld, %lld)", (long long)range->start, (long long)range->stop,
+             (long long)range->step);
+}
+
+/*
+Check for truth.
+*/
+une_int une_type_range_is_true(une_result result)
+{
+    assert(result.kind == UNE_RK_RANGE);
+    return UNE_INT_RANGE(result)->length == 0 ? 0 : 1;
+}
+
+/*
+Check if subject is equal to comparison. Ranges are equal if they produce the same INTs.
+*/
+une_int une_type_range_is_equal(une_result subject, une_result comparison)
+{
+    assert(subject.kind == UNE_RK_RANGE);
+    if (comparison.kind != UNE_RK_RANGE)
+        return 0;
+    une_int_range *left = UNE_INT_RANGE(subject);
+    une_int_range *right = UNE_INT_RANGE(comparison);
+    if (left->length != right->length)
+        return 0;
+    if (left->length == 0)
+        return 1;
+    if (left->start != right->start)
+        return 0;
+    return left->length == 1 || left->step == right->step;
+}
+
+/*
+Get the length.
+*/
+size_t une_type_range_get_len(une_result result)
+{
+    assert(result.kind == UNE_RK_RANGE);
+    return UNE_INT_RANGE(result)->length;
+}
+
+/*
+Get the INT at a position.
+*/
+une_result une_type_range_get_element(une_result subject, une_result position)
+{
+    assert(subject.kind == UNE_RK_RANGE);
+    une_int_range *range = UNE_INT_RANGE(subject);
+    assert(position.kind == UNE_RK_INT && position.value._int >= 0 &&
+           (size_t)position.value._int < range->length);
+    une_int element = int_at(range, (size_t)position.value._int);
+    return (une_result){.kind = UNE_RK_INT, .value._int = element};
+}
+
+/*
+Get a cursor before the first INT.
+*/
+une_result une_type_range_begin(une_result subject)
+{
+    assert(subject.kind == UNE_RK_RANGE);
+    return (une_result){.kind = UNE_RK_INT, .value._int = 0};
+}
+
+/*
+Get the INT at a cursor and advance it, or a result of kind UNE_RK_none__ after the last INT.
+*/
+une_result une_type_range_next(une_result subject, une_result *cursor)
+{
+    assert(subject.kind == UNE_RK_RANGE);
+    une_int_range *range = UNE_INT_RANGE(subject);
+    assert(cursor->kind == UNE_RK_INT);
+    if ((size_t)cursor->value._int >= range->length)
+        return une_result_create(UNE_RK_none__);
+    une_int element = int_at(range, (size_t)cursor->value._int);
+    cursor->value._int++;
+    return (une_result){.kind = UNE_RK_INT, .value._int = element};
+}
+
+/*
+Create a duplicate.
+*/
+une_result une_type_range_copy(une_result original)
+{
+    assert(original.kind == UNE_RK_RANGE);
+    UNE_INT_RANGE(original)->references++;
+    return original;
+}
+
+/*
+Free all members.
+*/
+void une_type_range_free_members(une_result result)
+{
+    assert(result.kind == UNE_RK_RANGE);
+    une_int_range *range = UNE_INT_RANGE(result);
+    if (--range->references > 0)
+        return;
+    free(range);
+}
@@ -0,0 +1,28 @@
+/*
+range.h - Une
+*/
+
+#ifndef UNE_TYPES_RANGE_H
+#define UNE_TYPES_RANGE_H
+
+/* Header-specific includes. */
+#include "../common.h"
+#include "../struct/result.h"
+
+une_result une_type_range_create(une_int start, une_int stop, une_int step);
+une_result une_type_range_to_list(une_result result);
+
+void une_type_range_represent(FILE *file, une_result result);
+
+une_int une_type_range_is_true(une_result result);
+une_int une_type_range_is_equal(une_result subject, une_result comparison);
+
+size_t une_type_range_get_len(une_result result);
+une_result une_type_range_get_element(une_result subject, une_result position);
+une_result une_type_range_begin(une_result subject);
+une_result une_type_range_next(une_result subject, une_result *cursor);
+
+une_result une_type_range_copy(une_result result);
+void une_type_range_free_members(une_result result);
+
+#endif /* UNE_TYPES_RANGE_H */
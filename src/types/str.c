@@ -9,41 +9,574 @@ str.c - Une
 #include "../tools.h"
 #include "list.h"
 #include "str.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(UNE_NO_SIMD)
+#include <immintrin.h>
+#define UNE_STR_SEARCH_AVX2
+#endif
+#if defined(__GNUC__) && defined(__SSE2__) && !defined(UNE_NO_SIMD)
+#include <emmintrin.h>
+#define UNE_STR_SEARCH_SSE2
+#endif
+#if WCHAR_MAX > 0xFFFF
+#define UNE_STR_SEARCH_WIDE_LANES
+#endif
 
 /*
 *** Helpers.
 */
 
+/*
+Strings of a single character that fits in a single byte, which are shared instead of allocated.
+*/
+static une_str single_characters[UINT8_MAX + 1];
+static unsigned char single_character_storage[UINT8_MAX + 1];
+
 static une_reference result_as_strview(une_result subject)
 {
     une_result *container;
     if (subject.kind == UNE_RK_REFERENCE) {
-        if (subject.reference.kind == UNE_FK_STRVIEW)
-            return subject.reference;
-        assert(subject.reference.kind == UNE_FK_SINGLE);
-        container = (une_result *)subject.reference.root;
+        if (subject.reference_kind == UNE_FK_STRVIEW ||
+            subject.reference_kind == UNE_FK_NARROW_STRVIEW)
+            return UNE_RESULT_REFERENCE(subject);
+        assert(subject.reference_kind == UNE_FK_SINGLE);
+        container = (une_result *)subject.reference_root;
     } else {
         assert(subject.kind == UNE_RK_STR);
         container = &subject;
     }
     assert(container->kind == UNE_RK_STR);
-    wchar_t *root = (wchar_t *)container->value._vp;
-    size_t width = wcslen(root);
-    return (une_reference){.kind = UNE_FK_STRVIEW, .root = root, .width = width};
+    une_str *str = UNE_STR(*container);
+    return (une_reference){.kind = str->is_narrow ? UNE_FK_NARROW_STRVIEW : UNE_FK_STRVIEW,
+                           .root = str->characters,
+                           .width = str->length};
+}
+
+/*
+Refer to the characters of a view, starting at first. Views wider than a une_result can refer to
+are copied into a string of their own instead.
+*/
+static une_result strview_refer(une_reference strview, size_t first, size_t width)
+{
+    size_t character_size =
+        strview.kind == UNE_FK_NARROW_STRVIEW ? sizeof(unsigned char) : sizeof(wchar_t);
+    if (width > UNE_REFERENCE_WIDTH_MAX) {
+        bool is_narrow = strview.kind == UNE_FK_NARROW_STRVIEW;
+        une_str *copy = une_type_str_create(width, is_narrow);
+        const char *characters = (char *)strview.root + first * character_size;
+        une_type_str_write(copy, 0, characters, is_narrow, width);
+        return (une_result){.kind = UNE_RK_STR, .value._vp = copy};
+    }
+    return (une_result){.kind = UNE_RK_REFERENCE,
+                        .reference_kind = (uint8_t)strview.kind,
+                        .reference_width = (uint32_t)width,
+                        .reference_root = (char *)strview.root + first * character_size};
+}
+
+/*
+Get the characters of a view as a string sharing the storage of the string it was made into, if it
+is known.
+*/
+static une_result slice(une_result subject, une_reference strview, size_t first, size_t width)
+{
+    if (subject.kind == UNE_RK_REFERENCE && subject.reference_kind != UNE_FK_SINGLE)
+        return une_result_dereference(strview_refer(strview, first, width));
+    if (subject.kind == UNE_RK_REFERENCE)
+        subject = *(une_result *)subject.reference_root;
+    return une_type_str_substring(subject, first, width);
+}
+
+/*
+Drop the hash of the string a reference is made into, since the string may be written through it.
+*/
+static void forget_hash(une_result subject)
+{
+    if (subject.kind == UNE_RK_REFERENCE && subject.reference_kind == UNE_FK_SINGLE)
+        UNE_STR(*(une_result *)subject.reference_root)->hash = UNE_STR_NO_HASH;
+}
+
+/*
+Check if every character of a wide character string fits in a single byte.
+*/
+static bool fits_narrow(const wchar_t *wcs, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+        if ((uint32_t)wcs[i] > UINT8_MAX)
+            return false;
+    return true;
+}
+
+/*
+Get the size of the characters of a string.
+*/
+static size_t character_size(une_str *str)
+{
+    return str->is_narrow ? sizeof(unsigned char) : sizeof(wchar_t);
+}
+
+/*
+Copy count characters from source to destination, converting between narrow and wide storage.
+*/
+static void move_characters(void *destination,
+                            bool destination_is_narrow,
+                            const void *source,
+                            bool source_is_narrow,
+                            size_t count)
+{
+    if (destination_is_narrow == source_is_narrow) {
+        memmove(destination,
+                source,
+                count * (source_is_narrow ? sizeof(unsigned char) : sizeof(wchar_t)));
+    } else if (source_is_narrow) {
+        const unsigned char *narrow = source;
+        wchar_t *wide = destination;
+        for (size_t i = 0; i < count; i++)
+            wide[i] = (wchar_t)narrow[i];
+    } else {
+        const wchar_t *wide = source;
+        unsigned char *narrow = destination;
+        assert(fits_narrow(wide, count));
+        for (size_t i = 0; i < count; i++)
+            narrow[i] = (unsigned char)wide[i];
+    }
+}
+
+/*
+Allocate a string with its own storage, which fits capacity characters.
+*/
+static une_str *create_with_capacity(size_t length, size_t capacity, bool is_narrow)
+{
+    assert(length <= capacity);
+    size_t character_size = is_narrow ? sizeof(unsigned char) : sizeof(wchar_t);
+    une_str *str = malloc(sizeof(*str) + capacity * character_size);
+    verify(str);
+    *str = (une_str){
+        .references = 1,
+        .length = length,
+        .hash = UNE_STR_NO_HASH,
+        .is_narrow = is_narrow,
+        .grows = false,
+        .characters = str + 1,
+        .owner = NULL,
+        .capacity = capacity,
+        .used = length,
+    };
+    return str;
+}
+
+/*
+Release a reference to a string, freeing it (and releasing its owner) after the last one.
+*/
+static void release(une_str *str)
+{
+    while (str && --str->references == 0) {
+        une_str *owner = str->owner;
+        free(str);
+        str = owner;
+    }
+}
+
+/*
+Append the characters of right to left in the storage left shares or owns, returning the new
+string, or NULL if they do not fit there.
+*/
+static une_str *append_in_place(une_str *left, une_str *right)
+{
+    une_str *storage = left->owner ? left->owner : left;
+    if (storage->is_narrow && !right->is_narrow)
+        return NULL;
+    if (storage->capacity - storage->used < right->length)
+        return NULL;
+
+    /* Characters beyond left's may be used by another string that shares the storage. */
+    size_t size = character_size(storage);
+    char *end = (char *)left->characters + left->length * size;
+    if (end != (char *)storage->characters + storage->used * size)
+        return NULL;
+    move_characters(end, storage->is_narrow, right->characters, right->is_narrow, right->length);
+    storage->used += right->length;
+
+    une_str *appended = malloc(sizeof(*appended));
+    verify(appended);
+    storage->references++;
+    *appended = (une_str){
+        .references = 1,
+        .length = left->length + right->length,
+        .hash = UNE_STR_NO_HASH,
+        .is_narrow = storage->is_narrow,
+        .grows = true,
+        .characters = left->characters,
+        .owner = storage,
+        .capacity = 0,
+        .used = 0,
+    };
+    return appended;
+}
+
+/*
+Get the characters of str as a wchar_t string, in buffer if they fit into UNE_SIZE_NUMBER_AS_STRING
+characters, or else in a new allocation.
+*/
+static wchar_t *as_wcs(une_str *str, wchar_t *buffer)
+{
+    wchar_t *wcs = buffer;
+    if (str->length >= UNE_SIZE_NUMBER_AS_STRING) {
+        wcs = malloc((str->length + 1) * sizeof(*wcs));
+        verify(wcs);
+    }
+    move_characters(wcs, false, str->characters, str->is_narrow, str->length);
+    wcs[str->length] = L'\0';
+    return wcs;
+}
+
+/*
+*** Search.
+
+Candidates are found by comparing the first and last characters of the search string against many
+positions at once, and only confirmed by comparing the characters in between.
+*/
+
+/*
+Check if the characters of needle between its first and last are found at a position.
+*/
+static bool matches_at(une_str *haystack, size_t position, une_str *needle)
+{
+    size_t length = needle->length;
+    if (length <= 2)
+        return true;
+    if (haystack->is_narrow == needle->is_narrow) {
+        size_t size = character_size(needle);
+        return memcmp((char *)haystack->characters + (position + 1) * size,
+                      (char *)needle->characters + size,
+                      (length - 2) * size) == 0;
+    }
+    for (size_t i = 1; i < length - 1; i++)
+        if (UNE_STR_CHARACTER(haystack, position + i) != UNE_STR_CHARACTER(needle, i))
+            return false;
+    return true;
+}
+
+static size_t find_scalar(une_str *haystack, size_t start, une_str *needle)
+{
+    size_t length = needle->length;
+    wchar_t first = UNE_STR_CHARACTER(needle, 0);
+    wchar_t last = UNE_STR_CHARACTER(needle, length - 1);
+    for (size_t position = start; position + length <= haystack->length; position++)
+        if (UNE_STR_CHARACTER(haystack, position) == first &&
+            UNE_STR_CHARACTER(haystack, position + length - 1) == last &&
+            matches_at(haystack, position, needle))
+            return position;
+    return UNE_STR_NOT_FOUND;
+}
+
+#ifdef UNE_STR_SEARCH_SSE2
+static size_t find_narrow_sse2(une_str *haystack, size_t start, une_str *needle)
+{
+    const unsigned char *characters = haystack->characters;
+    size_t length = needle->length;
+    __m128i first = _mm_set1_epi8((char)UNE_STR_CHARACTER(needle, 0));
+    __m128i last = _mm_set1_epi8((char)UNE_STR_CHARACTER(needle, length - 1));
+    size_t position = start;
+    for (; position + length - 1 + 16 <= haystack->length; position += 16) {
+        __m128i firsts = _mm_loadu_si128((const __m128i *)(characters + position));
+        __m128i lasts = _mm_loadu_si128((const __m128i *)(characters + position + length - 1));
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(firsts, first), _mm_cmpeq_epi8(lasts, last)));
+        for (; mask; mask &= mask - 1) {
+            size_t candidate = position + (size_t)__builtin_ctz(mask);
+            if (matches_at(haystack, candidate, needle))
+                return candidate;
+        }
+    }
+    return find_scalar(haystack, position, needle);
+}
+
+#ifdef UNE_STR_SEARCH_WIDE_LANES
+static size_t find_wide_sse2(une_str *haystack, size_t start, une_str *needle)
+{
+    const wchar_t *characters = haystack->characters;
+    size_t length = needle->length;
+    __m128i first = _mm_set1_epi32((int)UNE_STR_CHARACTER(needle, 0));
+    __m128i last = _mm_set1_epi32((int)UNE_STR_CHARACTER(needle, length - 1));
+    size_t position = start;
+    for (; position + length - 1 + 4 <= haystack->length; position += 4) {
+        __m128i firsts = _mm_loadu_si128((const __m128i *)(characters + position));
+        __m128i lasts = _mm_loadu_si128((const __m128i *)(characters + position + length - 1));
+        unsigned mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(
+            _mm_and_si128(_mm_cmpeq_epi32(firsts, first), _mm_cmpeq_epi32(lasts, last))));
+        for (; mask; mask &= mask - 1) {
+            size_t candidate = position + (size_t)__builtin_ctz(mask);
+            if (matches_at(haystack, candidate, needle))
+                return candidate;
+        }
+    }
+    return find_scalar(haystack, position, needle);
+}
+#endif /* UNE_STR_SEARCH_WIDE_LANES */
+#endif /* UNE_STR_SEARCH_SSE2 */
+
+#ifdef UNE_STR_SEARCH_AVX2
+__attribute__((target("avx2"))) static size_t
+find_narrow_avx2(une_str *haystack, size_t start, une_str *needle)
+{
+    const unsigned char *characters = haystack->characters;
+    size_t length = needle->length;
+    __m256i first = _mm256_set1_epi8((char)UNE_STR_CHARACTER(needle, 0));
+    __m256i last = _mm256_set1_epi8((char)UNE_STR_CHARACTER(needle, length - 1));
+    size_t position = start;
+    for (; position + length - 1 + 32 <= haystack->length; position += 32) {
+        __m256i firsts = _mm256_loadu_si256((const __m256i *)(characters + position));
+        __m256i lasts = _mm256_loadu_si256((const __m256i *)(characters + position + length - 1));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(firsts, first), _mm256_cmpeq_epi8(lasts, last)));
+        for (; mask; mask &= mask - 1) {
+            size_t candidate = position + (size_t)__builtin_ctz(mask);
+            if (matches_at(haystack, candidate, needle))
+                return candidate;
+        }
+    }
+    return find_scalar(haystack, position, needle);
+}
+
+#ifdef UNE_STR_SEARCH_WIDE_LANES
+__attribute__((target("avx2"))) static size_t
+find_wide_avx2(une_str *haystack, size_t start, une_str *needle)
+{
+    const wchar_t *characters = haystack->characters;
+    size_t length = needle->length;
+    __m256i first = _mm256_set1_epi32((int)UNE_STR_CHARACTER(needle, 0));
+    __m256i last = _mm256_set1_epi32((int)UNE_STR_CHARACTER(needle, length - 1));
+    size_t position = start;
+    for (; position + length - 1 + 8 <= haystack->length; position += 8) {
+        __m256i firsts = _mm256_loadu_si256((const __m256i *)(characters + position));
+        __m256i lasts = _mm256_loadu_si256((const __m256i *)(characters + position + length - 1));
+        unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(
+            _mm256_and_si256(_mm256_cmpeq_epi32(firsts, first), _mm256_cmpeq_epi32(lasts, last))));
+        for (; mask; mask &= mask - 1) {
+            size_t candidate = position + (size_t)__builtin_ctz(mask);
+            if (matches_at(haystack, candidate, needle))
+                return candidate;
+        }
+    }
+    return find_scalar(haystack, position, needle);
+}
+#endif /* UNE_STR_SEARCH_WIDE_LANES */
+#endif /* UNE_STR_SEARCH_AVX2 */
+
+/*
+The fastest search the processor supports, chosen on first use.
+*/
+static size_t (*find_narrow)(une_str *, size_t, une_str *) = NULL;
+static size_t (*find_wide)(une_str *, size_t, une_str *) = NULL;
+
+static void choose_search(void)
+{
+    find_narrow = &find_scalar;
+    find_wide = &find_scalar;
+#ifdef UNE_STR_SEARCH_SSE2
+    find_narrow = &find_narrow_sse2;
+#ifdef UNE_STR_SEARCH_WIDE_LANES
+    find_wide = &find_wide_sse2;
+#endif
+#endif
+#ifdef UNE_STR_SEARCH_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        find_narrow = &find_narrow_avx2;
+#ifdef UNE_STR_SEARCH_WIDE_LANES
+        find_wide = &find_wide_avx2;
+#endif
+    }
+#endif
 }
 
 /*
 *** Interface.
 */
 
+/*
+Allocate a string of a given length with its own storage, with one byte per character if is_narrow
+is true, or one wchar_t otherwise. The caller fills it.
+*/
+une_str *une_type_str_create(size_t length, bool is_narrow)
+{
+    return create_with_capacity(length, length, is_narrow);
+}
+
+/*
+Shorten a string created longer than it turned out to be.
+*/
+void une_type_str_truncate(une_str *str, size_t length)
+{
+    assert(!str->owner && str->used == str->length);
+    assert(length <= str->length);
+    str->length = length;
+    str->used = length;
+}
+
+/*
+Write count characters, stored narrow or wide, into a string with its own storage at offset. A
+narrow string can only be written characters that fit in a single byte.
+*/
+void une_type_str_write(
+    une_str *str, size_t offset, const void *source, bool source_is_narrow, size_t count)
+{
+    assert(!str->owner);
+    assert(offset + count <= str->length);
+    void *destination = (char *)str->characters + offset * character_size(str);
+    move_characters(destination, str->is_narrow, source, source_is_narrow, count);
+}
+
+/*
+Create a string result holding a copy of a wide character string.
+*/
+une_result une_type_str_from_wcs(wchar_t *wcs)
+{
+    return une_type_str_from_wcs_with_length(wcs, wcslen(wcs));
+}
+
+/*
+Create a string result holding a copy of the first length characters of a wide character string.
+Strings whose characters all fit in a single byte are stored narrow.
+*/
+une_result une_type_str_from_wcs_with_length(wchar_t *wcs, size_t length)
+{
+    une_str *str = une_type_str_create(length, fits_narrow(wcs, length));
+    une_type_str_write(str, 0, wcs, false, length);
+    return (une_result){.kind = UNE_RK_STR, .value._vp = str};
+}
+
+/*
+Create a string result holding the text of a UTF-8 file without CRs, or an ERROR result if the file
+cannot be read. The text is decoded straight into the storage of the string, which is narrow if the
+file only holds Latin-1 characters.
+*/
+une_result une_type_str_from_file(char *path)
+{
+    une_file_bytes file;
+    if (!une_file_bytes_open(path, &file))
+        return une_result_create(UNE_RK_ERROR);
+    bool is_narrow = une_utf8_fits_narrow(file.bytes, file.size);
+
+    /* Every byte becomes at most one character. */
+    une_str *str = une_type_str_create(file.size, is_narrow);
+    size_t length = une_utf8_decode(file.bytes, file.size, str->characters, is_narrow, true, 0);
+    une_type_str_truncate(str, length);
+
+    une_file_bytes_close(&file);
+    return (une_result){.kind = UNE_RK_STR, .value._vp = str};
+}
+
+/*
+Create a string result holding length characters of a string, starting at first. It shares the
+storage of the string instead of copying the characters, which is given its own copy again when
+either of them is written to.
+*/
+une_result une_type_str_substring(une_result result, size_t first, size_t length)
+{
+    assert(result.kind == UNE_RK_STR);
+    une_str *str = UNE_STR(result);
+    assert(first + length <= str->length);
+    une_str *storage = str->owner ? str->owner : str;
+    une_str *substring = malloc(sizeof(*substring));
+    verify(substring);
+    storage->references++;
+    *substring = (une_str){
+        .references = 1,
+        .length = length,
+        .hash = UNE_STR_NO_HASH,
+        .is_narrow = str->is_narrow,
+        .grows = false,
+        .characters = (char *)str->characters + first * character_size(str),
+        .owner = storage,
+        .capacity = 0,
+        .used = 0,
+    };
+    return (une_result){.kind = UNE_RK_STR, .value._vp = substring};
+}
+
+/*
+Get a copy of the characters as a wide character string, which the caller frees.
+*/
+wchar_t *une_type_str_to_wcs(une_result result)
+{
+    assert(result.kind == UNE_RK_STR);
+    une_str *str = UNE_STR(result);
+    wchar_t *wcs = malloc((str->length + 1) * sizeof(*wcs));
+    verify(wcs);
+    move_characters(wcs, false, str->characters, str->is_narrow, str->length);
+    wcs[str->length] = L'\0';
+    return wcs;
+}
+
+/*
+Get a copy of the characters as a multibyte string, which the caller frees, or NULL if they
+cannot be encoded.
+*/
+char *une_type_str_to_str(une_result result)
+{
+    wchar_t *wcs = une_type_str_to_wcs(result);
+    char *str = une_wcs_to_str(wcs);
+    free(wcs);
+    return str;
+}
+
+/*
+Find the first occurrence of search in subject at or after start, returning its position or
+UNE_STR_NOT_FOUND. An empty string is found at start.
+*/
+size_t une_type_str_find(une_result subject, une_result search, size_t start)
+{
+    assert(subject.kind == UNE_RK_STR && search.kind == UNE_RK_STR);
+    une_str *haystack = UNE_STR(subject);
+    une_str *needle = UNE_STR(search);
+    assert(start <= haystack->length);
+    if (needle->length == 0)
+        return start;
+    if (needle->length > haystack->length - start)
+        return UNE_STR_NOT_FOUND;
+    if (!find_narrow)
+        choose_search();
+    if (!haystack->is_narrow)
+        return find_wide(haystack, start, needle);
+
+    /* Characters that do not fit in a single byte are never found in a narrow string. */
+    if ((uint32_t)UNE_STR_CHARACTER(needle, 0) > UINT8_MAX ||
+        (uint32_t)UNE_STR_CHARACTER(needle, needle->length - 1) > UINT8_MAX)
+        return UNE_STR_NOT_FOUND;
+    return find_narrow(haystack, start, needle);
+}
+
+/*
+Get the hash, computing it on first use. It only depends on the characters, not their storage.
+*/
+size_t une_type_str_hash(une_result result)
+{
+    assert(result.kind == UNE_RK_STR);
+    une_str *str = UNE_STR(result);
+    if (str->hash != UNE_STR_NO_HASH)
+        return str->hash;
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < str->length; i++) {
+        hash ^= (uint64_t)(uint32_t)UNE_STR_CHARACTER(str, i);
+        hash *= 1099511628211ULL;
+    }
+    str->hash = (size_t)hash == UNE_STR_NO_HASH ? 1 : (size_t)hash;
+    return str->hash;
+}
+
 /*
 Convert to INT.
 */
 une_result une_type_str_as_int(une_result result)
 {
     assert(result.kind == UNE_RK_STR);
+    wchar_t buffer[UNE_SIZE_NUMBER_AS_STRING];
+    wchar_t *wcs = as_wcs(UNE_STR(result), buffer);
     une_int int_;
-    if (!une_wcs_to_une_int(result.value._wcs, &int_))
+    bool success = une_wcs_to_une_int(wcs, UNE_STR(result)->length, &int_);
+    if (wcs != buffer)
+        free(wcs);
+    if (!success)
         return une_result_create(UNE_RK_ERROR);
     return (une_result){.kind = UNE_RK_INT, .value._int = int_};
 }
@@ -54,8 +587,13 @@ Convert to FLT.
 une_result une_type_str_as_flt(une_result result)
 {
     assert(result.kind == UNE_RK_STR);
+    wchar_t buffer[UNE_SIZE_NUMBER_AS_STRING];
+    wchar_t *wcs = as_wcs(UNE_STR(result), buffer);
     une_flt flt_;
-    if (!une_wcs_to_une_flt(result.value._wcs, &flt_))
+    bool success = une_wcs_to_une_flt(wcs, UNE_STR(result)->length, &flt_);
+    if (wcs != buffer)
+        free(wcs);
+    if (!success)
         return une_result_create(UNE_RK_ERROR);
     return (une_result){.kind = UNE_RK_FLT, .value._flt = flt_};
 }
@@ -75,7 +613,19 @@ Print a text representation to file.
 void une_type_str_represent(FILE *file, une_result result)
 {
     assert(result.kind == UNE_RK_STR);
-    fwprintf(file, L"%ls", result.value._wcs);
+    une_str *str = UNE_STR(result);
+
+    /* Characters are not terminated, so they are printed piece by piece. */
+    wchar_t buffer[UNE_SIZE_STR_REPRESENT + 1];
+    size_t size = character_size(str);
+    for (size_t i = 0; i < str->length; i += UNE_SIZE_STR_REPRESENT) {
+        size_t count = str->length - i;
+        if (count > UNE_SIZE_STR_REPRESENT)
+            count = UNE_SIZE_STR_REPRESENT;
+        move_characters(buffer, false, (char *)str->characters + i * size, str->is_narrow, count);
+        buffer[count] = L'\0';
+        fwprintf(file, L"%ls", buffer);
+    }
 }
 
 /*
@@ -84,7 +634,7 @@ Check for truth.
 une_int une_type_str_is_true(une_result result)
 {
     assert(result.kind == UNE_RK_STR);
-    return wcslen(result.value._wcs) == 0 ? 0 : 1;
+    return UNE_STR(result)->length == 0 ? 0 : 1;
 }
 
 /*
@@ -95,7 +645,23 @@ une_int une_type_str_is_equal(une_result subject, une_result comparison)
     assert(subject.kind == UNE_RK_STR);
     if (comparison.kind != UNE_RK_STR)
         return 0;
-    return wcscmp(subject.value._wcs, comparison.value._wcs) == 0;
+    une_str *left = UNE_STR(subject);
+    une_str *right = UNE_STR(comparison);
+    if (left == right)
+        return 1;
+    if (left->length != right->length)
+        return 0;
+    if (left->hash != right->hash && left->hash != UNE_STR_NO_HASH &&
+        right->hash != UNE_STR_NO_HASH)
+        return 0;
+    if (left->is_narrow && right->is_narrow)
+        return memcmp(left->characters, right->characters, left->length) == 0;
+    if (!left->is_narrow && !right->is_narrow)
+        return wmemcmp(left->characters, right->characters, left->length) == 0;
+    for (size_t i = 0; i < left->length; i++)
+        if (UNE_STR_CHARACTER(left, i) != UNE_STR_CHARACTER(right, i))
+            return 0;
+    return 1;
 }
 
 /*
@@ -105,7 +671,7 @@ une_int une_type_str_is_greater(une_result subject, une_result comparison)
 {
     assert(subject.kind == UNE_RK_STR);
     if (comparison.kind == UNE_RK_STR)
-        return wcslen(subject.value._wcs) > wcslen(comparison.value._wcs);
+        return UNE_STR(subject)->length > UNE_STR(comparison)->length;
     return -1;
 }
 
@@ -116,7 +682,7 @@ une_int une_type_str_is_greater_or_equal(une_result subject, une_result comparis
 {
     assert(subject.kind == UNE_RK_STR);
     if (comparison.kind == UNE_RK_STR)
-        return wcslen(subject.value._wcs) >= wcslen(comparison.value._wcs);
+        return UNE_STR(subject)->length >= UNE_STR(comparison)->length;
     return -1;
 }
 
@@ -127,7 +693,7 @@ une_int une_type_str_is_less(une_result subject, une_result comparison)
 {
     assert(subject.kind == UNE_RK_STR);
     if (comparison.kind == UNE_RK_STR)
-        return wcslen(subject.value._wcs) < wcslen(comparison.value._wcs);
+        return UNE_STR(subject)->length < UNE_STR(comparison)->length;
     return -1;
 }
 
@@ -138,33 +704,46 @@ une_int une_type_str_is_less_or_equal(une_result subject, une_result comparison)
 {
     assert(subject.kind == UNE_RK_STR);
     if (comparison.kind == UNE_RK_STR)
-        return wcslen(subject.value._wcs) <= wcslen(comparison.value._wcs);
+        return UNE_STR(subject)->length <= UNE_STR(comparison)->length;
     return -1;
 }
 
 /*
 Add right to left.
+
+Rather than copying both, the characters of right are appended in the storage of left if they fit
+after the last character in use. Strings made by appending get room to grow, so building a string
+by appending to it repeatedly takes amortized constant time per append.
 */
 une_result une_type_str_add(une_result left, une_result right)
 {
     assert(left.kind == UNE_RK_STR);
     if (right.kind != UNE_RK_STR)
         return une_result_create(UNE_RK_ERROR);
+    une_str *left_str = UNE_STR(left);
+    une_str *right_str = UNE_STR(right);
 
-    /* Get size of strings. */
-    size_t left_size = wcslen(left.value._wcs);
-    size_t right_size = wcslen(right.value._wcs);
+    une_str *appended = append_in_place(left_str, right_str);
+    if (appended)
+        return (une_result){.kind = UNE_RK_STR, .value._vp = appended};
 
     /* Create new string. */
-    wchar_t *new = malloc((left_size + right_size + 1) * sizeof(*new));
-    verify(new);
+    une_str *storage = left_str->owner ? left_str->owner : left_str;
+    size_t length = left_str->length + right_str->length;
+    appended = create_with_capacity(length,
+                                    storage->grows ? 2 * length : length,
+                                    left_str->is_narrow && right_str->is_narrow);
+    appended->grows = true;
 
     /* Populate new string. */
-    wmemcpy(new, left.value._wcs, left_size);
-    wmemcpy(new + left_size, right.value._wcs, right_size);
-    new[left_size + right_size] = L'\0';
-
-    return (une_result){.kind = UNE_RK_STR, .value._wcs = new};
+    une_type_str_write(appended, 0, left_str->characters, left_str->is_narrow, left_str->length);
+    une_type_str_write(appended,
+                       left_str->length,
+                       right_str->characters,
+                       right_str->is_narrow,
+                       right_str->length);
+
+    return (une_result){.kind = UNE_RK_STR, .value._vp = appended};
 }
 
 /*
@@ -180,18 +759,17 @@ une_result une_type_str_mul(une_result left, une_result right)
     size_t repeat = right.value._int < 0 ? 0 : (size_t)right.value._int;
 
     /* Get size of source string. */
-    size_t str_size = wcslen(left.value._wcs);
+    une_str *str = UNE_STR(left);
+    size_t str_size = str->length;
 
     /* Create new string. */
-    wchar_t *new = malloc((repeat * str_size + 1) * sizeof(*new));
-    verify(new);
+    une_str *new = une_type_str_create(repeat * str_size, str->is_narrow);
 
     /* Populate new string. */
     for (size_t i = 0; i < repeat; i++)
-        wmemcpy(new + i * str_size, left.value._wcs, str_size);
-    new[repeat * str_size] = L'\0';
+        une_type_str_write(new, i * str_size, str->characters, str->is_narrow, str_size);
 
-    return (une_result){.kind = UNE_RK_STR, .value._wcs = new};
+    return (une_result){.kind = UNE_RK_STR, .value._vp = new};
 }
 
 /*
@@ -200,7 +778,7 @@ Get the length.
 size_t une_type_str_get_len(une_result result)
 {
     assert(result.kind == UNE_RK_STR);
-    return wcslen(result.value._wcs);
+    return UNE_STR(result)->length;
 }
 
 /*
@@ -222,10 +800,41 @@ une_result une_type_str_refer_to_index(une_result subject, une_result index)
 {
     une_reference strview = result_as_strview(subject);
     une_range range = une_range_from_relative_index(index, strview.width);
-    return (une_result){.kind = UNE_RK_REFERENCE,
-                        .reference = (une_reference){.kind = UNE_FK_STRVIEW,
-                                                     .root = (wchar_t *)strview.root + range.first,
-                                                     .width = 1}};
+    forget_hash(subject);
+    return strview_refer(strview, range.first, 1);
+}
+
+/*
+Get an element without copying it.
+*/
+une_result une_type_str_get_index(une_result subject, une_result index)
+{
+    une_reference strview = result_as_strview(subject);
+    une_range range = une_range_from_relative_index(index, strview.width);
+    wchar_t character = strview.kind == UNE_FK_NARROW_STRVIEW
+                            ? (wchar_t)((unsigned char *)strview.root)[range.first]
+                            : ((wchar_t *)strview.root)[range.first];
+    if ((uint32_t)character > UINT8_MAX)
+        return slice(subject, strview, range.first, 1);
+
+    /* Characters that fit in a single byte are not tied to the string they were taken from. */
+    une_str *str = &single_characters[character];
+    if (str->references == 0) {
+        single_character_storage[character] = (unsigned char)character;
+        *str = (une_str){
+            .references = 1, /* Held by this table, so they are never freed. */
+            .length = 1,
+            .hash = UNE_STR_NO_HASH,
+            .is_narrow = true,
+            .grows = false,
+            .characters = &single_character_storage[character],
+            .owner = NULL,
+            .capacity = 1,
+            .used = 1,
+        };
+    }
+    str->references++;
+    return (une_result){.kind = UNE_RK_STR, .value._vp = str};
 }
 
 /*
@@ -247,10 +856,18 @@ une_result une_type_str_refer_to_range(une_result subject, une_result begin, une
 {
     une_reference strview = result_as_strview(subject);
     une_range range = une_range_from_relative_indices(begin, end, strview.width);
-    return (une_result){.kind = UNE_RK_REFERENCE,
-                        .reference = (une_reference){.kind = UNE_FK_STRVIEW,
-                                                     .root = (wchar_t *)strview.root + range.first,
-                                                     .width = range.length}};
+    forget_hash(subject);
+    return strview_refer(strview, range.first, range.length);
+}
+
+/*
+Get a range of elements without copying them.
+*/
+une_result une_type_str_get_range(une_result subject, une_result begin, une_result end)
+{
+    une_reference strview = result_as_strview(subject);
+    une_range range = une_range_from_relative_indices(begin, end, strview.width);
+    return slice(subject, strview, range.first, range.length);
 }
 
 /*
@@ -262,9 +879,16 @@ bool une_type_str_can_assign(une_reference subject, une_result value)
         assert(UNE_RESULT_KIND_IS_TYPE(value.kind));
         return true;
     }
-    assert(subject.kind == UNE_FK_STRVIEW);
+    assert(subject.kind == UNE_FK_STRVIEW || subject.kind == UNE_FK_NARROW_STRVIEW);
     assert(value.kind == UNE_RK_STR);
-    return wcslen(value.value._wcs) == subject.width;
+    une_str *str = UNE_STR(value);
+    if (str->length != subject.width)
+        return false;
+
+    /* Strings are widened before they are written to, but a narrow one may still be written
+    characters that fit. */
+    return subject.kind == UNE_FK_STRVIEW || str->is_narrow ||
+           fits_narrow(str->characters, str->length);
 }
 
 /*
@@ -278,13 +902,15 @@ void une_type_str_assign(une_reference subject, une_result value)
         *root = une_result_copy(value);
         return;
     }
-    assert(subject.kind == UNE_FK_STRVIEW);
+    assert(subject.kind == UNE_FK_STRVIEW || subject.kind == UNE_FK_NARROW_STRVIEW);
     assert(value.kind == UNE_RK_STR);
-    wchar_t *destination = (wchar_t *)subject.root;
-    wchar_t *source = value.value._wcs;
-    assert(wcslen(source) == subject.width);
-    for (size_t i = 0; i < subject.width; i++)
-        destination[i] = source[i];
+    une_str *str = UNE_STR(value);
+    assert(str->length == subject.width);
+    move_characters(subject.root,
+                    subject.kind == UNE_FK_NARROW_STRVIEW,
+                    str->characters,
+                    str->is_narrow,
+                    subject.width);
 }
 
 /*
@@ -293,9 +919,25 @@ Create a duplicate.
 une_result une_type_str_copy(une_result result)
 {
     assert(result.kind == UNE_RK_STR);
-    une_result copy = {.kind = UNE_RK_STR, .value._wcs = wcsdup(result.value._wcs)};
-    verify(copy.value._wcs);
-    return copy;
+    UNE_STR(result)->references++;
+    return result;
+}
+
+/*
+Give the result its own copy of shared storage. Since it is about to be written to, and any
+character may be written, it is stored wide from now on.
+*/
+void une_type_str_unshare(une_result *result)
+{
+    assert(result->kind == UNE_RK_STR);
+    une_str *str = UNE_STR(*result);
+    if (str->references == 1 && !str->owner && !str->is_narrow)
+        return;
+    une_str *wide = une_type_str_create(str->length, false);
+    une_type_str_write(wide, 0, str->characters, str->is_narrow, str->length);
+    wide->hash = str->hash;
+    release(str);
+    result->value._vp = wide;
 }
 
 /*
@@ -303,5 +945,6 @@ Free all members.
 */
 void une_type_str_free_members(une_result result)
 {
-    free(result.value._wcs);
+    assert(result.kind == UNE_RK_STR);
+    release(UNE_STR(result));
 }
@@ -9,6 +9,19 @@ str.h - Une
 #include "../common.h"
 #include "../struct/result.h"
 
+une_str *une_type_str_create(size_t length, bool is_narrow);
+void une_type_str_truncate(une_str *str, size_t length);
+void une_type_str_write(
+    une_str *str, size_t offset, const void *source, bool source_is_narrow, size_t count);
+une_result une_type_str_from_wcs(wchar_t *wcs);
+une_result une_type_str_from_wcs_with_length(wchar_t *wcs, size_t length);
+une_result une_type_str_from_file(char *path);
+une_result une_type_str_substring(une_result result, size_t first, size_t length);
+wchar_t *une_type_str_to_wcs(une_result result);
+char *une_type_str_to_str(une_result result);
+size_t une_type_str_find(une_result subject, une_result search, size_t start);
+size_t une_type_str_hash(une_result result);
+
 une_result une_type_str_as_int(une_result result);
 une_result une_type_str_as_flt(une_result result);
 une_result une_type_str_as_str(une_result result);
@@ -28,12 +41,15 @@ size_t une_type_str_get_len(une_result result);
 
 bool une_type_str_is_valid_index(une_result subject, une_result index);
 une_result une_type_str_refer_to_index(une_result subject, une_result index);
+une_result une_type_str_get_index(une_result subject, une_result index);
 bool une_type_str_is_valid_range(une_result subject, une_result begin, une_result end);
 une_result une_type_str_refer_to_range(une_result subject, une_result begin, une_result end);
+une_result une_type_str_get_range(une_result subject, une_result begin, une_result end);
 bool une_type_str_can_assign(une_reference subject, une_result value);
 void une_type_str_assign(une_reference subject, une_result value);
 
 une_result une_type_str_copy(une_result result);
+void une_type_str_unshare(une_result *result);
 void une_type_str_free_members(une_result result);
 
 #endif /* UNE_TYPES_STR_H */
@@ -6,11 +6,14 @@ types.c - Une
 #include "types.h"
 
 /* Implementation-specific includes. */
+#include "array.h"
 #include "flt.h"
 #include "function.h"
 #include "int.h"
 #include "list.h"
+#include "map.h"
 #include "native.h"
+#include "range.h"
 #include "str.h"
 #include "void.h"
 
@@ -80,11 +83,14 @@ une_type une_types[] = {
         .get_len = &une_type_str_get_len,
         .is_valid_index = &une_type_str_is_valid_index,
         .refer_to_index = &une_type_str_refer_to_index,
+        //.get_index = &une_type_str_get_index,
         .is_valid_range = &une_type_str_is_valid_range,
         .refer_to_range = &une_type_str_refer_to_range,
+        .get_range = &une_type_str_get_range,
         .can_assign = &une_type_str_can_assign,
         .assign = &une_type_str_assign,
         .copy = &une_type_str_copy,
+        .unshare = &une_type_str_unshare,
         .free_members = &une_type_str_free_members,
     },
     {
@@ -98,6 +104,7 @@ une_type une_types[] = {
         .is_less_or_equal = &une_type_list_is_less_or_equal,
         .add = &une_type_list_add,
         .mul = &une_type_list_mul,
+        .add_in_place = &une_type_list_add_in_place,
         .get_len = &une_type_list_get_len,
         .is_valid_index = &une_type_list_is_valid_index,
         .refer_to_index = &une_type_list_refer_to_index,
@@ -106,8 +113,62 @@ une_type une_types[] = {
         .can_assign = &une_type_list_can_assign,
         .assign = &une_type_list_assign,
         .copy = &une_type_list_copy,
+        .unshare = &une_type_list_unshare,
         .free_members = &une_type_list_free_members,
     },
+    {
+        .kind = UNE_RK_ARRAY,
+        .represent = &une_type_array_represent,
+        .is_true = &une_type_array_is_true,
+        .is_equal = &une_type_array_is_equal,
+        .is_greater = &une_type_array_is_greater,
+        .is_greater_or_equal = &une_type_array_is_greater_or_equal,
+        .is_less = &une_type_array_is_less,
+        .is_less_or_equal = &une_type_array_is_less_or_equal,
+        .add = &une_type_array_add,
+        .sub = &une_type_array_sub,
+        .mul = &une_type_array_mul,
+        .div = &une_type_array_div,
+        .negate = &une_type_array_negate,
+        .add_in_place = &une_type_array_add_in_place,
+        .get_len = &une_type_array_get_len,
+        .is_valid_index = &une_type_array_is_valid_index,
+        .refer_to_index = &une_type_array_refer_to_index,
+        .get_index = &une_type_array_get_index,
+        .is_valid_range = &une_type_array_is_valid_range,
+        .get_range = &une_type_array_get_range,
+        .can_assign = &une_type_array_can_assign,
+        .assign = &une_type_array_assign,
+        .copy = &une_type_array_copy,
+        .unshare = &une_type_array_unshare,
+        .free_members = &une_type_array_free_members,
+    },
+    {
+        .kind = UNE_RK_MAP,
+        .represent = &une_type_map_represent,
+        .is_true = &une_type_map_is_true,
+        .is_equal = &une_type_map_is_equal,
+        .get_len = &une_type_map_get_len,
+        .get_element = &une_type_map_get_element,
+        .is_valid_index = &une_type_map_is_valid_index,
+        .refer_to_index = &une_type_map_refer_to_index,
+        .get_index = &une_type_map_get_index,
+        .copy = &une_type_map_copy,
+        .unshare = &une_type_map_unshare,
+        .free_members = &une_type_map_free_members,
+    },
+    {
+        .kind = UNE_RK_RANGE,
+        .represent = &une_type_range_represent,
+        .is_true = &une_type_range_is_true,
+        .is_equal = &une_type_range_is_equal,
+        .get_len = &une_type_range_get_len,
+        .get_element = &une_type_range_get_element,
+        .begin = &une_type_range_begin,
+        .next = &une_type_range_next,
+        .copy = &une_type_range_copy,
+        .free_members = &une_type_range_free_members,
+    },
     {
         .kind = UNE_RK_OBJECT,
         .represent = &une_type_object_represent,
@@ -116,6 +177,7 @@ une_type une_types[] = {
         .member_exists = &une_type_object_member_exists,
         .refer_to_member = &une_type_object_refer_to_member,
         .copy = &une_type_object_copy,
+        .unshare = &une_type_object_unshare,
         .free_members = &une_type_object_free_members,
     },
     {
@@ -138,20 +200,82 @@ une_type une_types[] = {
 *** Interface.
 */
 
-une_type UNE_TYPE_FOR_RESULT_KIND(une_result_kind kind)
+une_type *une_type_for_result_kind(une_result_kind kind)
 {
     assert(UNE_RESULT_KIND_IS_TYPE(kind));
-    return une_types[kind - UNE_R_BGN_DATA_RESULT_KINDS];
+    return &une_types[kind - UNE_R_BGN_DATA_RESULT_KINDS];
 }
 
-une_type UNE_TYPE_FOR_RESULT(une_result result)
+une_type *une_type_for_result(une_result result)
 {
     if (result.kind == UNE_RK_REFERENCE) {
-        if (result.reference.kind == UNE_FK_LISTVIEW)
-            return UNE_TYPE_FOR_RESULT_KIND(UNE_RK_LIST);
-        if (result.reference.kind == UNE_FK_STRVIEW)
-            return UNE_TYPE_FOR_RESULT_KIND(UNE_RK_STR);
-        return UNE_TYPE_FOR_RESULT(*(une_result *)result.reference.root);
+        if (result.reference_kind == UNE_FK_LISTVIEW)
+            return une_type_for_result_kind(UNE_RK_LIST);
+        if (result.reference_kind == UNE_FK_STRVIEW ||
+            result.reference_kind == UNE_FK_NARROW_STRVIEW)
+            return une_type_for_result_kind(UNE_RK_STR);
+        if (result.reference_kind == UNE_FK_INT_ITEM || result.reference_kind == UNE_FK_FLT_ITEM)
+            return une_type_for_result_kind(UNE_RK_ARRAY);
+        return une_type_for_result(*(une_result *)result.reference_root);
     }
-    return UNE_TYPE_FOR_RESULT_KIND(result.kind);
+    return une_type_for_result_kind(result.kind);
+}
+
+/*
+Check if a result has elements that can be iterated over.
+*/
+bool une_type_has_elements(une_result result)
+{
+    une_type type = UNE_TYPE_FOR_RESULT(result);
+    return type.get_len && (type.get_element || type.refer_to_index);
+}
+
+/*
+Get the element at a position of a result that has elements.
+*/
+une_result une_type_get_element(une_result subject, une_result position)
+{
+    une_type type = UNE_TYPE_FOR_RESULT(subject);
+    if (type.get_element)
+        return type.get_element(subject, position);
+    if (type.get_index)
+        return type.get_index(subject, position);
+    return une_result_dereference(type.refer_to_index(subject, position));
+}
+
+/*
+Check if a result can be iterated over, either through its own cursor or by position.
+*/
+bool une_type_is_iterable(une_result result)
+{
+    return UNE_TYPE_FOR_RESULT(result).next || une_type_has_elements(result);
+}
+
+/*
+Get a cursor before the first element of an iterable result.
+*/
+une_result une_type_begin(une_result subject)
+{
+    une_type type = UNE_TYPE_FOR_RESULT(subject);
+    if (type.begin)
+        return type.begin(subject);
+    return (une_result){.kind = UNE_RK_INT, .value._int = 0};
+}
+
+/*
+Get the element at a cursor of an iterable result and advance the cursor, or a result of kind
+UNE_RK_none__ after the last element. Types without a cursor of their own are iterated by position,
+which is checked against their current length.
+*/
+une_result une_type_next(une_result subject, une_result *cursor)
+{
+    une_type type = UNE_TYPE_FOR_RESULT(subject);
+    if (type.next)
+        return type.next(subject, cursor);
+    assert(cursor->kind == UNE_RK_INT);
+    if (cursor->value._int >= (une_int)type.get_len(subject))
+        return une_result_create(UNE_RK_none__);
+    une_result element = une_type_get_element(subject, *cursor);
+    cursor->value._int++;
+    return element;
 }
@@ -10,12 +10,15 @@ types.h - Une
 #include "../struct/error.h"
 #include "../struct/interpreter_state.h"
 #include "../struct/result.h"
+#include "array.h"
 #include "flt.h"
 #include "function.h"
 #include "int.h"
 #include "list.h"
+#include "map.h"
 #include "native.h"
 #include "object.h"
+#include "range.h"
 #include "str.h"
 #include "void.h"
 #include <stdio.h>
@@ -47,24 +50,31 @@ typedef struct une_type_
     une_result (*mod)(une_result, une_result);
     une_result (*pow)(une_result, une_result);
     une_result (*negate)(une_result);
+    bool (*add_in_place)(une_result *, une_result);
 
     size_t (*get_len)(une_result);
+    une_result (*get_element)(une_result, une_result);
+    une_result (*begin)(une_result);
+    une_result (*next)(une_result, une_result *);
 
     bool (*is_valid_index)(une_result, une_result);
     une_result (*refer_to_index)(une_result, une_result);
+    une_result (*get_index)(une_result, une_result);
     bool (*is_valid_range)(une_result, une_result, une_result);
     une_result (*refer_to_range)(une_result, une_result, une_result);
+    une_result (*get_range)(une_result, une_result, une_result);
 
-    bool (*member_exists)(une_result, wchar_t *);
-    une_result (*refer_to_member)(une_result, wchar_t *);
+    bool (*member_exists)(une_result, une_symbol);
+    une_result (*refer_to_member)(une_result, une_symbol);
 
     bool (*can_assign)(une_reference, une_result);
     void (*assign)(une_reference, une_result);
 
     une_result (*copy)(une_result);
+    void (*unshare)(une_result *);
     void (*free_members)(une_result);
 
-    une_result (*call)(une_node *, une_result, une_result, wchar_t *);
+    une_result (*call)(une_node *, une_result, une_result, une_symbol);
 } une_type;
 
 extern une_type une_types[];
@@ -73,7 +83,19 @@ extern une_type une_types[];
 *** Interface.
 */
 
-une_type UNE_TYPE_FOR_RESULT_KIND(une_result_kind kind);
-une_type UNE_TYPE_FOR_RESULT(une_result result);
+une_type *une_type_for_result_kind(une_result_kind kind);
+une_type *une_type_for_result(une_result result);
+bool une_type_has_elements(une_result result);
+une_result une_type_get_element(une_result subject, une_result position);
+bool une_type_is_iterable(une_result result);
+une_result une_type_begin(une_result subject);
+une_result une_type_next(une_result subject, une_result *cursor);
+
+/*
+Get the type of a result kind or result. They are not copied, so reading one of their members costs
+no more than the lookup.
+*/
+#define UNE_TYPE_FOR_RESULT_KIND(kind) (*une_type_for_result_kind(kind))
+#define UNE_TYPE_FOR_RESULT(result) (*une_type_for_result(result))
 
 #endif /* UNE_TYPES_H */
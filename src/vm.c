@@ -0,0 +1,1290 @@
+/*
+vm.c - Une
+*/
+
+/* Header-specific includes. */
+#include "vm.h"
+
+/* Implementation-specific includes. */
+#include "interpreter.h"
+#include "struct/context.h"
+#include "struct/engine.h"
+#include "tools.h"
+#include "types/function.h"
+#include "types/types.h"
+#include <math.h>
+
+/*
+*** Interface.
+*/
+
+/*
+Execute a une_chunk in the current context.
+
+Calls to other compiled functions push a une_vm_frame onto the VM stack instead of recursing, so
+their depth is only bounded by the heap and felix->depth_limit. A call in tail position replaces the
+frame of its caller.
+*/
+une_result une_vm_execute(une_chunk *chunk)
+{
+    assert(chunk);
+
+    une_vm_frame *frame = une_vm_frame_push(chunk, NULL);
+
+    /* une_result_create is not inlined here, so registers are emptied by copying this. */
+    const une_result void_result = une_result_create(UNE_RK_VOID);
+
+    une_result *registers = frame->registers;
+    une_result result = void_result;
+    size_t ip = 0;
+
+    while (true) {
+        une_instruction instruction = chunk->code[ip];
+        une_node *node = chunk->nodes[ip];
+        une_result *a = registers + instruction.a;
+        ip++;
+
+        switch ((une_opcode)instruction.opcode) {
+
+        case UNE_OP_LOAD: {
+            /* Numbers share nothing, so they are copied directly. */
+            une_result constant = chunk->constants[instruction.b];
+            *a = constant.kind == UNE_RK_INT || constant.kind == UNE_RK_FLT
+                     ? constant
+                     : une_result_copy(constant);
+            break;
+        }
+
+        case UNE_OP_EVAL:
+            *a = une_interpret(node);
+            if (a->kind == UNE_RK_ERROR)
+                goto error;
+            break;
+
+        case UNE_OP_DEREFERENCE:
+            if (a->kind == UNE_RK_REFERENCE || a->kind == UNE_RK_OBJECT)
+                *a = une_result_dereference(*a);
+            break;
+
+        case UNE_OP_CLEAR:
+            if (a->kind != UNE_RK_VOID) {
+                une_vm_free(*a);
+                *a = void_result;
+            }
+            break;
+
+        case UNE_OP_MOVE:
+            une_vm_free(*a);
+            *a = registers[instruction.b];
+            registers[instruction.b] = void_result;
+            break;
+
+        case UNE_OP_LIST: {
+            une_result *list = une_result_list_create(instruction.c);
+            UNE_FOR_RESULT_LIST_ITEM(i, instruction.c)
+            {
+                list[i] = registers[instruction.b + i - 1];
+                registers[instruction.b + i - 1] = void_result;
+            }
+            *a = (une_result){.kind = UNE_RK_LIST, .value._vp = (void *)list};
+            break;
+        }
+
+        case UNE_OP_THIS:
+            *a = felix->is.this;
+            break;
+
+        case UNE_OP_SEEK:
+        case UNE_OP_SEEK_OR_CREATE:
+            *a = une_vm_seek_or_create(node, instruction.opcode == UNE_OP_SEEK);
+            if (a->kind == UNE_RK_ERROR)
+                goto error;
+            break;
+
+        case UNE_OP_SEEK_VALUE: {
+            *a = une_vm_seek_or_create(node, true);
+            if (a->kind == UNE_RK_ERROR)
+                goto error;
+            une_result *content = (une_result *)a->reference_root;
+            *a = content->kind == UNE_RK_INT || content->kind == UNE_RK_FLT
+                     ? *content
+                     : une_result_dereference(*a);
+            break;
+        }
+
+        case UNE_OP_ASSIGN: {
+            une_result *assignee = registers + instruction.b;
+            une_type *assignee_type = une_type_for_result(*assignee);
+
+            /* Check if value can be assigned. */
+            if (assignee_type->can_assign &&
+                !assignee_type->can_assign(UNE_RESULT_REFERENCE(*assignee), *a)) {
+                felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.b->pos);
+                goto error;
+            }
+
+            /* Assign value. */
+            if (assignee_type->assign) {
+                assignee_type->assign(UNE_RESULT_REFERENCE(*assignee), *a);
+                une_vm_free(*a);
+            } else {
+                une_result *root = (une_result *)assignee->reference_root;
+                une_vm_free(*root);
+                *root = *a;
+            }
+            une_vm_free(*assignee);
+            *assignee = void_result;
+            *a = void_result;
+            break;
+        }
+
+        case UNE_OP_OPERATE_CHECK:
+        case UNE_OP_OPERATE: {
+            /* Access subject. */
+            une_result *subject = a;
+            if (a->kind == UNE_RK_REFERENCE) {
+                if (a->reference_kind != UNE_FK_SINGLE) {
+                    felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
+                    goto error;
+                }
+                subject = (une_result *)a->reference_root;
+            }
+
+            /* Numbers support every operation, and INTs are updated in place. */
+            if (instruction.opcode == UNE_OP_OPERATE_CHECK &&
+                (subject->kind == UNE_RK_INT || subject->kind == UNE_RK_FLT))
+                break;
+            une_result *operand = registers + instruction.b;
+            if (instruction.opcode == UNE_OP_OPERATE && subject != a &&
+                subject->kind == UNE_RK_INT && operand->kind == UNE_RK_INT &&
+                une_vm_operate_on_int(node->kind, &subject->value._int, operand->value._int)) {
+                *operand = void_result;
+                *a = void_result;
+                break;
+            }
+
+            /* Check if operation is possible. */
+            une_type *subject_type = une_type_for_result(*subject);
+            une_result (*operation)(une_result, une_result) =
+                une_vm_get_operation(subject_type, une_vm_assignment_opcode(node->kind));
+            if (!operation) {
+                felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
+                goto error;
+            }
+            if (instruction.opcode == UNE_OP_OPERATE_CHECK)
+                break;
+
+            /* Add in place where the type can. */
+            if (subject != a && node->kind == UNE_NK_ASSIGNADD && subject_type->add_in_place &&
+                subject_type->add_in_place(subject, *operand)) {
+                une_vm_free(*operand);
+                *operand = void_result;
+                *a = void_result;
+                break;
+            }
+
+            /* Perform operation. */
+            une_result outcome = operation(*subject, *operand);
+            if (outcome.kind == UNE_RK_ERROR) {
+                felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.b->pos);
+                goto error;
+            }
+            une_vm_free(*operand);
+            *operand = void_result;
+            une_vm_free(*subject);
+            if (subject == a)
+                une_vm_free(outcome); /* The assignee was not a reference. */
+            else
+                *subject = outcome;
+            *a = void_result;
+            break;
+        }
+
+        case UNE_OP_INDEX_CHECK:
+            if (!une_type_for_result(*a)->refer_to_index) {
+                felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
+                goto error;
+            }
+            break;
+
+        case UNE_OP_INDEX:
+        case UNE_OP_RANGE: {
+            une_type *subject_type = une_type_for_result(*a);
+            une_result *begin = registers + instruction.b;
+            une_result *end = begin + 1;
+
+            /* Check if provided index or range is valid. */
+            bool is_range = instruction.opcode == UNE_OP_RANGE;
+            if (is_range && !subject_type->is_valid_range) {
+                felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
+                goto error;
+            }
+            if (is_range ? !subject_type->is_valid_range(*a, *begin, *end)
+                         : !subject_type->is_valid_index(*a, *begin)) {
+                felix->error = UNE_ERROR_SET(UNE_EK_INDEX, node->content.branch.b->pos);
+                goto error;
+            }
+
+            /* Get index or range if it is only read and the type can do so without copying it,
+            or refer to it otherwise. */
+            une_result referred;
+            bool gets =
+                is_range ? subject_type->get_range != NULL : subject_type->get_index != NULL;
+            if (!instruction.c && gets) {
+                referred = is_range ? subject_type->get_range(*a, *begin, *end)
+                                    : subject_type->get_index(*a, *begin);
+            } else {
+                if (is_range && !subject_type->refer_to_range) {
+                    felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
+                    goto error;
+                }
+                if (instruction.c && a->kind == UNE_RK_REFERENCE &&
+                    a->reference_kind == UNE_FK_SINGLE)
+                    une_result_unshare((une_result *)a->reference_root);
+                referred = is_range ? subject_type->refer_to_range(*a, *begin, *end)
+                                    : subject_type->refer_to_index(*a, *begin);
+
+                /* Ranges too wide to refer to are copied, which cannot be written to. */
+                if (referred.kind != UNE_RK_REFERENCE && instruction.c) {
+                    une_vm_free(referred);
+                    felix->error = UNE_ERROR_SET(UNE_EK_INDEX, node->content.branch.b->pos);
+                    goto error;
+                }
+
+                /* If the subject was not a reference, it is deleted below, so dereference now. */
+                if (UNE_RESULT_KIND_IS_TYPE(a->kind))
+                    referred = une_result_dereference(referred);
+            }
+
+            une_vm_free(*a);
+            une_vm_free(*begin);
+            *begin = void_result;
+            if (is_range) {
+                une_vm_free(*end);
+                *end = void_result;
+            }
+            *a = referred;
+            break;
+        }
+
+        case UNE_OP_MEMBER:
+            *a = une_vm_member(node, *a, &chunk->caches[instruction.b], instruction.c);
+            if (a->kind == UNE_RK_ERROR)
+                goto error;
+            break;
+
+        case UNE_OP_ADD:
+        case UNE_OP_SUB:
+        case UNE_OP_MUL:
+        case UNE_OP_FDIV:
+        case UNE_OP_DIV:
+        case UNE_OP_MOD:
+        case UNE_OP_POW: {
+            une_result *right = registers + instruction.b;
+            une_vm_quicken(chunk, ip - 1, *a, *right);
+            une_result outcome = une_vm_arithmetic((une_opcode)instruction.opcode, *a, *right);
+            une_vm_free(*a);
+            une_vm_free(*right);
+            *right = void_result;
+            *a = void_result;
+            if (outcome.kind == UNE_RK_ERROR) {
+                felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->pos);
+                goto error;
+            }
+            if (outcome.kind == UNE_RK_FLT && instruction.opcode == UNE_OP_POW &&
+                isnan(outcome.value._flt)) {
+                felix->error = UNE_ERROR_SET(UNE_EK_UNREAL_NUMBER, node->pos);
+                goto error;
+            }
+            if (outcome.kind == UNE_RK_FLT &&
+                (instruction.opcode == UNE_OP_DIV || instruction.opcode == UNE_OP_FDIV) &&
+                isinf(outcome.value._flt)) {
+                felix->error = UNE_ERROR_SET(UNE_EK_ZERO_DIVISION, node->pos);
+                goto error;
+            }
+            *a = outcome;
+            break;
+        }
+
+        case UNE_OP_NEGATE: {
+            une_type *center_type = une_type_for_result(*a);
+            if (center_type->negate == NULL) {
+                felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->pos);
+                goto error;
+            }
+            une_result negative = center_type->negate(*a);
+            une_vm_free(*a);
+            *a = negative;
+            break;
+        }
+
+        case UNE_OP_EQU:
+        case UNE_OP_NEQ:
+        case UNE_OP_GEQ:
+        case UNE_OP_GTR:
+        case UNE_OP_LEQ:
+        case UNE_OP_LSS: {
+            une_result *right = registers + instruction.b;
+            une_vm_quicken(chunk, ip - 1, *a, *right);
+            une_int applies = une_vm_compare((une_opcode)instruction.opcode, *a, *right);
+            une_vm_free(*a);
+            une_vm_free(*right);
+            *right = void_result;
+            *a = void_result;
+            if (applies == -1) {
+                felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->pos);
+                goto error;
+            }
+            *a = (une_result){.kind = UNE_RK_INT, .value._int = applies};
+            break;
+        }
+
+        case UNE_OP_ADD_INT:
+        case UNE_OP_SUB_INT:
+        case UNE_OP_MUL_INT: {
+            une_result *right = registers + instruction.b;
+            if (a->kind != UNE_RK_INT || right->kind != UNE_RK_INT)
+                goto deoptimize;
+            if (instruction.opcode == UNE_OP_ADD_INT)
+                a->value._int += right->value._int;
+            else if (instruction.opcode == UNE_OP_SUB_INT)
+                a->value._int -= right->value._int;
+            else
+                a->value._int *= right->value._int;
+            *right = void_result;
+            break;
+        }
+
+        case UNE_OP_ADD_FLT:
+        case UNE_OP_SUB_FLT:
+        case UNE_OP_MUL_FLT: {
+            une_result *right = registers + instruction.b;
+            if (a->kind != UNE_RK_FLT || right->kind != UNE_RK_FLT)
+                goto deoptimize;
+            if (instruction.opcode == UNE_OP_ADD_FLT)
+                a->value._flt += right->value._flt;
+            else if (instruction.opcode == UNE_OP_SUB_FLT)
+                a->value._flt -= right->value._flt;
+            else
+                a->value._flt *= right->value._flt;
+            *right = void_result;
+            break;
+        }
+
+        case UNE_OP_ADD_STR: {
+            une_result *right = registers + instruction.b;
+            if (a->kind != UNE_RK_STR || right->kind != UNE_RK_STR)
+                goto deoptimize;
+            une_result outcome = une_type_str_add(*a, *right);
+            une_vm_free(*a);
+            une_vm_free(*right);
+            *right = void_result;
+            *a = outcome;
+            break;
+        }
+
+        case UNE_OP_EQU_INT:
+        case UNE_OP_NEQ_INT:
+        case UNE_OP_GEQ_INT:
+        case UNE_OP_GTR_INT:
+        case UNE_OP_LEQ_INT:
+        case UNE_OP_LSS_INT: {
+            une_result *right = registers + instruction.b;
+            if (a->kind != UNE_RK_INT || right->kind != UNE_RK_INT)
+                goto deoptimize;
+            une_opcode opcode = une_vm_generalize((une_opcode)instruction.opcode);
+            a->value._int = une_vm_compare_ints(opcode, a->value._int, right->value._int);
+            *right = void_result;
+            break;
+        }
+
+        case UNE_OP_EQU_FLT:
+        case UNE_OP_NEQ_FLT:
+        case UNE_OP_GEQ_FLT:
+        case UNE_OP_GTR_FLT:
+        case UNE_OP_LEQ_FLT:
+        case UNE_OP_LSS_FLT: {
+            une_result *right = registers + instruction.b;
+            if (a->kind != UNE_RK_FLT || right->kind != UNE_RK_FLT)
+                goto deoptimize;
+            une_opcode opcode = une_vm_generalize((une_opcode)instruction.opcode);
+            une_int applies = une_vm_compare_flts(opcode, a->value._flt, right->value._flt);
+            *right = void_result;
+            *a = (une_result){.kind = UNE_RK_INT, .value._int = applies};
+            break;
+        }
+
+        case UNE_OP_EQU_STR:
+        case UNE_OP_NEQ_STR: {
+            une_result *right = registers + instruction.b;
+            if (a->kind != UNE_RK_STR || right->kind != UNE_RK_STR)
+                goto deoptimize;
+            une_int applies = une_type_str_is_equal(*a, *right);
+            if (instruction.opcode == UNE_OP_NEQ_STR)
+                applies = !applies;
+            une_vm_free(*a);
+            une_vm_free(*right);
+            *right = void_result;
+            *a = (une_result){.kind = UNE_RK_INT, .value._int = applies};
+            break;
+        }
+
+        case UNE_OP_CONCATENATE: {
+            une_result *right = registers + instruction.b;
+            une_type *left_type = une_type_for_result(*a);
+            une_type *right_type = une_type_for_result(*right);
+            if (!left_type->as_str) {
+                felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
+                goto error;
+            }
+            if (!right_type->as_str) {
+                felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.b->pos);
+                goto error;
+            }
+            une_result left_as_str = left_type->as_str(*a);
+            une_result right_as_str = right_type->as_str(*right);
+            une_result concatenated = une_type_str_add(left_as_str, right_as_str);
+            une_vm_free(left_as_str);
+            une_vm_free(right_as_str);
+            une_vm_free(*a);
+            une_vm_free(*right);
+            *right = void_result;
+            *a = concatenated;
+            break;
+        }
+
+        case UNE_OP_NOT: {
+            une_int is_true = une_result_is_true(*a);
+            une_vm_free(*a);
+            *a = (une_result){.kind = UNE_RK_INT, .value._int = !is_true};
+            break;
+        }
+
+        case UNE_OP_JUMP:
+            ip = UNE_INSTRUCTION_TARGET(instruction);
+            break;
+
+        case UNE_OP_JUMP_IF_FALSE: {
+            une_int is_true = une_result_is_true(*a);
+            une_vm_free(*a);
+            *a = void_result;
+            if (!is_true)
+                ip = UNE_INSTRUCTION_TARGET(instruction);
+            break;
+        }
+
+        case UNE_OP_AND:
+        case UNE_OP_OR:
+        case UNE_OP_NULLISH: {
+            /* Keep the result if it decides the outcome. */
+            bool decides;
+            if (instruction.opcode == UNE_OP_NULLISH)
+                decides = a->kind != UNE_RK_VOID;
+            else
+                decides = (bool)une_result_is_true(*a) == (instruction.opcode == UNE_OP_OR);
+            if (decides) {
+                ip = UNE_INSTRUCTION_TARGET(instruction);
+                break;
+            }
+            une_vm_free(*a);
+            *a = void_result;
+            break;
+        }
+
+        case UNE_OP_AS_INT:
+            if (a->kind != UNE_RK_INT) {
+                felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->pos);
+                goto error;
+            }
+            break;
+
+        case UNE_OP_ASSERT: {
+            une_int is_true = une_result_is_true(*a);
+            une_vm_free(*a);
+            *a = void_result;
+            if (!is_true) {
+                felix->error = UNE_ERROR_SET(UNE_EK_ASSERTION_NOT_MET, node->pos);
+                goto error;
+            }
+            break;
+        }
+
+        case UNE_OP_CALL:
+        case UNE_OP_TAIL_CALL: {
+            une_result *callee = registers + instruction.b;
+            une_callable *callable = une_vm_compiled_callable(*callee);
+
+            /* Other callees are called recursively. */
+            if (!callable) {
+                une_result outcome = une_vm_call(node, *callee, *a);
+                une_vm_free(*a);
+                une_vm_free(*callee);
+                *callee = void_result;
+                *a = outcome;
+                if (a->kind == UNE_RK_ERROR)
+                    goto error;
+                break;
+            }
+            une_chunk *callee_chunk = callable->chunk;
+
+            /* Replace the current frame. The outermost frame belongs to our caller. */
+            if (instruction.opcode == UNE_OP_TAIL_CALL && frame->caller) {
+                UNE_UNPACK_RESULT_LIST((*a), args_p, args_count);
+                (void)args_p;
+                if (callable->parameters.count != args_count) {
+                    felix->error = UNE_ERROR_SET(UNE_EK_CALLABLE_ARG_COUNT, node->pos);
+                    goto error;
+                }
+                une_result args = *a;
+                *a = void_result;
+                une_vm_frame replaced = *frame;
+                une_vm_frame_pop(frame);
+                une_type_function_reenter(
+                    node, callable, args, une_vm_call_label(node), replaced.parent);
+                une_vm_free(args);
+
+                frame = une_vm_frame_push(callee_chunk, replaced.caller);
+                frame->dst = replaced.dst;
+                frame->parent = replaced.parent;
+                frame->is_method_call = replaced.is_method_call;
+                frame->this_before = replaced.this_before;
+                chunk = callee_chunk;
+                registers = frame->registers;
+                ip = 0;
+                break;
+            }
+
+            /* Promote 'this' contestant to 'this', see une_vm_call. */
+            bool is_method_call = node->content.branch.a->kind == UNE_NK_MEMBER_SEEK;
+            une_result this_before = void_result;
+            if (is_method_call) {
+                this_before = felix->is.this;
+                felix->is.this = felix->is.this_contestant;
+                felix->is.this_contestant = void_result;
+            }
+
+            une_context *parent =
+                une_type_function_enter(node, callable, *a, une_vm_call_label(node));
+            une_vm_free(*a);
+            *a = void_result;
+            une_vm_free(*callee);
+            *callee = void_result;
+            if (!parent) {
+                if (is_method_call) {
+                    une_vm_free(felix->is.this);
+                    felix->is.this = this_before;
+                }
+                goto error;
+            }
+
+            /* Push a frame for the callee. */
+            frame->ip = ip;
+            frame = une_vm_frame_push(callee_chunk, frame);
+            frame->dst = instruction.a;
+            frame->parent = parent;
+            frame->is_method_call = is_method_call;
+            frame->this_before = this_before;
+            chunk = callee_chunk;
+            registers = frame->registers;
+            ip = 0;
+            break;
+        }
+
+        case UNE_OP_BLOCK_BEGIN:
+            assert(frame->watermarks_count < chunk->blocks_depth);
+            frame->watermarks[frame->watermarks_count++] =
+                une_interpreter_state_holding_strip(&felix->is);
+            une_vm_free(*a);
+            *a = void_result;
+            break;
+
+        case UNE_OP_BLOCK_END:
+            assert(frame->watermarks_count > 0);
+            une_interpreter_state_holding_reinstate(&felix->is,
+                                                    frame->watermarks[--frame->watermarks_count]);
+            break;
+
+        case UNE_OP_STATEMENT: {
+            /* Replace previous result. */
+            une_vm_free(*a);
+            *a = a[1];
+            a[1] = void_result;
+            if ((a->kind == UNE_RK_REFERENCE || a->kind == UNE_RK_OBJECT) &&
+                !une_result_is_reference_to_foreign_object(&felix->is, *a))
+                *a = une_result_dereference(*a);
+
+            /* Held results are dropped when the block ends, not after every statement. */
+            if (a->kind == UNE_RK_ERROR)
+                goto error;
+
+            /* Leave the innermost loop or the whole chunk. */
+            if (a->kind == UNE_RK_BREAK || a->kind == UNE_RK_CONTINUE) {
+                if (instruction.c == UNE_CHUNK_NO_LOOP) {
+                    result = *a;
+                    *a = void_result;
+                    goto finish;
+                }
+                une_chunk_loop loop = chunk->loops[instruction.c];
+                ip = a->kind == UNE_RK_BREAK ? loop.break_target : loop.continue_target;
+                une_vm_clear_registers(registers, loop.registers, chunk->registers_count);
+                while (frame->watermarks_count > loop.depth)
+                    une_interpreter_state_holding_reinstate(
+                        &felix->is, frame->watermarks[--frame->watermarks_count]);
+                break;
+            }
+            if (felix->is.should_return || felix->is.should_exit) {
+                result = *a;
+                *a = void_result;
+                if (instruction.b)
+                    result = une_result_dereference(result);
+                goto finish;
+            }
+            break;
+        }
+
+        case UNE_OP_RETURN:
+            felix->is.should_return = true;
+            break;
+
+        case UNE_OP_EXIT:
+            felix->is.should_exit = true;
+            if (node && a->kind != UNE_RK_INT) {
+                felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->pos);
+                goto error;
+            }
+            break;
+
+        case UNE_OP_COVER_BEGIN:
+            assert(frame->covers_count < chunk->covers_depth);
+            frame->covers[frame->covers_count++] = (une_vm_cover){
+                .target = UNE_INSTRUCTION_TARGET(instruction), .registers = instruction.a};
+            break;
+
+        case UNE_OP_COVER_END:
+            assert(frame->covers_count > 0);
+            frame->covers_count--;
+            break;
+
+        case UNE_OP_FOR_RANGE_BEGIN:
+            if (a[0].value._int == a[1].value._int) {
+                a[0] = a[1] = void_result;
+                ip = UNE_INSTRUCTION_TARGET(instruction);
+                break;
+            }
+            une_variable_find_by_node_or_create(
+                felix->is.context,
+                node->content.branch.a,
+                false); /* We only check the *local* variables. */
+            break;
+
+        case UNE_OP_FOR_RANGE_SET: {
+            une_association *var =
+                une_variable_find_by_node(felix->is.context, node->content.branch.a, false);
+            une_vm_free(var->content);
+            var->content = (une_result){.kind = UNE_RK_INT, .value._int = a->value._int};
+            break;
+        }
+
+        case UNE_OP_FOR_RANGE_NEXT:
+            a[0].value._int += a[0].value._int < a[1].value._int ? 1 : -1;
+            if (a[0].value._int != a[1].value._int)
+                ip = UNE_INSTRUCTION_TARGET(instruction);
+            break;
+
+        case UNE_OP_FOR_ELEMENT_BEGIN: {
+            if (!une_type_is_iterable(*a)) {
+                felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.b->pos);
+                goto error;
+            }
+            une_variable_find_by_node_or_create(
+                felix->is.context,
+                node->content.branch.a,
+                false); /* We only check the *local* variables. */
+            a[1] = une_type_begin(a[0]);
+            a[2] = une_type_next(a[0], &a[1]);
+            if (a[2].kind == UNE_RK_none__) {
+                a[2] = void_result;
+                ip = UNE_INSTRUCTION_TARGET(instruction);
+            }
+            break;
+        }
+
+        case UNE_OP_FOR_ELEMENT_SET: {
+            une_association *var =
+                une_variable_find_by_node(felix->is.context, node->content.branch.a, false);
+            une_vm_free(var->content);
+            var->content = a[2];
+            a[2] = void_result;
+            break;
+        }
+
+        case UNE_OP_FOR_ELEMENT_NEXT:
+            a[2] = une_type_next(a[0], &a[1]);
+            if (a[2].kind != UNE_RK_none__)
+                ip = UNE_INSTRUCTION_TARGET(instruction);
+            else
+                a[2] = void_result;
+            break;
+
+        case UNE_OP_END:
+            result = *a;
+            *a = void_result;
+            goto finish;
+
+        default:
+            assert(false);
+        }
+        continue;
+
+    deoptimize:
+        /* The operands no longer match the specialized instruction: revert and retry it. */
+        ip--;
+        chunk->code[ip].opcode = (uint16_t)une_vm_generalize((une_opcode)chunk->code[ip].opcode);
+        chunk->code[ip].c++;
+        felix->deoptimized++;
+        continue;
+
+    error:
+        /* Resume at the innermost cover, if there is one. */
+        if (frame->covers_count > 0) {
+            une_vm_cover cover = frame->covers[--frame->covers_count];
+            une_vm_clear_registers(registers, cover.registers, chunk->registers_count);
+            felix->error = une_error_create();
+            ip = cover.target;
+            continue;
+        }
+        result = une_result_create(UNE_RK_ERROR);
+
+    finish:
+        /* Popping leaves the fields of the frame intact until the next push. */
+        une_vm_frame_pop(frame);
+        if (!frame->caller)
+            break;
+
+        /* Return to the caller. */
+        result = une_type_function_leave(frame->parent, result);
+        if (frame->is_method_call) {
+            une_vm_free(felix->is.this);
+            felix->is.this = frame->this_before;
+        }
+        size_t dst = frame->dst;
+        frame = frame->caller;
+        chunk = frame->chunk;
+        registers = frame->registers;
+        ip = frame->ip;
+        registers[dst] = result;
+        if (result.kind == UNE_RK_ERROR)
+            goto error;
+    }
+
+    return result;
+}
+
+/*
+*** Helpers.
+*/
+
+/*
+Push a frame onto the VM stack to execute a une_chunk from the start.
+*/
+une_static__ une_vm_frame *une_vm_frame_push(une_chunk *chunk, une_vm_frame *caller)
+{
+    assert(chunk->registers_count > 0);
+    une_vm_stack *stack = &felix->is.vm_stack;
+
+    /* Measure the frame in cells. */
+    size_t frame_cells = UNE_VM_CELLS(sizeof(une_vm_frame));
+    size_t watermark_cells = UNE_VM_CELLS(chunk->blocks_depth * sizeof(size_t));
+    size_t cover_cells = UNE_VM_CELLS(chunk->covers_depth * sizeof(une_vm_cover));
+    size_t cells = frame_cells + chunk->registers_count + watermark_cells + cover_cells;
+
+    /* Take the cells from the current segment, or from the first following one they fit in. */
+    size_t segment = stack->segment;
+    size_t offset = stack->offset;
+    while (offset + cells > UNE_VM_STACK_SEGMENT_SIZE(segment)) {
+        segment++;
+        offset = 0;
+    }
+    while (stack->segments_count <= segment) {
+        assert(stack->segments_count < sizeof(stack->segments) / sizeof(*stack->segments));
+        une_result *new_segment =
+            malloc(UNE_VM_STACK_SEGMENT_SIZE(stack->segments_count) * sizeof(*new_segment));
+        verify(new_segment);
+        stack->segments[stack->segments_count++] = new_segment;
+    }
+    une_result *base = stack->segments[segment] + offset;
+
+    une_vm_frame *frame = (une_vm_frame *)base;
+    frame->caller = caller;
+    frame->stack_segment = stack->segment;
+    frame->stack_offset = stack->offset;
+    stack->segment = segment;
+    stack->offset = offset + cells;
+    frame->chunk = chunk;
+    frame->ip = 0;
+
+    /* Prepare registers. */
+    frame->registers = base + frame_cells;
+    une_result void_result = une_result_create(UNE_RK_VOID);
+    for (size_t i = 0; i < chunk->registers_count; i++)
+        frame->registers[i] = void_result;
+
+    /* Prepare watermarks of open blocks and active covers. */
+    frame->watermarks = (size_t *)(frame->registers + chunk->registers_count);
+    frame->watermarks_count = 0;
+    frame->covers = (une_vm_cover *)(frame->registers + chunk->registers_count + watermark_cells);
+    frame->covers_count = 0;
+
+    return frame;
+}
+
+/*
+Release everything a frame still holds and pop it off the VM stack.
+*/
+une_static__ void une_vm_frame_pop(une_vm_frame *frame)
+{
+    une_vm_clear_registers(frame->registers, 0, frame->chunk->registers_count);
+    while (frame->watermarks_count > 0)
+        une_interpreter_state_holding_reinstate(&felix->is,
+                                                frame->watermarks[--frame->watermarks_count]);
+    felix->is.vm_stack.segment = frame->stack_segment;
+    felix->is.vm_stack.offset = frame->stack_offset;
+}
+
+/*
+Return the callable of a callee if it can run in a frame of une_vm_execute, or NULL.
+*/
+une_static__ une_callable *une_vm_compiled_callable(une_result callee)
+{
+    if (callee.kind != UNE_RK_FUNCTION)
+        return NULL;
+    une_callable *callable =
+        une_callables_get_callable_by_id(felix->is.callables, callee.value._id);
+    assert(callable);
+    if (!une_engine_compile_callable(callable))
+        return NULL;
+    return callable;
+}
+
+/*
+Determine the label a call is shown with in tracebacks.
+*/
+une_static__ une_symbol une_vm_call_label(une_node *node)
+{
+    if (node->content.branch.a->kind == UNE_NK_SEEK)
+        return (une_symbol)node->content.branch.a->content.branch.a->content.value._id;
+    if (node->content.branch.a->kind == UNE_NK_MEMBER_SEEK)
+        return (une_symbol)node->content.branch.a->content.branch.b->content.value._id;
+    return UNE_SYMBOL_NONE;
+}
+
+/*
+Free a result, skipping the call for those that own no storage.
+*/
+une_static__ void une_vm_free(une_result result)
+{
+    if (result.kind != UNE_RK_VOID && result.kind != UNE_RK_INT && result.kind != UNE_RK_FLT &&
+        result.kind != UNE_RK_REFERENCE)
+        une_result_free(result);
+}
+
+/*
+Free a range of registers, leaving them VOID.
+*/
+une_static__ void une_vm_clear_registers(une_result *registers, size_t begin, size_t end)
+{
+    une_result void_result = une_result_create(UNE_RK_VOID);
+    for (size_t i = begin; i < end; i++) {
+        if (registers[i].kind == UNE_RK_VOID)
+            continue;
+        une_vm_free(registers[i]);
+        registers[i] = void_result;
+    }
+}
+
+/*
+Return a reference to a variable, optionally creating it.
+*/
+une_static__ une_result une_vm_seek_or_create(une_node *node, bool existing_only)
+{
+    /* Extract information. */
+    une_node *name = node->content.branch.a;
+    bool global = (une_node *)node->content.branch.b;
+
+    /* Find variable. */
+    une_association *var;
+    if (existing_only)
+        var = une_variable_find_by_node(felix->is.context, name, global);
+    else
+        var = une_variable_find_by_node_or_create(felix->is.context, name, global);
+    if (var == NULL) {
+        felix->error = UNE_ERROR_SET(UNE_EK_SYMBOL_NOT_DEFINED, node->content.branch.a->pos);
+        return une_result_create(UNE_RK_ERROR);
+    }
+
+    /* Return reference to variable content. */
+    return (une_result){.kind = UNE_RK_REFERENCE,
+                        .reference_kind = UNE_FK_SINGLE,
+                        .reference_root = (void *)&var->content};
+}
+
+/*
+Refer to a member of a subject, registering the subject as 'this' contestant.
+*/
+une_static__ une_result une_vm_member(une_node *node,
+                                      une_result subject,
+                                      une_chunk_cache *cache,
+                                      bool for_writing)
+{
+    if (subject.kind != UNE_RK_REFERENCE && subject.kind != UNE_RK_OBJECT) {
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
+        une_result_free(subject);
+        return une_result_create(UNE_RK_ERROR);
+    }
+    if (subject.kind == UNE_RK_OBJECT) {
+        assert(felix->is.holding.blocks > 0);
+        une_result *object_container = une_interpreter_state_holding_add(&felix->is, subject);
+        subject = (une_result){.kind = UNE_RK_REFERENCE,
+                               .reference_kind = UNE_FK_SINGLE,
+                               .reference_root = (void *)object_container};
+    }
+
+    /* Objects: look the member up in the shape only if it differs from the cached one. */
+    assert(node->content.branch.b->kind == UNE_NK_NAME);
+    une_symbol name = (une_symbol)node->content.branch.b->content.value._id;
+    une_result *container = (une_result *)subject.reference_root;
+    if (subject.reference_kind == UNE_FK_SINGLE && container->kind == UNE_RK_OBJECT) {
+        if (for_writing)
+            une_result_unshare(container);
+        une_object *object = (une_object *)container->value._vp;
+        if (object->shape != cache->shape) {
+            size_t offset = une_shape_find_member(object->shape, name);
+            if (offset == UNE_SHAPE_NO_MEMBER) {
+                felix->error =
+                    UNE_ERROR_SET(UNE_EK_SYMBOL_NOT_DEFINED, node->content.branch.b->pos);
+                une_result_free(subject);
+                return une_result_create(UNE_RK_ERROR);
+            }
+            cache->shape = object->shape;
+            cache->offset = offset;
+        }
+        une_vm_free(felix->is.this_contestant);
+        felix->is.this_contestant = subject;
+        return une_type_object_refer_to_offset(object, cache->offset);
+    }
+
+    /* Check if subject supports members. */
+    une_type *subject_type = une_type_for_result(subject);
+    if (!subject_type->refer_to_member) {
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
+        une_result_free(subject);
+        return une_result_create(UNE_RK_ERROR);
+    }
+    assert(subject_type->member_exists);
+
+    /* Refer to member. */
+    if (!subject_type->member_exists(subject, name)) {
+        felix->error = UNE_ERROR_SET(UNE_EK_SYMBOL_NOT_DEFINED, node->content.branch.b->pos);
+        une_result_free(subject);
+        return une_result_create(UNE_RK_ERROR);
+    }
+    une_result member = subject_type->refer_to_member(subject, name);
+    assert(member.kind == UNE_RK_REFERENCE);
+
+    /* Register container as 'this' contestant. */
+    une_result_free(felix->is.this_contestant);
+    felix->is.this_contestant = subject;
+
+    return member;
+}
+
+/*
+Call a callee with a list of arguments.
+*/
+une_static__ une_result une_vm_call(une_node *node, une_result callee, une_result args)
+{
+    /* Determine if this is a method call. */
+    bool is_method_call = node->content.branch.a->kind == UNE_NK_MEMBER_SEEK;
+    une_result this_before = une_result_create(UNE_RK_VOID);
+    if (is_method_call) {
+        /* Protect current 'this'. */
+        this_before = felix->is.this;
+        /* Promote 'this' contestant to actual 'this'. */
+        assert(felix->is.this_contestant.kind == UNE_RK_REFERENCE ||
+               felix->is.this_contestant.kind == UNE_RK_OBJECT);
+        felix->is.this = felix->is.this_contestant;
+        felix->is.this_contestant = une_result_create(UNE_RK_VOID);
+    }
+
+    /* Ensure result kind is callable. */
+    une_type *callee_type = une_type_for_result(callee);
+    if (callee_type->call == NULL) {
+        felix->error = UNE_ERROR_SET(UNE_EK_TYPE, node->content.branch.a->pos);
+        return une_result_create(UNE_RK_ERROR);
+    }
+
+    /* Execute function. */
+    une_result result = callee_type->call(node, callee, args, une_vm_call_label(node));
+
+    /* Free our 'this' and reinstate the previous 'this'. */
+    if (is_method_call) {
+        une_result_free(felix->is.this);
+        felix->is.this = this_before;
+    }
+
+    return result;
+}
+
+/*
+Apply an assignment operator to an INT in place, returning false if it is not done that way.
+*/
+une_static__ bool une_vm_operate_on_int(une_node_kind kind, une_int *subject, une_int operand)
+{
+    switch (kind) {
+    case UNE_NK_ASSIGNADD:
+        *subject += operand;
+        return true;
+    case UNE_NK_ASSIGNSUB:
+        *subject -= operand;
+        return true;
+    case UNE_NK_ASSIGNMUL:
+        *subject *= operand;
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*
+Perform an arithmetic operation, returning an ERROR result if it is not supported.
+*/
+une_static__ une_result une_vm_arithmetic(une_opcode opcode, une_result left, une_result right)
+{
+    /* Integer fast path. */
+    if (left.kind == UNE_RK_INT && right.kind == UNE_RK_INT) {
+        switch (opcode) {
+        case UNE_OP_ADD:
+            return (une_result){.kind = UNE_RK_INT,
+                                .value._int = left.value._int + right.value._int};
+        case UNE_OP_SUB:
+            return (une_result){.kind = UNE_RK_INT,
+                                .value._int = left.value._int - right.value._int};
+        case UNE_OP_MUL:
+            return (une_result){.kind = UNE_RK_INT,
+                                .value._int = left.value._int * right.value._int};
+        default:
+            break;
+        }
+    }
+
+    une_result (*operation)(une_result, une_result) =
+        une_vm_get_operation(une_type_for_result(left), opcode);
+    if (!operation)
+        return une_result_create(UNE_RK_ERROR);
+    return operation(left, right);
+}
+
+/*
+Compare two results, returning -1 if the comparison is not supported.
+*/
+une_static__ une_int une_vm_compare(une_opcode opcode, une_result left, une_result right)
+{
+    /* Integer fast path. */
+    if (left.kind == UNE_RK_INT && right.kind == UNE_RK_INT)
+        return une_vm_compare_ints(opcode, left.value._int, right.value._int);
+
+    switch (opcode) {
+    case UNE_OP_EQU:
+        return une_result_equ_result(left, right);
+    case UNE_OP_NEQ:
+        return une_result_neq_result(left, right);
+    case UNE_OP_GEQ:
+        return une_result_geq_result(left, right);
+    case UNE_OP_GTR:
+        return une_result_gtr_result(left, right);
+    case UNE_OP_LEQ:
+        return une_result_leq_result(left, right);
+    case UNE_OP_LSS:
+        return une_result_lss_result(left, right);
+    default:
+        assert(false);
+    }
+    return -1;
+}
+
+/*
+Compare two INTs.
+*/
+une_static__ une_int une_vm_compare_ints(une_opcode opcode, une_int left, une_int right)
+{
+    switch (opcode) {
+    case UNE_OP_EQU:
+        return left == right;
+    case UNE_OP_NEQ:
+        return left != right;
+    case UNE_OP_GEQ:
+        return left >= right;
+    case UNE_OP_GTR:
+        return left > right;
+    case UNE_OP_LEQ:
+        return left <= right;
+    case UNE_OP_LSS:
+        return left < right;
+    default:
+        assert(false);
+    }
+    return -1;
+}
+
+/*
+Compare two FLTs, with the same tolerance for equality as the FLT type.
+*/
+une_static__ une_int une_vm_compare_flts(une_opcode opcode, une_flt left, une_flt right)
+{
+    switch (opcode) {
+    case UNE_OP_EQU:
+        return une_flts_equal(left, right);
+    case UNE_OP_NEQ:
+        return !une_flts_equal(left, right);
+    case UNE_OP_GEQ:
+        return left >= right;
+    case UNE_OP_GTR:
+        return left > right;
+    case UNE_OP_LEQ:
+        return left <= right;
+    case UNE_OP_LSS:
+        return left < right;
+    default:
+        assert(false);
+    }
+    return -1;
+}
+
+/*
+Rewrite a generic arithmetic or comparison instruction into the variant specialized for the kinds
+of its operands, unless it was deoptimized too often already.
+*/
+une_static__ void une_vm_quicken(une_chunk *chunk,
+                                 size_t instruction,
+                                 une_result left,
+                                 une_result right)
+{
+    une_instruction *generic = &chunk->code[instruction];
+    if (generic->c >= UNE_VM_DEOPTIMIZATIONS_MAX)
+        return;
+    une_opcode specialized = une_vm_specialize((une_opcode)generic->opcode, left, right);
+    if (specialized == UNE_OP_none__)
+        return;
+    generic->opcode = (uint16_t)specialized;
+    felix->quickened++;
+}
+
+/*
+Get the variant of a generic opcode specialized for the kinds of its operands, or UNE_OP_none__ if
+there is none.
+*/
+une_static__ une_opcode une_vm_specialize(une_opcode opcode, une_result left, une_result right)
+{
+    if (left.kind != right.kind)
+        return UNE_OP_none__;
+    bool is_arithmetic = opcode == UNE_OP_ADD || opcode == UNE_OP_SUB || opcode == UNE_OP_MUL;
+    bool is_comparison =
+        opcode >= UNE_R_BGN_COMPARISON_OPCODES && opcode <= UNE_R_END_COMPARISON_OPCODES;
+    switch (left.kind) {
+    case UNE_RK_INT:
+        if (is_arithmetic)
+            return (une_opcode)(UNE_OP_ADD_INT + opcode - UNE_OP_ADD);
+        if (is_comparison)
+            return (une_opcode)(UNE_OP_EQU_INT + opcode - UNE_OP_EQU);
+        break;
+    case UNE_RK_FLT:
+        if (is_arithmetic)
+            return (une_opcode)(UNE_OP_ADD_FLT + opcode - UNE_OP_ADD);
+        if (is_comparison)
+            return (une_opcode)(UNE_OP_EQU_FLT + opcode - UNE_OP_EQU);
+        break;
+    case UNE_RK_STR:
+        if (opcode == UNE_OP_ADD)
+            return UNE_OP_ADD_STR;
+        if (opcode == UNE_OP_EQU)
+            return UNE_OP_EQU_STR;
+        if (opcode == UNE_OP_NEQ)
+            return UNE_OP_NEQ_STR;
+        break;
+    default:
+        break;
+    }
+    return UNE_OP_none__;
+}
+
+/*
+Get the generic opcode a specialized opcode was derived from.
+*/
+une_static__ une_opcode une_vm_generalize(une_opcode opcode)
+{
+    assert(opcode >= UNE_R_BGN_QUICKENED_OPCODES && opcode <= UNE_R_END_QUICKENED_OPCODES);
+    if (opcode <= UNE_OP_MUL_INT)
+        return (une_opcode)(UNE_OP_ADD + opcode - UNE_OP_ADD_INT);
+    if (opcode <= UNE_OP_MUL_FLT)
+        return (une_opcode)(UNE_OP_ADD + opcode - UNE_OP_ADD_FLT);
+    if (opcode == UNE_OP_ADD_STR)
+        return UNE_OP_ADD;
+    if (opcode <= UNE_OP_LSS_INT)
+        return (une_opcode)(UNE_OP_EQU + opcode - UNE_OP_EQU_INT);
+    if (opcode <= UNE_OP_LSS_FLT)
+        return (une_opcode)(UNE_OP_EQU + opcode - UNE_OP_EQU_FLT);
+    return opcode == UNE_OP_EQU_STR ? UNE_OP_EQU : UNE_OP_NEQ;
+}
+
+/*
+Get the function of a type that implements an arithmetic opcode.
+*/
+une_static__ une_result (*une_vm_get_operation(une_type *type, une_opcode opcode))(une_result,
+                                                                                une_result)
+{
+    switch (opcode) {
+    case UNE_OP_ADD:
+        return type->add;
+    case UNE_OP_SUB:
+        return type->sub;
+    case UNE_OP_MUL:
+        return type->mul;
+    case UNE_OP_FDIV:
+        return type->fdiv;
+    case UNE_OP_DIV:
+        return type->div;
+    case UNE_OP_MOD:
+        return type->mod;
+    case UNE_OP_POW:
+        return type->pow;
+    default:
+        assert(false);
+    }
+    return NULL;
+}
+
+/*
+Get the arithmetic opcode performed by an assignment node.
+*/
+une_static__ une_opcode une_vm_assignment_opcode(une_node_kind kind)
+{
+    switch (kind) {
+    case UNE_NK_ASSIGNADD:
+        return UNE_OP_ADD;
+    case UNE_NK_ASSIGNSUB:
+        return UNE_OP_SUB;
+    case UNE_NK_ASSIGNPOW:
+        return UNE_OP_POW;
+    case UNE_NK_ASSIGNMUL:
+        return UNE_OP_MUL;
+    case UNE_NK_ASSIGNFDIV:
+        return UNE_OP_FDIV;
+    case UNE_NK_ASSIGNDIV:
+        return UNE_OP_DIV;
+    case UNE_NK_ASSIGNMOD:
+        return UNE_OP_MOD;
+    default:
+        assert(false);
+    }
+    return UNE_OP_none__;
+}
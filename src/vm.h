@@ -0,0 +1,95 @@
+/*
+vm.h - Une
+*/
+
+#ifndef UNE_VM_H
+#define UNE_VM_H
+
+/* Header-specific includes. */
+#include "common.h"
+#include "struct/callable.h"
+#include "struct/chunk.h"
+#include "struct/context.h"
+#include "struct/interpreter_state.h"
+#include "struct/node.h"
+#include "struct/result.h"
+#include "types/types.h"
+
+/*
+An active 'cover', resuming execution at its fallback if an error occurs.
+*/
+typedef struct une_vm_cover_
+{
+    size_t target;
+    size_t registers; /* First register owned by the covered expression. */
+} une_vm_cover;
+
+/*
+A call in progress in une_vm_execute, at the bottom of its run of cells on the VM stack.
+*/
+typedef struct une_vm_frame_
+{
+    struct une_vm_frame_ *caller; /* NULL for the frame une_vm_execute was entered with. */
+    size_t stack_segment; /* Top of the VM stack before the frame was pushed. */
+    size_t stack_offset;
+    une_chunk *chunk;
+    une_result *registers;
+    size_t ip; /* Where to resume once a call made by this frame returns. */
+    size_t *watermarks; /* Holding watermarks of open blocks. */
+    size_t watermarks_count;
+    une_vm_cover *covers; /* Active covers. */
+    size_t covers_count;
+    size_t dst; /* Register of the caller receiving the result. */
+    une_context *parent; /* Context of the caller. */
+    bool is_method_call;
+    une_result this_before; /* 'this' of the caller, reinstated after a method call. */
+} une_vm_frame;
+
+/*
+Number of VM stack cells, each the size of a une_result, needed to hold size bytes.
+*/
+#define UNE_VM_CELLS(size__) (((size__) + sizeof(une_result) - 1) / sizeof(une_result))
+
+/*
+Number of deoptimizations after which an instruction is no longer specialized.
+*/
+#define UNE_VM_DEOPTIMIZATIONS_MAX 4
+
+/*
+*** Interface.
+*/
+
+une_result une_vm_execute(une_chunk *chunk);
+
+/*
+*** Helpers.
+*/
+
+une_static__ une_vm_frame *une_vm_frame_push(une_chunk *chunk, une_vm_frame *caller);
+une_static__ void une_vm_frame_pop(une_vm_frame *frame);
+une_static__ une_callable *une_vm_compiled_callable(une_result callee);
+une_static__ une_symbol une_vm_call_label(une_node *node);
+une_static__ void une_vm_free(une_result result);
+une_static__ void une_vm_clear_registers(une_result *registers, size_t begin, size_t end);
+une_static__ une_result une_vm_seek_or_create(une_node *node, bool existing_only);
+une_static__ une_result une_vm_member(une_node *node,
+                                      une_result subject,
+                                      une_chunk_cache *cache,
+                                      bool for_writing);
+une_static__ une_result une_vm_call(une_node *node, une_result callee, une_result args);
+une_static__ bool une_vm_operate_on_int(une_node_kind kind, une_int *subject, une_int operand);
+une_static__ une_result une_vm_arithmetic(une_opcode opcode, une_result left, une_result right);
+une_static__ une_int une_vm_compare(une_opcode opcode, une_result left, une_result right);
+une_static__ une_int une_vm_compare_ints(une_opcode opcode, une_int left, une_int right);
+une_static__ une_int une_vm_compare_flts(une_opcode opcode, une_flt left, une_flt right);
+une_static__ void une_vm_quicken(une_chunk *chunk,
+                                 size_t instruction,
+                                 une_result left,
+                                 une_result right);
+une_static__ une_opcode une_vm_specialize(une_opcode opcode, une_result left, une_result right);
+une_static__ une_opcode une_vm_generalize(une_opcode opcode);
+une_static__ une_result (*une_vm_get_operation(une_type *type, une_opcode opcode))(une_result,
+                                                                                une_result);
+une_static__ une_opcode une_vm_assignment_opcode(une_node_kind kind);
+
+#endif /* !UNE_VM_H */
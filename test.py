@@ -32,13 +32,14 @@ HIDE_OUTPUT = True
 SHOW_ERRORS = False
 CLEAR = False
 STOP_AT_FAIL = True
+MODES = ['', '-t ', '-u ']  # Bytecode, syntax tree, unoptimized bytecode.
 ENUMERATE_CASES = True if len(
     argv) > 1 and argv[1] == "enumerate_cases" else False
 FILE_SCRIPT = 'test.py.une'
 UNE = '.\\\\une.exe' if is_win() else './une'
 FILE_RETURN = 'une_report_return.txt'
 FILE_STATUS = 'une_report_status.txt'
-UNE_R_END_DATA_RESULT_KINDS = 9
+UNE_R_END_DATA_RESULT_KINDS = 12
 UNE_FLT_PRECISION = 10
 
 # CONSTANTS
@@ -49,6 +50,7 @@ ATTR_NO_IMPLICIT_RETURN = 3
 ATTR_NEVER_HIDE_OUTPUT = 4
 ATTR_NO_SECOND_ESCAPE = 5
 ATTR_STDIN = 6
+ATTR_BYTECODE_ONLY = 7
 
 # Result kinds
 UNE_RK_ERROR = 1
@@ -57,9 +59,12 @@ UNE_RK_INT = 3
 UNE_RK_FLT = 4
 UNE_RK_STR = 5
 UNE_RK_LIST = 6
-UNE_RK_OBJECT = 7
-UNE_RK_FUNCTION = 8
-UNE_RK_NATIVE = 9
+UNE_RK_ARRAY = 7
+UNE_RK_MAP = 8
+UNE_RK_RANGE = 9
+UNE_RK_OBJECT = 10
+UNE_RK_FUNCTION = 11
+UNE_RK_NATIVE = 12
 result_kinds = {
     UNE_RK_ERROR: 'UNE_RK_ERROR',
     UNE_RK_VOID: 'UNE_RK_VOID',
@@ -67,6 +72,9 @@ result_kinds = {
     UNE_RK_FLT: 'UNE_RK_FLT',
     UNE_RK_STR: 'UNE_RK_STR',
     UNE_RK_LIST: 'UNE_RK_LIST',
+    UNE_RK_ARRAY: 'UNE_RK_ARRAY',
+    UNE_RK_MAP: 'UNE_RK_MAP',
+    UNE_RK_RANGE: 'UNE_RK_RANGE',
     UNE_RK_OBJECT: 'UNE_RK_OBJECT',
     UNE_RK_FUNCTION: 'UNE_RK_FUNCTION',
     UNE_RK_NATIVE: 'UNE_RK_NATIVE',
@@ -88,6 +96,7 @@ UNE_EK_TYPE = UNE_R_END_DATA_RESULT_KINDS+11
 UNE_EK_ASSERTION_NOT_MET = UNE_R_END_DATA_RESULT_KINDS+12
 UNE_EK_MISPLACED_ANY_OR_ALL = UNE_R_END_DATA_RESULT_KINDS+13
 UNE_EK_SYSTEM = UNE_R_END_DATA_RESULT_KINDS+14
+UNE_EK_RECURSION = UNE_R_END_DATA_RESULT_KINDS+15
 error_kinds = {
     UNE_ERROR_INPUT: 'UNE_ERROR_INPUT',
     UNE_EK_SYNTAX: 'UNE_EK_SYNTAX',
@@ -104,6 +113,7 @@ error_kinds = {
     UNE_EK_ASSERTION_NOT_MET: 'UNE_EK_ASSERTION_NOT_MET',
     UNE_EK_MISPLACED_ANY_OR_ALL: 'UNE_EK_MISPLACED_ANY_OR_ALL',
     UNE_EK_SYSTEM: 'UNE_EK_SYSTEM',
+    UNE_EK_RECURSION: 'UNE_EK_RECURSION',
 }
 
 # CASES
@@ -154,6 +164,7 @@ cases = [
     Case('flt(100)', UNE_RK_FLT, flt('100.0'), []),
     Case('flt(100.9)', UNE_RK_FLT, flt('100.9'), []),
     Case('flt("100.9")', UNE_RK_FLT, flt('100.9'), []),
+    Case('flt("-100.9")', UNE_RK_FLT, flt('-100.9'), []),
     Case('flt([1])', UNE_RK_ERROR, UNE_EK_TYPE, []),
     Case('flt("100.9x")', UNE_RK_ERROR, UNE_EK_ENCODING, []),
     Case('flt("")', UNE_RK_ERROR, UNE_EK_ENCODING, []),
@@ -189,11 +200,19 @@ cases = [
     Case('script("script.une")', UNE_RK_INT, '46', []),
     Case('script(1)', UNE_RK_ERROR, UNE_EK_TYPE, []),
     Case('script("/")', UNE_RK_ERROR, UNE_EK_FILE, []),
+    Case('write("script.une","\treturn 4"+chr(13)+"\n");return script("script.une")',
+         UNE_RK_INT, '4', [ATTR_NO_IMPLICIT_RETURN]),
     Case('write("script.une", "msg=128");script("script.une");return msg',
          UNE_RK_INT, '128', [ATTR_NO_IMPLICIT_RETURN]),
 
     Case('write("script.une", "4");append("script.une", "\n6");return read("script.une")',
          UNE_RK_STR, '4\n6', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('c=chr(13);t="a"+chr(9)+"b"+c+"\n"+"x"*40+chr(233)+chr(8364)+chr(128512)+c;write("script.une",t);'
+         'r=read("script.une");return [len(r),r==replace(c,"",t),ord(r[-1])]',
+         UNE_RK_LIST, '[47, 1, 128512]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('t="x"*40+chr(255)+chr(13)+"\n";write("script.une",t+t);'
+         'return read("script.une")==replace(chr(13),"",t+t)',
+         UNE_RK_INT, '1', [ATTR_NO_IMPLICIT_RETURN]),
 
     Case('exist("script.une")', UNE_RK_INT, '1', []),
     Case('exist(1)', UNE_RK_ERROR, UNE_EK_TYPE, []),
@@ -202,6 +221,7 @@ cases = [
     Case('split(1, ["."])', UNE_RK_ERROR, UNE_EK_TYPE, []),
     Case('split("1.2.3", 1)', UNE_RK_ERROR, UNE_EK_TYPE, []),
     Case('split("1.2.3", [1])', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('split("1,2;", [",", ";"])', UNE_RK_LIST, '["1", "2"]', []),
 
     Case('join(["1","2","3"], ".")', UNE_RK_STR, "1.2.3", []),
     Case('join(["1","2",3], ".")', UNE_RK_ERROR, UNE_EK_TYPE, []),
@@ -211,16 +231,36 @@ cases = [
 
     Case('eval(0)', UNE_RK_ERROR, UNE_EK_TYPE, []),
     Case('eval("23*2")', UNE_RK_INT, '46', []),
+    Case('f=eval("return x->x*2");for i from 0 till 5{eval("y=i+1")};g=eval("return x->x+1");'
+         'h=eval("return (a->a-1)");return [f(3),g(3),h(3),y]',
+         UNE_RK_LIST, '[6, 4, 2, 5]', [ATTR_NO_IMPLICIT_RETURN]),
 
     Case('replace("a","b","xax")', UNE_RK_STR, 'xbx', []),
     Case('replace("a","","xax");return replace("a","","xax")',
          UNE_RK_STR, 'xx', [ATTR_NO_IMPLICIT_RETURN]),
     Case('replace("","","")', UNE_RK_ERROR, UNE_EK_ENCODING, []),
 
+    Case('find("abcabc", "ca")', UNE_RK_INT, '2', []),
+    Case('find("abcabc", "x")', UNE_RK_INT, '-1', []),
+    Case('find("abc", "")', UNE_RK_INT, '0', []),
+    Case('find("a"*40+chr(8364)+"ab", chr(8364)+"a")', UNE_RK_INT, '40', []),
+    Case('find(1, "a")', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('contains("abcabc", "bca")', UNE_RK_INT, '1', []),
+    Case('contains("abc", chr(8364))', UNE_RK_INT, '0', []),
+    Case('contains("abc", 1)', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('count("aaaaa", "aa")', UNE_RK_INT, '2', []),
+    Case('count("ab"*50, "ba")', UNE_RK_INT, '49', []),
+    Case('count("abc", "")', UNE_RK_INT, '4', []),
+    Case('[find("abc", ""), contains("abc", ""), count("", "")]', UNE_RK_LIST, '[0, 1, 1]', []),
+
     # main
     Case('unknown', UNE_RK_ERROR, UNE_EK_FILE, [ATTR_DIRECT_ARG]),
     Case('', UNE_RK_ERROR, UNE_ERROR_INPUT, [ATTR_DIRECT_ARG]),
     Case('-s', UNE_RK_ERROR, UNE_ERROR_INPUT, [ATTR_DIRECT_ARG]),
+    Case('-t', UNE_RK_ERROR, UNE_ERROR_INPUT, [ATTR_DIRECT_ARG]),
+    Case('-t -s "return 46"', UNE_RK_INT, '46', [ATTR_DIRECT_ARG]),
+    Case('-t -s "f=(n)->{if n<2{return n};return f(n-1)+f(n-2)};return f(10)"',
+         UNE_RK_INT, '55', [ATTR_DIRECT_ARG]),
 
     # Syntax
     Case('\r# comment', UNE_RK_VOID, 'Void', []),
@@ -548,6 +588,14 @@ cases = [
     # Get member.
     Case('({a:{b:46}}).a.b', UNE_RK_INT, '46', []),
     Case('({a:46}).b', UNE_RK_ERROR, UNE_EK_SYMBOL_NOT_DEFINED, []),
+    Case('a={b:1};eval("c=a.b+1");return c', UNE_RK_INT,
+         '2', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=o->return o.b;return [f({a:1,b:2}),f({b:3}),f({b:4,a:5})]',
+         UNE_RK_LIST, '[2, 3, 4]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=o->return o.b;f({b:1});f({a:1})',
+         UNE_RK_ERROR, UNE_EK_SYMBOL_NOT_DEFINED, []),
+    Case('({a:1,a:2}).a', UNE_RK_INT, '2', []),
+    Case('({a:1,b:[2]})==({b:[2],a:1})', UNE_RK_INT, '1', []),
 
     # Set member.
     Case('a={b:0};a.b=46;return a.b', UNE_RK_INT,
@@ -600,7 +648,7 @@ cases = [
          UNE_RK_VOID, 'Void', [ATTR_NO_IMPLICIT_RETURN]),
     Case('a=()->{return};a=()->{return}', UNE_RK_VOID,
          'Void', [ATTR_NO_IMPLICIT_RETURN]),
-    Case('int=()->{return}', UNE_RK_ERROR, UNE_EK_SYNTAX, []),
+    Case('int=()->return 46;return int()', UNE_RK_INT, '46', [ATTR_NO_IMPLICIT_RETURN]),
 
     # CALL
     Case('fn=arg->{a=[0];a[0]=1;for i from 0 till 2{if i==0 continue;break};return [arg*1*1.1, "str"]};return fn(2)',
@@ -612,6 +660,242 @@ cases = [
          UNE_RK_ERROR, UNE_EK_TYPE, []),
     Case('1()', UNE_RK_ERROR, UNE_EK_TYPE, []),
 
+    # FRAME SLOTS
+    Case('g=1;f=()->{a=g;g=2;return [a,g]};return f()+[g]',
+         UNE_RK_LIST, '[1, 2, 1]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=()->{eval("a=1");a+=1;return a};return f()',
+         UNE_RK_INT, '2', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=(a,a)->return a;return f(1,2)',
+         UNE_RK_INT, '1', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=()->{a};f()', UNE_RK_ERROR, UNE_EK_SYMBOL_NOT_DEFINED, []),
+
+    # SHARED CALLABLES
+    Case('l=[];for i from 0 till 3{l+=[(x)->x*2]};return l[0]==l[2]',
+         UNE_RK_INT, '1', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('l=[];for i from 0 till 3{l+=[(x)->x*i]};return l[1](5)',
+         UNE_RK_INT, '10', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=()->return (x)->x+1;return f()==f()',
+         UNE_RK_INT, '1', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('return ((x)->x)==((x)->x)',
+         UNE_RK_INT, '0', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('g=()->return 1;s=0;for i from 0 till 40{eval("f=(x)->x+g()");s+=f(i)};return s',
+         UNE_RK_INT, '820', [ATTR_NO_IMPLICIT_RETURN]),
+
+    # COPY-ON-WRITE
+    Case('a=[1,2];b=a;b[0]=9;return [a,b]',
+         UNE_RK_LIST, '[[1, 2], [9, 2]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a=[[1]];b=a;b[0][0]=2;return [a,b]',
+         UNE_RK_LIST, '[[[1]], [[2]]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a=[1,2,3];b=a;b[0..2]=[7,8];return [a,b]',
+         UNE_RK_LIST, '[[1, 2, 3], [7, 8, 3]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a=[1];b=a;b[0]+=5;return [a,b]',
+         UNE_RK_LIST, '[[1], [6]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a="abc";b=a;b[1]="x";return a+b', UNE_RK_STR, 'abcaxc', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a={x:1};b=a;b.x=2;return [a.x,b.x]',
+         UNE_RK_LIST, '[1, 2]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=l->{l[0]=5;return l};a=[1,2];return [f(a),a]',
+         UNE_RK_LIST, '[[5, 2], [1, 2]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a=[3,1,2];b=sort(a,(x,y)->x-y);return [a,b]',
+         UNE_RK_LIST, '[[3, 1, 2], [1, 2, 3]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('o={a:0,m:v->{this.a=v;return this}};p=o;p.m(1).m(2);return [o.a,p.a]',
+         UNE_RK_LIST, '[0, 2]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('c=[{o:{a:0,s:n->this.a=n}}];d=c;d[0].o.s(46);return [c[0].o.a,d[0].o.a]',
+         UNE_RK_LIST, '[0, 46]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=l->return l[0];o={a:1};return f([o]).a', UNE_RK_INT, '1', [ATTR_NO_IMPLICIT_RETURN]),
+
+    # QUICKENING
+    Case('f=(a,b)->return a+b;return [f(1,2),f(1,2),f(1.5,2),f("a","b"),f([1],[2])]',
+         UNE_RK_LIST, '[3, 3, 3.5, "ab", [1, 2]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=(a,b)->return a*b+a;return [f(2.5,2.0),f(2.5,2.0),f(3,4),f("a",3)]',
+         UNE_RK_LIST, '[7.5, 7.5, 15, "aaaa"]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=(a,b)->return [a<b,a>=b,a==b];return [f(1,2),f(1,2),f(2.5,1.5),f(2,2.0)]',
+         UNE_RK_LIST, '[[1, 0, 0], [1, 0, 0], [0, 1, 0], [0, 1, 1]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=(a,b)->return [a==b,a!=b];return [f("x","x"),f("x","y"),f("x",1),f(1,1)]',
+         UNE_RK_LIST, '[[1, 0], [0, 1], [0, 1], [1, 0]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=(a,b)->return a-b;f(2,1);f(2,1);f("a",1)', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('l=[0.5,1];n=0;for i from 0 till 20{n=n+l[i%2]};return n',
+         UNE_RK_FLT, '15.0', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('s=[];for v in [1,2,3,"a","b",4]{push(s,v+v)};return s',
+         UNE_RK_LIST, '[2, 4, 6, "aa", "bb", 8]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('r=[];for i from 0 till 12{v=[i,str(i)][i%2];push(r,v+v)};return r',
+         UNE_RK_LIST, '[0, "11", 4, "33", 8, "55", 12, "77", 16, "99", 20, "1111"]',
+         [ATTR_NO_IMPLICIT_RETURN]),
+    Case('x=0;for i from 0 till 10{if i==5{x+=0.5}else{x+=i}};return x',
+         UNE_RK_FLT, '40.5', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('n=0;for i from 0 till 20{if [i,1.5*i][i%2]<10{n+=1}};return n',
+         UNE_RK_INT, '8', [ATTR_NO_IMPLICIT_RETURN]),
+
+    # OPTIMIZER
+    Case('return 1024*1024-2**3', UNE_RK_INT, '1048568', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('return "a"+"b"+"{1+2}c"', UNE_RK_STR, 'ab3c', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('return [1<2.5,"a"=="b",-(1.5),!0,7//2,0?1:2]',
+         UNE_RK_LIST, '[1, 0, -1.5, 1, 3, 2]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('x=0;if 0{x=1}elif 1{x=2}else{x=3};while 0{x=4};return x',
+         UNE_RK_INT, '2', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=()->{return 1;return y};return f()', UNE_RK_INT, '1', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('return 2/(1-1)', UNE_RK_ERROR, UNE_EK_ZERO_DIVISION, []),
+    Case('return 2-"a"', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('f=()->return [(-9223372036854775807-1)/-1,(-9223372036854775807-1)//-1,(-9223372036854775807-1)%-1];return 46',
+         UNE_RK_INT, '46', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=()->return [9223372036854775807+1,-9223372036854775807-2,4611686018427387904*2,3**40,-(-9223372036854775807-1)];return 46',
+         UNE_RK_INT, '46', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('return [-9223372036854775807-1,2**62,(-2)**63+1,9223372036854775806+1]', UNE_RK_LIST,
+         '[-9223372036854775808, 4611686018427387904, -9223372036854775807, 9223372036854775807]',
+         [ATTR_NO_IMPLICIT_RETURN]),
+
+    # CONTEXTS
+    Case('f=(n)->return n<1?0:1+f(n-1);return f(500)', UNE_RK_INT, '500', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=(a,b,c,d,e,f,g,h,i,j)->{k=a+j;l=k*2;return [l,b,i]};return f(1,2,3,4,5,6,7,8,9,10)',
+         UNE_RK_LIST, '[22, 2, 9]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=(n)->{a=[n];return n<1?a:f(n-1)+a};return f(3)',
+         UNE_RK_LIST, '[0, 1, 2, 3]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=(n)->return n<1?1/0:f(n-1);return f(20) cover 7', UNE_RK_INT, '7', [ATTR_NO_IMPLICIT_RETURN]),
+
+    # RECURSION
+    Case('f=(n,a)->return n<1?a:f(n-1,a+1);return f(10000,0)',
+         UNE_RK_INT, '10000', [ATTR_NO_IMPLICIT_RETURN, ATTR_BYTECODE_ONLY]),
+    Case('e=(n)->return n==0?1:o(n-1);o=(n)->return n==0?0:e(n-1);return e(1001)',
+         UNE_RK_INT, '0', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('c=(n)->return (n<1?1/0:c(n-1)) cover 42;return c(10)',
+         UNE_RK_INT, '42', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('o={n:0,f:()->{this.n+=1;return this.n<5?this.f():this.n}};return o.f()',
+         UNE_RK_INT, '5', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('o=()->{z=42;return i()};i=()->return z;return o()',
+         UNE_RK_INT, '42', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a=(n)->{if n==3{y=7};z=n;return n<1?b():a(n-1)};b=()->return [y,z];return a(3)',
+         UNE_RK_LIST, '[7, 0]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('-r 100 -s "f=(n)->return n<1?n:f(n-1);return f(1000)"',
+         UNE_RK_INT, '0', [ATTR_DIRECT_ARG]),
+    Case('-r 100 -s "f=()->return 1+f();return f()"',
+         UNE_RK_ERROR, UNE_EK_RECURSION, [ATTR_DIRECT_ARG]),
+    Case('-t -s "f=()->return 1+f();return f()"',
+         UNE_RK_ERROR, UNE_EK_RECURSION, [ATTR_DIRECT_ARG]),
+    Case('-t -s "f=(n)->return n<1?0:1+f(n-1);return f(100)"',
+         UNE_RK_INT, '100', [ATTR_DIRECT_ARG]),
+    Case('-s "l=[3,1,2];c=(a,b)->return len(sort([a,b],c));return sort(l,c)"',
+         UNE_RK_ERROR, UNE_EK_RECURSION, [ATTR_DIRECT_ARG]),
+    Case('-r 0 -s "return 1"', UNE_RK_ERROR, UNE_ERROR_INPUT, [ATTR_DIRECT_ARG]),
+
+    # NATIVE NAMES
+    Case('o={count:1,max:3,get:()->return this.max};count=0;count+=o.count;return [count,o.get()]',
+         UNE_RK_LIST, '[1, 3]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=(list)->return list[0];for sum in [4]{};return [f([7]),sum,count("aa","a"),len]',
+         UNE_RK_LIST, '[7, 4, 2, <native>]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=()->return push;push=(l,x)->return [x];l=[1];return [f()(l,2),l]',
+         UNE_RK_LIST, '[[2], [1]]', [ATTR_NO_IMPLICIT_RETURN]),
+
+    # HOLDING
+    Case('r=0;for i from 0 till 3{r+={v:i,g:()->return this.v}.g()};return r',
+         UNE_RK_INT, '3', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=(o)->{if 1{return {w:o}.w.v}};return {v:{v:4}}.v.v+f({v:5})',
+         UNE_RK_INT, '9', [ATTR_NO_IMPLICIT_RETURN]),
+
+    # STRING LENGTHS
+    Case('return len(str(-120))+len(chr(0))', UNE_RK_INT, '5', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('return replace("bc", "x", "abcab")', UNE_RK_STR, 'axab', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('return join(["a", "", "bc"], "--")', UNE_RK_STR, 'a----bc', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('s="abc";t=s;s[1]="x";return [s=="axc",t=="abc",s==t,"ab"<"abc"]',
+         UNE_RK_LIST, '[1, 1, 0, 1]', [ATTR_NO_IMPLICIT_RETURN]),
+
+    # STRING STORAGE
+    Case('s="abc";t=s;s[1]=chr(8364);return [ord(s[1]),t,len(s+t),ord((t+s)[4])]',
+         UNE_RK_LIST, '[8364, "abc", 6, 8364]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('s=chr(300)+"ab";s[0]="x";return [s=="xab",s[1..3]=="ab"]',
+         UNE_RK_LIST, '[1, 1]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('e=chr(8364);return [split("a"+e+"b",[e]),join(["a",e],"-")[2]==e,replace(e,"x","a"+e)]',
+         UNE_RK_LIST, '[["a", "b"], 1, "ax"]', [ATTR_NO_IMPLICIT_RETURN]),
+
+    # STRING BUILDING
+    Case('s="";for i from 0 till 1000{s+="ab"};return [len(s),s[1999],s[0..4]]',
+         UNE_RK_LIST, '[2000, "b", "abab"]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('s="ab";s+="c";t=s+"x";u=s+"y";return [s,t,u]',
+         UNE_RK_LIST, '["abc", "abcx", "abcy"]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('s="ab";s+="c";t=s;s[0]="z";t+=chr(8364);return [s,t[0..3],ord(t[3])]',
+         UNE_RK_LIST, '["zbc", "abc", 8364]', [ATTR_NO_IMPLICIT_RETURN]),
+
+    # STRING SLICES
+    Case('s="hello world";a=s[0..5];s[0]="J";a[1]="a";return [s,a,s[6..11]]',
+         UNE_RK_LIST, '["Jello world", "hallo", "world"]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('p=split("a,bb,c",[","]);p[1][0]="Q";q=p[1];q+="x";return [p,q]',
+         UNE_RK_LIST, '[["a", "Qb", "c"], "Qbx"]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('s="abc";r=s[1..3];r+="d";s+="e";w="";for c in s{c+="-";w+=c};return [r,s,w]',
+         UNE_RK_LIST, '["bcd", "abce", "a-b-c-e-"]', [ATTR_NO_IMPLICIT_RETURN]),
+
+    # WIDE SLICES (UNE_DBG_SIZES refers to at most 64 elements)
+    Case('s="x"*65;l=[1]*66;return [s[0..65]==s,s[1..65]+"x"==s,l[0..65]==l[1..]]',
+         UNE_RK_LIST, '[1, 1, 1]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('s="x"*65;s[1..65]="y"*64;l=[0]*65;l[1..65]=[1]*64;return [s[0..2],l[0..2]]',
+         UNE_RK_LIST, '["xy", [0, 1]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('s="x"*65;s[0..65]="y"*65', UNE_RK_ERROR, UNE_EK_INDEX, []),
+    Case('l=[0]*65;l[0..65]=[1]*65', UNE_RK_ERROR, UNE_EK_INDEX, []),
+
+    # NUMBER FORMATTING
+    Case('return [str(0.1+0.2),str(-0.0),str(0.00000000005),str(2.5E-10),str(1E20)]',
+         UNE_RK_LIST, '["0.3", "-0.0", "0.0000000001", "0.0000000003", "100000000000000000000.0"]',
+         [ATTR_NO_IMPLICIT_RETURN]),
+    Case('return [str(-9223372036854775807-1),str(1E300)[0..17],len(str(1E300))]',
+         UNE_RK_LIST, '["-9223372036854775808", "10000000000000000", 303]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('return [flt("-1.5"),flt("-0.25E1"),flt("0.000123E3")==0.123,flt("9007199254740993.0")]',
+         UNE_RK_LIST, '[-1.5, -2.5, 1, 9007199254740992.0]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('return [flt("123456789012345678901234567890"),flt("9223372036854775808"),flt("-12"),flt("0x10")]',
+         UNE_RK_LIST, '[123456789012345677877719597056.0, 9223372036854775808.0, -12.0, 16.0]',
+         [ATTR_NO_IMPLICIT_RETURN]),
+
+    # LIST BUILDING
+    Case('l=[];m=[];for i from 0 till 1000{l+=[i];push(m,i)};return [len(l),l[999],l==m]',
+         UNE_RK_LIST, '[1000, 999, 1]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a=[1];b=a;a+=[2];c=a+[3];a+=a;return [a,b,c]',
+         UNE_RK_LIST, '[[1, 2, 1, 2], [1], [1, 2, 3]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('l=[[1],{x:[2]}];push(l[0],3);push(l[1].x,4);l[1].x+=[5];return l',
+         UNE_RK_LIST, '[[1, 3], {x: [2, 4, 5]}]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('l=[1];f=()->push(l,2);f();return l', UNE_RK_LIST, '[1, 2]', [ATTR_NO_IMPLICIT_RETURN]),
+
+    # ARRAYS
+    Case('a=array([1,2,3]);b=array([0.5,2,4]);return [a+b,a*2,1-a,a/2,-b]', UNE_RK_LIST,
+         '[array([1.5, 4.0, 7.0]), array([2, 4, 6]), array([0, -1, -2]), array([0.5, 1.0, 1.5]), array([-0.5, -2.0, -4.0])]',
+         [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a=array([1,2,3]);b=a;a[0]=9;b+=1;s=0;for x in a{s+=x};return [a,b,a[-1],a[1..],len(a),s]',
+         UNE_RK_LIST, '[array([9, 2, 3]), array([2, 3, 4]), 3, array([2, 3]), 3, 14]',
+         [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a=array([1,2]);f=array([1.0,2]);e=a==f;f[0]=3;return [e,a==[1,2],any a==2,f,list(f)]',
+         UNE_RK_LIST, '[1, 0, 1, array([3.0, 2.0]), [3.0, 2.0]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a=array([1]);b=a;for i from 0 till 2{a=a+a};b=1;return a',
+         UNE_RK_ARRAY, 'array([4])', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a=array([1]);a[0]=1.5', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('a=array([1,2]);a[0..1]=array([3])', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('array([1])+array([1,2])', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('array([1])*"a"', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('array([4.0])/0.0', UNE_RK_ERROR, UNE_EK_ZERO_DIVISION, []),
+    Case('array([4])/0', UNE_RK_ERROR, UNE_EK_ZERO_DIVISION, []),
+    Case('array([1,0])/array([1,0])', UNE_RK_ERROR, UNE_EK_ZERO_DIVISION, []),
+    Case('4/array([2,0.0])', UNE_RK_ERROR, UNE_EK_ZERO_DIVISION, []),
+
+    # MAPS
+    Case('m=map([]);for w in split("a b a c b a",[" "]){m[w]=(m[w]??0)+1};return [m,len(m),m["x"]]',
+         UNE_RK_LIST, '[map([["a", 3], ["b", 2], ["c", 1]]), 3, Void]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('m=map([[1,"a"],[2.5,"b"]]);n=m;m[1.0]="c";m["k"]=[1];m["k"][0]=2;return [m,n]',
+         UNE_RK_LIST, '[map([[1, "c"], [2.5, "b"], ["k", [2]]]), map([[1, "a"], [2.5, "b"]])]',
+         [ATTR_NO_IMPLICIT_RETURN]),
+    Case('m=map([]);for i from 0 till 1000{m[i]=i*i};s=0;for k in m{s+=m[k]};return [len(m),s,m[999]]',
+         UNE_RK_LIST, '[1000, 332833500, 998001]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a=map([[1,2],[3,4]]);b=map([[3,4],[1,2]]);m=a;m=map([]);return [a==b,a==[1,3],any a==3,!m]',
+         UNE_RK_LIST, '[1, 0, 1, 1]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('m=map([]);m[[1]]=1', UNE_RK_ERROR, UNE_EK_INDEX, []),
+    Case('map([])[0..1]', UNE_RK_ERROR, UNE_EK_TYPE, []),
+
+    # RANGES
+    Case('s=0;for i in range(0,10,3){s+=i};t=[];for i in range(3,-3,-2){push(t,i)};return [s,t]',
+         UNE_RK_LIST, '[18, [3, 1, -1]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('n=0;for i in range(0,9223372036854775807,1){if i==100000{break};n+=1};return n',
+         UNE_RK_INT, '100000', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('r=range(1,5,1);return [len(r),r,any r==4,all r<5,!range(1,1,1),r==range(1,5,1)]',
+         UNE_RK_LIST, '[4, range(1, 5, 1), 1, 1, 1, 1]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('f=r->{for i in r{if i>1{return i}}};return f(range(0,5,1))',
+         UNE_RK_INT, '2', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('for i in range(0,1,1){i[0]}', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('range(0,1,1)[0]', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('map([[1,2],[3]])', UNE_RK_ERROR, UNE_EK_TYPE, []),
+
     # TYPES
     Case('print(int)', UNE_RK_VOID, 'Void', []),
     Case('if int{return 1}else{return 0}',
@@ -692,6 +976,104 @@ cases = [
     Case('sort([2,1,3],(a,b)->return 1/0)',
          UNE_RK_ERROR, UNE_EK_ZERO_DIVISION, []),
     Case('sort([2,1,3],(a,b)->return 1.0)', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('sort([3,1,2,1.5],Void)', UNE_RK_LIST, '[1, 1.5, 2, 3]', []),
+    Case('sort([[2,"a"],[1,"b"],[2,"c"],[1,"d"]],p->return p[0])',
+         UNE_RK_LIST, '[[1, "b"], [1, "d"], [2, "a"], [2, "c"]]', []),
+    Case('l=[];for i from 0 till 100{push(l,[(i*37)%10,i])};s=sort(l,(a,b)->return a[0]-b[0]);'
+         'return [s[0],s[9],s[10],s[99]]', UNE_RK_LIST, '[[0, 0], [0, 90], [1, 3], [9, 97]]',
+         [ATTR_NO_IMPLICIT_RETURN]),
+    Case('sort([[2],[1]],(a,b)->return sort(a,Void)[0]-b[0])', UNE_RK_LIST, '[[1], [2]]', []),
+    Case('sort([1,"a"],Void)', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('sort([1,2],x->return 1/0)', UNE_RK_ERROR, UNE_EK_ZERO_DIVISION, []),
+    Case('sort([1,2],1)', UNE_RK_ERROR, UNE_EK_TYPE, []),
+
+    # push
+    Case('a=[1];b=a;push(a,2);return [a,b]', UNE_RK_LIST, '[[1, 2], [1]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('push([1],2)', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('a="1";push(a,2)', UNE_RK_ERROR, UNE_EK_TYPE, []),
+
+    # pop
+    Case('a=[1,2];return [pop(a),a]', UNE_RK_LIST, '[2, [1]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a=[];pop(a)', UNE_RK_ERROR, UNE_EK_INDEX, []),
+
+    # insert
+    Case('a=[2];insert(a,0,1);insert(a,-1,4);insert(a,2,3);return a',
+         UNE_RK_LIST, '[1, 2, 3, 4]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a=[1];insert(a,2,0)', UNE_RK_ERROR, UNE_EK_INDEX, []),
+    Case('a=[1];insert(a,"0",0)', UNE_RK_ERROR, UNE_EK_TYPE, []),
+
+    # remove
+    Case('a=[1,2,3];return [remove(a,1),remove(a,-1),a]',
+         UNE_RK_LIST, '[2, 3, [1]]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('a=[1];remove(a,1)', UNE_RK_ERROR, UNE_EK_INDEX, []),
+
+    # array
+    Case('array([1,2.5])', UNE_RK_ARRAY, 'array([1.0, 2.5])', []),
+    Case('array([1,"2"])', UNE_RK_ERROR, UNE_EK_TYPE, []),
+
+    # list
+    Case('list(array([1,2]))', UNE_RK_LIST, '[1, 2]', []),
+    Case('list([1])', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('list(range(4,0,-2))', UNE_RK_LIST, '[4, 2]', []),
+
+    # sum
+    Case('[sum(array([1,2,3])),sum(array([0.5,1])),sum(array([]))]',
+         UNE_RK_LIST, '[6, 1.5, 0]', []),
+    Case('sum([1])', UNE_RK_ERROR, UNE_EK_TYPE, []),
+
+    # min
+    Case('[min(array([3,-1,2])),min(array([2.5,1]))]', UNE_RK_LIST, '[-1, 1.0]', []),
+    Case('min(array([]))', UNE_RK_ERROR, UNE_EK_INDEX, []),
+
+    # max
+    Case('[max(array([3,-1,2])),max(array([2.5,1]))]', UNE_RK_LIST, '[3, 2.5]', []),
+    Case('max(array([]))', UNE_RK_ERROR, UNE_EK_INDEX, []),
+
+    # dot
+    Case('[dot(array([1,2]),array([3,4])),dot(array([1,2]),array([0.5,1]))]',
+         UNE_RK_LIST, '[11, 2.5]', []),
+    Case('dot(array([1]),array([1,2]))', UNE_RK_ERROR, UNE_EK_TYPE, []),
+
+    # map
+    Case('map([[1,2],[1,3]])', UNE_RK_MAP, 'map([[1, 3]])', []),
+    Case('map([[1.5,1],[0/1.0,2]])', UNE_RK_MAP, 'map([[1.5, 1], [0.0, 2]])', []),
+
+    # get
+    Case('m=map([["a",1]]);return [get(m,"a"),get(m,"b")]', UNE_RK_LIST, '[1, Void]',
+         [ATTR_NO_IMPLICIT_RETURN]),
+    Case('get([1],0)', UNE_RK_ERROR, UNE_EK_TYPE, []),
+
+    # set
+    Case('m=map([]);n=m;set(m,"a",1);set(m,"a",2);return [m,n]',
+         UNE_RK_LIST, '[map([["a", 2]]), map([])]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('set(map([]),1,1)', UNE_RK_ERROR, UNE_EK_TYPE, []),
+
+    # has
+    Case('m=map([[1,Void]]);return [has(m,1),has(m,1.0),has(m,"1")]', UNE_RK_LIST, '[1, 1, 0]',
+         [ATTR_NO_IMPLICIT_RETURN]),
+
+    # delete
+    Case('m=map([[1,"a"],[2,"b"],[3,"c"]]);return [delete(m,1),m,m[3],len(m)]',
+         UNE_RK_LIST, '["a", map([[3, "c"], [2, "b"]]), "c", 2]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('m=map([]);for i from 0 till 200{m[i]=i};for i from 0 till 200{if i%2==0{delete(m,i)}};'
+         's=0;for i from 0 till 200{if has(m,i){s+=1}};return [len(m),s,m[199]]',
+         UNE_RK_LIST, '[100, 100, 199]', [ATTR_NO_IMPLICIT_RETURN]),
+    Case('m=map([]);delete(m,1)', UNE_RK_ERROR, UNE_EK_INDEX, []),
+
+    # keys
+    Case('keys(map([["b",1],["a",2]]))', UNE_RK_LIST, '["b", "a"]', []),
+
+    # values
+    Case('values(map([["b",1],["a",2]]))', UNE_RK_LIST, '[1, 2]', []),
+
+    # range
+    Case('[list(range(9223372036854775800,9223372036854775807,5)),list(range(-1,-9223372036854775807-1,-9223372036854775807))]',
+         UNE_RK_LIST, '[[9223372036854775800, 9223372036854775805], [-1]]', []),
+    Case('range(0,1,0)', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('len(range(0,9223372036854775807,1))', UNE_RK_INT, '9223372036854775807', []),
+    Case('range(-1,9223372036854775807,1)', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('range(9223372036854775807,-9223372036854775807-1,-1)', UNE_RK_ERROR, UNE_EK_TYPE, []),
+    Case('range(0,1.0,1)', UNE_RK_ERROR, UNE_EK_TYPE, []),
 
     # getwd
     Case('split(getwd(),["/","\\\\"])[-1..]',
@@ -813,37 +1195,42 @@ for i, case in enumerate(cases):
         if not check_report('main', case, i):
             passed = False
     else:
-        if not ATTR_FILE_ONLY in case.attributes:
-            sanitized = case.input
-            if not ATTR_NO_SECOND_ESCAPE in case.attributes:
-                sanitized = sanitized.replace('\\', '\\\\')
-            sanitized = sanitized.replace('"', '\\"')
-            sanitized = sanitized.replace('\n', '\\n')
-            if case.result_kind != UNE_RK_ERROR and not ATTR_NO_IMPLICIT_RETURN in case.attributes:
-                sanitized = f'return {sanitized}'
-            command = f'{une} -s "{sanitized}"'
-            if ATTR_STDIN in case.attributes:
-                command = 'echo test|' + command
-            os.system(command)
-            if not check_report('cmdl', case, i):
-                passed = False
-                print(f'\33[31m{command}\33[0m')
-        if passed or not STOP_AT_FAIL:
-            if SHOW_ERRORS and case.result_kind == UNE_RK_ERROR:
-                une = une_with_output
-            script = case.input
-            if case.result_kind != UNE_RK_ERROR and not ATTR_NO_IMPLICIT_RETURN in case.attributes:
-                script = f'return {script}'
-            status = open(FILE_SCRIPT, 'w')
-            status.write(script)
-            status.close()
-            command = f'{une} "{FILE_SCRIPT}"'
-            if ATTR_STDIN in case.attributes:
-                command = 'echo test|' + command
-            os.system(command)
-            if not check_report('file', case, i):
-                passed = False
-                print(f'\33[31m{script}\33[0m')
+        for mode in MODES:
+            if not passed and STOP_AT_FAIL:
+                break
+            if mode == '-t ' and ATTR_BYTECODE_ONLY in case.attributes:
+                continue
+            if not ATTR_FILE_ONLY in case.attributes:
+                sanitized = case.input
+                if not ATTR_NO_SECOND_ESCAPE in case.attributes:
+                    sanitized = sanitized.replace('\\', '\\\\')
+                sanitized = sanitized.replace('"', '\\"')
+                sanitized = sanitized.replace('\n', '\\n')
+                if case.result_kind != UNE_RK_ERROR and not ATTR_NO_IMPLICIT_RETURN in case.attributes:
+                    sanitized = f'return {sanitized}'
+                command = f'{une} {mode}-s "{sanitized}"'
+                if ATTR_STDIN in case.attributes:
+                    command = 'echo test|' + command
+                os.system(command)
+                if not check_report(f'cmdl{mode.strip()}', case, i):
+                    passed = False
+                    print(f'\33[31m{command}\33[0m')
+            if passed or not STOP_AT_FAIL:
+                if SHOW_ERRORS and case.result_kind == UNE_RK_ERROR:
+                    une = une_with_output
+                script = case.input
+                if case.result_kind != UNE_RK_ERROR and not ATTR_NO_IMPLICIT_RETURN in case.attributes:
+                    script = f'return {script}'
+                status = open(FILE_SCRIPT, 'w')
+                status.write(script)
+                status.close()
+                command = f'{une} {mode}"{FILE_SCRIPT}"'
+                if ATTR_STDIN in case.attributes:
+                    command = 'echo test|' + command
+                os.system(command)
+                if not check_report(f'file{mode.strip()}', case, i):
+                    passed = False
+                    print(f'\33[31m{mode}{script}\33[0m')
     if passed:
         print(f'\33[0m[{i}/{CASES_LEN}] \33[32mPassed\33[0m')
     elif STOP_AT_FAIL: